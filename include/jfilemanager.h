@@ -2,6 +2,7 @@
 #define __JFILEMANAGER_H__
 
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <string.h>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,20 +17,168 @@
 #define LINE_LENGTH 1024
 #endif
 
+// 라인 위치 색인을 기록하는 라인 간격
+#ifndef LINE_INDEX_INTERVAL
+#define LINE_INDEX_INTERVAL 1024
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Definition
 ///////////////////////////////////////////////////////////////////////////////
 
 typedef struct stat FileStatus, *FileStatusPtr, **FileStatusPtrContainer;
 
+typedef enum _jfm_dedupe_policy_t
+{
+	// 리플링크(FICLONERANGE)로 데이터 블록 공유
+	JFMDedupeReflink = 1,
+	// 하드링크로 교체
+	JFMDedupeHardlink,
+	// 리플링크를 먼저 시도하고 실패하면 하드링크로 교체
+	JFMDedupeAuto
+} JFMDedupePolicy;
+
+typedef enum _jfm_copy_flag_t
+{
+	// 대상 파일이 이미 있으면 내용이 달라진 구간만 다시 쓰기
+	JFMCopyDelta = 0x01,
+	// 복사한 후 원본과 대상 파일의 페이지 캐시를 비우기(한 번만 쓰는 복사)
+	JFMCopyDropCache = 0x02,
+	// 페이지 캐시를 거치지 않고 복사하기(O_DIRECT, 큰 파일용)
+	JFMCopyDirect = 0x04,
+	// 체크포인트를 남기면서 복사하고, 중단된 복사가 있으면 이어서 복사하기
+	JFMCopyResume = 0x08
+} JFMCopyFlag;
+
+typedef enum _jfm_access_policy_t
+{
+	// 커널 기본 동작
+	JFMAccessDefault = 0,
+	// 처음부터 순서대로 읽음(미리 읽기 크기 확대)
+	JFMAccessSequential,
+	// 임의 위치를 읽음(미리 읽기 사용 안 함)
+	JFMAccessRandom,
+	// 한 번만 순서대로 읽음(전체 읽기와 복사가 끝나면 페이지 캐시에서 제거)
+	JFMAccessOnce,
+	// 곧 읽을 예정(열 때 미리 읽기 요청)
+	JFMAccessWillNeed
+} JFMAccessPolicy;
+
+typedef enum _jfm_split_mode_t
+{
+	// 조각마다 라인 수가 같도록 나누기
+	JFMSplitByLine = 0,
+	// 조각마다 크기가 비슷하도록 라인 경계에서 나누기
+	JFMSplitBySize
+} JFMSplitMode;
+
+typedef enum _jfm_sort_flag_t
+{
+	// 같은 라인은 하나만 남기기
+	JFMSortUnique = 0x01,
+	// 라인 앞의 숫자 값 기준으로 정렬하기(숫자로 시작하지 않으면 0, 숫자 값이 같으면 라인 내용 순서)
+	JFMSortNumeric = 0x02
+} JFMSortFlag;
+
+typedef struct _jfm_copy_option_t
+{
+	// 복사 방식(JFMCopyFlag 값의 비트 조합)
+	int flags;
+	// 병렬 처리 단위 블록 크기(JFMCopyResume 에서는 체크포인트 간격, 0 이면 기본값 사용)
+	size_t blockSize;
+	// 작업 스레드 개수(0 이면 CPU 개수만큼 사용)
+	int threadNum;
+} JFMCopyOption, *JFMCopyOptionPtr;
+
+typedef struct _jfm_copy_result_t
+{
+	// 복사 결과(성공 시 0, 실패 시 errno 값)
+	int error;
+	// 복사한 바이트 수
+	long long size;
+	// 복사에 걸린 시간(밀리초)
+	long long elapsedTime;
+} JFMCopyResult, *JFMCopyResultPtr;
+
+typedef struct _jfm_copy_summary_t
+{
+	// 복사에 성공한 파일 개수, 실패한 파일 개수
+	int copiedNum;
+	int failedNum;
+	// 복사한 전체 바이트 수
+	long long totalSize;
+	// 전체 복사에 걸린 시간(밀리초)
+	long long elapsedTime;
+	// 초당 복사한 바이트 수
+	double throughput;
+} JFMCopySummary, *JFMCopySummaryPtr;
+
+typedef struct _jfm_sort_option_t
+{
+	// 정렬 방식(JFMSortFlag 값의 비트 조합)
+	int flags;
+	// 정렬에 사용할 메모리 크기(바이트, 0 이면 64 MB, 넘으면 임시 파일로 나눠서 정렬)
+	size_t memoryLimit;
+	// 작업 스레드 개수(0 이면 CPU 개수만큼 사용)
+	int threadNum;
+} JFMSortOption, *JFMSortOptionPtr;
+
+typedef enum _jfm_resize_flag_t
+{
+	// 늘어나는 구간의 블록을 fallocate 로 미리 할당
+	JFMResizePreallocate = 0x01,
+	// 파일 크기는 유지하고 블록 할당만 변경(늘리면 예약, 줄이면 구멍 뚫기)
+	JFMResizeKeepSize = 0x02
+} JFMResizeFlag;
+
+typedef enum _jfm_replace_flag_t
+{
+	// 교체하기 전에 새 내용과 디렉터리 항목을 디스크에 반영(fdatasync, fsync)
+	JFMReplaceSync = 0x01
+} JFMReplaceFlag;
+
+typedef struct _jfm_write_back_option_t
+{
+	// 파일 하나의 쓰기 대기 내용이 이 크기 이상이면 바로 저장(바이트, 0 이면 1 MB)
+	size_t maxFileDirtySize;
+	// 쓰기 대기 내용을 저장하지 않고 두는 최대 시간(밀리초, 0 이면 1000)
+	long long maxDirtyAge;
+	// 전체 쓰기 대기 내용이 이 크기 이상이면 모든 파일을 저장(바이트, 0 이면 64 MB)
+	size_t maxTotalDirtySize;
+} JFMWriteBackOption, *JFMWriteBackOptionPtr;
+
+typedef struct _jfm_lines_t
+{
+	// 라인 문자열 배열(각 라인은 개행 문자 포함)
+	char **lineList;
+	// 라인 개수
+	long long lineNum;
+	// 첫 라인의 라인 번호(0 부터 시작, 알 수 없으면 -1)
+	long long firstLine;
+} JFMLines, *JFMLinesPtr;
+
+typedef struct _jfile_line_mark_t
+{
+	// 라인 번호(0 부터 시작)
+	long long line;
+	// 라인이 시작하는 위치(압축 파일이면 압축 해제된 논리 위치)
+	long long offset;
+} JFileLineMark, *JFileLineMarkPtr;
+
+// 블록 압축 저장 정보(내부 구조체)
+struct _jfile_compress_t;
+
+// 묶음 파일 정보(내부 구조체)
+struct _jfile_pack_t;
+
 typedef struct _jfile_t
 {
 	// 중복 횟수(복사 시 중복된 이름인 경우 카운트)
 	int dupleNum;
 	// 전체 라인 수
-	int line;
+	long long line;
 	// 전체 문자 개수
-	int totalCharCount;
+	long long totalCharCount;
 	// 파일 포인터
 	FILE *filePointer;
 	// 이름
@@ -42,8 +191,33 @@ typedef struct _jfile_t
 	char **dataList;
 	// 파일 상태 및 정보
 	FileStatus stat;
+	// 라인 위치 색인(LINE_INDEX_INTERVAL 라인마다 하나씩, 라인 번호 순서로 저장)
+	JFileLineMarkPtr lineIndex;
+	// 라인 위치 색인 개수
+	long long lineIndexSize;
+	// 블록 압축 저장 정보(압축 파일이 아니면 NULL)
+	struct _jfile_compress_t *compress;
+	// 파일 내용이 저장된 묶음 파일(묶음 파일의 항목이 아니면 NULL, 읽기 전용)
+	struct _jfile_pack_t *pack;
+	// 묶음 파일 안에서의 항목 번호
+	long long packIndex;
+	// 따라 읽기(JFMFollow)로 다음에 전달할 라인의 시작 위치(시작 전이면 -1)
+	long long followOffset;
+	// 따라 읽기로 다음에 전달할 라인의 번호
+	long long followLine;
+	// 파일 접근 방식 힌트(posix_fadvise)
+	JFMAccessPolicy accessPolicy;
 } JFile, *JFilePtr, **JFilePtrContainer;
 
+// 쓰기 지연(write-back) 정보(내부 구조체)
+struct _jfm_write_back_t;
+
+// 내용 색인 정보(내부 구조체)
+struct _jfm_index_t;
+
+// 경로 색인(파일 경로의 압축 기수 트라이) 노드(내부 구조체)
+struct _jfm_path_node_t;
+
 typedef struct _jfilemanager_t
 {
 	// 파일 개수
@@ -52,8 +226,30 @@ typedef struct _jfilemanager_t
 	JFilePtrContainer fileContainer;
 	// 사용자 데이터
 	void *userData;
+	// 쓰기 지연 정보(사용하지 않으면 NULL)
+	struct _jfm_write_back_t *writeBack;
+	// 내용 색인 정보(사용하지 않으면 NULL)
+	struct _jfm_index_t *contentIndex;
+	// 경로 색인의 루트 노드(아직 만들지 않았으면 NULL)
+	struct _jfm_path_node_t *pathIndex;
+	// 새로 추가하는 파일에 적용할 접근 방식
+	JFMAccessPolicy accessPolicy;
 } JFM, *JFMPtr, **JFMPtrContainer;
 
+// 따라 읽기 콜백 함수(파일 관리 구조체, 파일 인덱스, 새 라인(개행 문자 포함, 대기 시간 초과 시 NULL), 라인 번호)
+// 0 이 아닌 값을 반환하면 따라 읽기를 멈춘다.
+typedef int (*JFMFollowFunc)(JFMPtr fm, int index, const char *line, long long lineNumber);
+
+// 내용 검색 콜백 함수(파일 관리 구조체, 파일 인덱스, 찾은 라인(개행 문자 포함), 라인 번호)
+// 0 이 아닌 값을 반환하면 검색을 멈춘다.
+typedef int (*JFMQueryFunc)(JFMPtr fm, int index, const char *line, long long lineNumber);
+
+// 라인 편집 정보(내부 구조체)
+typedef struct _jfm_edit_t JFMEdit, *JFMEditPtr, **JFMEditPtrContainer;
+
+// 경로 검색 결과 반복자(내부 구조체)
+typedef struct _jfm_path_iter_t JFMPathIter, *JFMPathIterPtr, **JFMPathIterPtrContainer;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Functions for JFileManager
 ///////////////////////////////////////////////////////////////////////////////
@@ -74,22 +270,70 @@ JFMPtr JFMNewFile(JFMPtr fm, const char *path);
 JFMPtr JFMDeleteFile(JFMPtr fm, int index);
 void JFMDeleteAllFiles(JFMPtr fm);
 
+// 쓰기 지연(write-back) 사용, 해제 및 쓰기 대기 내용 저장하기
+JFMPtr JFMEnableWriteBack(JFMPtr fm, const JFMWriteBackOptionPtr option);
+JFMPtr JFMDisableWriteBack(JFMPtr fm);
+JFMPtr JFMFlush(JFMPtr fm, int index);
+JFMPtr JFMFlushAll(JFMPtr fm);
+
+// 파일 접근 방식 힌트 설정, 미리 읽기(페이지 캐시 관리)
+JFMPtr JFMSetAccessPolicy(JFMPtr fm, JFMAccessPolicy policy);
+JFMPtr JFMSetFileAccessPolicy(JFMPtr fm, int index, JFMAccessPolicy policy);
+JFMPtr JFMPrefetch(JFMPtr fm, const int indices[], int n);
+
 // 파일 쓰기, 읽기(출력하기)
 JFMPtr JFMWriteFile(JFMPtr fm, int index, const char *s, const char *mode);
+JFMPtr JFMWriteFileV(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, const char *mode);
+ssize_t JFMPWrite(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, off_t offset);
+JFMPtr JFMReplaceFile(JFMPtr fm, int index, const void *data, size_t length, int flags);
 char** JFMReadFile(JFMPtr fm, int index);
+char* JFMReadLine(JFMPtr fm, int index, long long lineNumber);
+JFMPtr JFMReadTail(JFMPtr fm, int index, long long n, JFMLinesPtr out);
+ssize_t JFMReadRange(JFMPtr fm, int index, off_t offset, size_t length, void *buf);
+long long JFMReadInto(JFMPtr fm, int index, off_t offset, char *buf, size_t bufSize, size_t lineOffsets[], long long maxLines);
+void JFMFreeLines(JFMLinesPtr lines);
+
+// 파일에 새로 추가되는 라인 따라 읽기(tail -F)
+JFMPtr JFMFollow(JFMPtr fm, int index, JFMFollowFunc callback);
 
 // 파일 검색하기
 JFilePtr JFMFindFileByPath(const JFMPtr fm, const char *path);
 
+// 경로 접두사, 글롭 패턴으로 파일 찾기(경로 색인 사용), 접두사 아래 파일 모두 삭제, 이동하기
+JFMPathIterPtr JFMFindByPrefix(JFMPtr fm, const char *prefix);
+JFMPathIterPtr JFMFindByGlob(JFMPtr fm, const char *pattern);
+int JFMPathIterNext(JFMPathIterPtr iter);
+long long JFMPathIterGetCount(const JFMPathIterPtr iter);
+void JFMPathIterClose(JFMPathIterPtrContainer iterContainer);
+long long JFMDeleteByPrefix(JFMPtr fm, const char *prefix);
+long long JFMMoveByPrefix(JFMPtr fm, const char *prefix, const char *newPrefix);
+
+// 파일 내용 검색하기(트라이그램 내용 색인 사용, 해제, 저장, 불러오기)
+long long JFMQuery(JFMPtr fm, int index, const char *s, JFMQueryFunc callback);
+JFMPtr JFMEnableIndex(JFMPtr fm);
+JFMPtr JFMDisableIndex(JFMPtr fm);
+JFMPtr JFMSaveIndex(JFMPtr fm, const char *indexPath);
+JFMPtr JFMLoadIndex(JFMPtr fm, const char *indexPath);
+
 // 파일 이름 변경
 JFMPtr JFMRenameFilePath(JFMPtr fm, int index, const char *newFilePath);
 
 // 파일 복사하기, 잘라내기(이동하기)
 JFMPtr JFMCopyFile(JFMPtr fm, int index, const char *newFilePath);
+JFMPtr JFMCopyFileEx(JFMPtr fm, int index, const char *newFilePath, const JFMCopyOptionPtr option);
+JFMPtr JFMCopyFiles(JFMPtr fm, const int indices[], const char *destPaths[], int n, const JFMCopyOptionPtr option, JFMCopyResult results[], JFMCopySummaryPtr summary);
+JFMPtr JFMCopyFileMulti(JFMPtr fm, int index, const char *destPaths[], int n);
+JFMPtr JFMConcatFiles(JFMPtr fm, const int indices[], int n, const char *destPath);
+JFMPtr JFMSplitFile(JFMPtr fm, int index, JFMSplitMode mode, int n, const char *pattern);
 JFMPtr JFMMoveFile(JFMPtr fm, int index, const char *destPath);
 
+// 파일 라인 정렬하기(메모리보다 큰 파일은 외부 병합 정렬)
+JFMPtr JFMSortFile(JFMPtr fm, int index, const char *destPath, const JFMSortOptionPtr option);
+
 // 파일 크기 변경
 JFMPtr JFMTruncateFile(JFMPtr fm, int index, off_t length);
+JFMPtr JFMResizeFile(JFMPtr fm, int index, off_t length, int flags);
+JFMPtr JFMPunchHole(JFMPtr fm, int index, off_t offset, off_t length);
 
 // 파일 접근 권한 바꾸기
 JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode);
@@ -97,5 +341,30 @@ JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode);
 // 파일 상태 및 정보 출력
 void JFMPrintFile(const JFMPtr fm, int index);
 
+// 블록 압축 저장 방식으로 변환, 복원
+JFMPtr JFMCompressFile(JFMPtr fm, int index);
+JFMPtr JFMDecompressFile(JFMPtr fm, int index);
+
+// 관리 중인 파일 목록과 파일 정보를 저장, 불러오기(빠른 재시작)
+JFMPtr JFMSaveManifest(const JFMPtr fm, const char *manifestPath);
+JFMPtr JFMLoadManifest(JFMPtr fm, const char *manifestPath);
+
+// 여러 파일을 하나의 묶음 파일로 저장, 풀기, 풀지 않고 읽기 전용으로 불러오기
+JFMPtr JFMPack(JFMPtr fm, const int indices[], int n, const char *packPath);
+JFMPtr JFMUnpack(JFMPtr fm, const char *packPath, const char *destDir);
+JFMPtr JFMOpenPack(JFMPtr fm, const char *packPath);
+
+// 중복 파일 공간 회수(리플링크 또는 하드링크)
+JFMPtr JFMDedupe(JFMPtr fm, const int indices[], int n, JFMDedupePolicy policy);
+
+// 파일 전체를 다시 쓰지 않고 라인 단위로 편집하기(조각 테이블)
+JFMEditPtr JFMEditOpen(JFMPtr fm, int index);
+void JFMEditClose(JFMEditPtrContainer editContainer);
+long long JFMEditGetLineNum(const JFMEditPtr edit);
+JFMEditPtr JFMEditInsertLine(JFMEditPtr edit, long long lineNumber, const char *line);
+JFMEditPtr JFMEditReplaceLine(JFMEditPtr edit, long long lineNumber, const char *line);
+JFMEditPtr JFMEditDeleteLine(JFMEditPtr edit, long long lineNumber);
+JFMPtr JFMEditCommit(JFMEditPtr edit);
+
 #endif // #ifndef __JFILEMANAGER_H__
 
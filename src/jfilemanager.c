@@ -1,10 +1,19 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/types.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/inotify.h>
+#include <poll.h>
 #include <limits.h>
+#include <pthread.h>
+#include <linux/fs.h>
 #include "../include/jfilemanager.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,6 +22,120 @@
 
 #define MAX_MODE_NUM 9
 
+// 파일 내용 비교 시 사용하는 버퍼 크기
+#define COMPARE_BUF_SIZE (64 * 1024)
+
+// 파일 복사 시 사용하는 버퍼 크기
+#define COPY_BUF_SIZE (256 * 1024)
+
+// 이 크기 이상의 파일은 구간별로 나눠서 병렬로 복사한다.
+#define COPY_PARALLEL_MIN_SIZE (64LL * 1024 * 1024)
+
+// 병렬 복사 시 작업 하나가 담당하는 구간 크기
+#define COPY_CHUNK_SIZE (16LL * 1024 * 1024)
+
+// 차등 복사 시 병렬 작업 하나가 담당하는 블록 크기
+#define DELTA_BLOCK_SIZE (1024 * 1024)
+
+// 차등 복사 시 내용을 비교하는 최소 단위(이 단위로 달라진 구간만 다시 쓴다)
+#define DELTA_PAGE_SIZE 4096
+
+// 병렬 작업에 사용하는 최대 스레드 개수
+#define MAX_THREAD_NUM 64
+
+// O_DIRECT 복사 시 사용하는 버퍼 크기, 버퍼 개수, 위치와 길이를 맞추는 정렬 크기
+#define DIRECT_BUF_SIZE (4 * 1024 * 1024)
+#define DIRECT_BUF_NUM 4
+#define DIRECT_ALIGN 4096
+
+// 여러 대상 복사 시 한 번에 읽어서 모든 대상 파일에 쓰는 블록 크기
+#define MULTI_COPY_BUF_SIZE (4 * 1024 * 1024)
+
+// 이어서 복사 시 체크포인트를 남기는 기본 간격, 체크포인트 파일 이름 뒤에 붙이는 문자열, 형식 식별자
+#define RESUME_CHECKPOINT_SIZE (16 * 1024 * 1024)
+#define RESUME_SUFFIX ".jfmckpt"
+#define RESUME_MAGIC "JFMCKPT1"
+
+// 체크섬(64 비트 FNV-1a) 시작값
+#define CHECKSUM_SEED 14695981039346656037ULL
+
+// 정렬 시 기본 메모리 크기, 런(한 번에 정렬하는 구간) 최소 크기, 런 하나를 읽고 쓰는 버퍼 최소 크기
+#define SORT_MEMORY_SIZE (64 * 1024 * 1024)
+#define SORT_MIN_RUN_SIZE (64 * 1024)
+#define SORT_MIN_BUF_SIZE (64 * 1024)
+
+// 한 번에 병합하는 최대 런 개수(더 많으면 여러 단계로 나눠서 병합)
+#define SORT_MAX_MERGE_NUM 64
+
+// 내용 색인 파일 형식 식별자 및 버전
+#define INDEX_MAGIC "JFMIDX01"
+#define INDEX_VERSION 1
+
+// 내용 색인 블록 하나의 라인 수, 트라이그램 해시 테이블 처음 슬롯 개수(2 의 거듭제곱)
+#define INDEX_BLOCK_LINES LINE_INDEX_INTERVAL
+#define INDEX_TABLE_SIZE 1024
+
+// 파일 내용을 구간 단위로 읽을 때 사용하는 버퍼 크기
+#define READ_BUF_SIZE (256 * 1024)
+
+// 이 크기 이상의 파일은 라인 수를 구간별로 나눠서 병렬로 센다.
+#define COUNT_PARALLEL_MIN_SIZE (64LL * 1024 * 1024)
+
+// 라인 수를 병렬로 셀 때 작업 하나가 담당하는 구간 크기
+#define COUNT_CHUNK_SIZE (16LL * 1024 * 1024)
+
+// 따라 읽기 시 변경 알림을 기다리는 최대 시간(밀리초, 초과하면 콜백에 NULL 전달)
+#define FOLLOW_POLL_TIMEOUT 200
+
+// 쓰기 지연 기본값(파일 하나의 대기 크기, 대기 시간(밀리초), 전체 대기 크기)
+#define WRITE_BACK_FILE_SIZE (1024 * 1024)
+#define WRITE_BACK_AGE 1000
+#define WRITE_BACK_TOTAL_SIZE (64 * 1024 * 1024)
+
+// 블록 압축 파일 형식 식별자 및 버전
+#define COMPRESS_MAGIC "JFMZBLK1"
+#define COMPRESS_VERSION 1
+
+// 압축 블록 하나의 최대 논리 크기(라인 경계에서 자른다)
+#define COMPRESS_BLOCK_SIZE (64 * 1024)
+
+// 압축 블록 속성(압축하지 않고 그대로 저장, 블록이 라인 처음에서 시작)
+#define COMPRESS_BLOCK_RAW 0x01
+#define COMPRESS_BLOCK_LINE_START 0x02
+
+// LZ 압축 파라미터(LZ4 블록 형식과 같은 규칙 사용)
+#define LZ_HASH_LOG 14
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5
+#define LZ_MATCH_FIND_LIMIT 12
+#define LZ_MAX_OFFSET 65535
+
+// 묶음 파일 형식 식별자 및 버전
+#define PACK_MAGIC "JFMPACK1"
+#define PACK_VERSION 1
+
+// 묶음 파일 목차를 mmap 으로 바로 읽을 수 있도록 맞추는 정렬 크기
+#define PACK_ALIGN 8
+
+// 파일 목록 저장 파일 형식 식별자 및 버전
+#define MANIFEST_MAGIC "JFMMANI1"
+#define MANIFEST_VERSION 1
+
+// 파일 목록 항목 속성(블록 압축 파일)
+#define MANIFEST_ENTRY_COMPRESSED 0x01
+
+// 오래된 커널 헤더에는 FICLONERANGE 정의가 없으므로 직접 정의
+#ifndef FICLONERANGE
+struct file_clone_range
+{
+	long long src_fd;
+	unsigned long long src_offset;
+	unsigned long long src_length;
+	unsigned long long dest_offset;
+};
+#define FICLONERANGE _IOW(0x94, 13, struct file_clone_range)
+#endif
+
 typedef enum Category
 {
 	Owner,
@@ -45,18 +168,727 @@ typedef enum FileType
 	SymbolicLink
 } FileType;
 
+// 병렬 작업 함수(작업 인자, 작업 번호)
+typedef void (*TaskFunc)(void *arg, long long taskIndex);
+
+typedef struct _task_group_t
+{
+	// 각 작업을 처리할 함수
+	TaskFunc func;
+	// 작업 함수에 전달할 인자
+	void *arg;
+	// 전체 작업 개수
+	long long taskNum;
+	// 다음에 처리할 작업 번호(스레드 간 공유)
+	long long nextTask;
+} TaskGroup, *TaskGroupPtr;
+
+typedef struct _compress_header_t
+{
+	// 형식 식별자(COMPRESS_MAGIC)
+	char magic[8];
+	// 형식 버전
+	unsigned int version;
+	// 블록 하나의 최대 논리 크기
+	unsigned int blockSize;
+	// 압축 해제된 전체 크기
+	long long logicalSize;
+	// 전체 라인 수
+	long long line;
+	// 전체 문자 개수
+	long long totalCharCount;
+	// 블록 개수
+	long long blockCount;
+	// 블록 색인 위치
+	long long indexOffset;
+	// 예약
+	long long reserved;
+} CompressHeader, *CompressHeaderPtr;
+
+typedef struct _jfile_block_t
+{
+	// 압축된 블록이 저장된 위치
+	long long physOffset;
+	// 블록이 시작하는 논리 위치
+	long long logicalOffset;
+	// 블록 처음 바이트가 속한 라인 번호
+	long long firstLine;
+	// 압축된 블록 크기
+	unsigned int physLength;
+	// 압축 해제된 블록 크기
+	unsigned int logicalLength;
+	// 블록 속성(COMPRESS_BLOCK_RAW, COMPRESS_BLOCK_LINE_START)
+	unsigned int flags;
+	// 예약
+	unsigned int reserved;
+} JFileBlock, *JFileBlockPtr;
+
+struct _jfile_compress_t
+{
+	// 파일 헤더
+	CompressHeader header;
+	// 블록 색인
+	JFileBlockPtr blockList;
+	// 마지막으로 압축 해제한 블록 번호(없으면 -1)
+	long long cacheBlock;
+	// 마지막으로 압축 해제한 블록 내용
+	char *cacheBuf;
+	// 압축된 블록을 읽을 버퍼
+	char *physBuf;
+};
+
+typedef struct _pack_header_t
+{
+	// 형식 식별자(PACK_MAGIC)
+	char magic[8];
+	// 형식 버전
+	unsigned int version;
+	// 목차 항목 하나의 크기(sizeof(PackEntry))
+	unsigned int entrySize;
+	// 목차 항목 개수
+	long long entryCount;
+	// 목차 위치
+	long long tocOffset;
+	// 경로 문자열 테이블 위치
+	long long stringOffset;
+	// 경로 문자열 테이블 크기
+	long long stringSize;
+	// 예약
+	long long reserved;
+} PackHeader, *PackHeaderPtr;
+
+typedef struct _pack_entry_t
+{
+	// 파일 내용이 저장된 위치
+	long long offset;
+	// 파일 내용 크기
+	long long length;
+	// 경로 문자열 위치(문자열 테이블 기준)
+	long long pathOffset;
+	// 전체 라인 수
+	long long line;
+	// 전체 문자 개수
+	long long totalCharCount;
+	// 마지막 접근, 수정, 상태 변경 시각(초, 나노초)
+	long long atime;
+	long long atimeNsec;
+	long long mtime;
+	long long mtimeNsec;
+	long long ctime;
+	long long ctimeNsec;
+	// 파일 모드
+	unsigned int mode;
+	// 소유자
+	unsigned int uid;
+	unsigned int gid;
+	// 경로 문자열 길이(널 문자 제외)
+	unsigned int pathLength;
+} PackEntry, *PackEntryPtr;
+
+struct _jfile_pack_t
+{
+	// 묶음 파일을 참조하는 파일 정보 관리 구조체 개수
+	long long refCount;
+	// 묶음 파일 디스크립터
+	int fd;
+	// mmap 으로 매핑한 묶음 파일 전체
+	char *map;
+	// 매핑한 크기
+	size_t mapSize;
+	// 파일 헤더(매핑된 주소)
+	PackHeaderPtr header;
+	// 목차(매핑된 주소)
+	PackEntryPtr entryList;
+	// 경로 문자열 테이블(매핑된 주소)
+	char *stringTable;
+};
+
+typedef struct _manifest_header_t
+{
+	// 형식 식별자(MANIFEST_MAGIC)
+	char magic[8];
+	// 형식 버전
+	unsigned int version;
+	// 항목 하나의 크기(sizeof(ManifestEntry))
+	unsigned int entrySize;
+	// 항목 개수
+	long long entryCount;
+	// 항목 배열 위치
+	long long entryOffset;
+	// 라인 위치 색인 배열 위치
+	long long markOffset;
+	// 라인 위치 색인 전체 개수
+	long long markCount;
+	// 경로 문자열 테이블 위치
+	long long stringOffset;
+	// 경로 문자열 테이블 크기
+	long long stringSize;
+} ManifestHeader, *ManifestHeaderPtr;
+
+typedef struct _manifest_entry_t
+{
+	// 경로 문자열 위치(문자열 테이블 기준)
+	long long pathOffset;
+	// 저장할 때의 파일 크기, 수정 시각(초, 나노초), 아이노드, 장치 번호(변경 여부 검사에 사용)
+	long long size;
+	long long mtime;
+	long long mtimeNsec;
+	long long ino;
+	long long dev;
+	// 전체 라인 수
+	long long line;
+	// 전체 문자 개수
+	long long totalCharCount;
+	// 라인 위치 색인 시작 번호(라인 위치 색인 배열 기준)
+	long long markIndex;
+	// 라인 위치 색인 개수
+	long long markCount;
+	// 경로 문자열 길이(널 문자 제외)
+	unsigned int pathLength;
+	// 파일 모드
+	unsigned int mode;
+	// 중복 횟수
+	int dupleNum;
+	// 항목 속성(MANIFEST_ENTRY_COMPRESSED)
+	unsigned int flags;
+} ManifestEntry, *ManifestEntryPtr;
+
+typedef struct _line_count_chunk_t
+{
+	// 구간 안의 개행 문자 개수
+	long long newlineCount;
+	// 구간 안의 라인 위치 색인(라인 번호는 구간 처음 기준)
+	JFileLineMarkPtr markList;
+	// 구간 안의 라인 위치 색인 개수
+	long long markCount;
+	// 실패하면 True
+	Bool isFailed;
+} LineCountChunk, *LineCountChunkPtr;
+
+typedef struct _line_count_t
+{
+	// 파일 디스크립터
+	int fd;
+	// 파일 크기
+	off_t size;
+	// 작업 하나가 담당하는 구간 크기
+	off_t chunkSize;
+	// 구간별 결과
+	LineCountChunkPtr chunkList;
+} LineCount, *LineCountPtr;
+
+typedef struct _delta_copy_t
+{
+	// 원본 파일 디스크립터
+	int srcFd;
+	// 대상 파일 디스크립터
+	int destFd;
+	// 원본 파일 크기
+	off_t srcSize;
+	// 기존 대상 파일 크기
+	off_t destSize;
+	// 작업 하나가 담당하는 블록 크기
+	size_t blockSize;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} DeltaCopy, *DeltaCopyPtr;
+
+typedef struct _range_copy_t
+{
+	// 원본 파일 디스크립터
+	int srcFd;
+	// 대상 파일 디스크립터
+	int destFd;
+	// 원본 파일 크기
+	off_t srcSize;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} RangeCopy, *RangeCopyPtr;
+
+typedef struct _direct_copy_t
+{
+	// 원본, 대상 파일 디스크립터(O_DIRECT)
+	int srcFd;
+	int destFd;
+	// O_DIRECT 로 복사할 길이(DIRECT_ALIGN 의 배수)
+	off_t length;
+	// 돌려 쓰는 정렬된 버퍼 목록
+	char *bufList[DIRECT_BUF_NUM];
+	// 읽기를 마친 구간 개수, 쓰기를 마친 구간 개수
+	long long readCount;
+	long long writeCount;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+	// 버퍼 상태 보호용 뮤텍스와 상태 변경 알림
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+} DirectCopy, *DirectCopyPtr;
+
+typedef struct _copy_checkpoint_t
+{
+	// 형식 식별자(RESUME_MAGIC)
+	char magic[8];
+	// 복사를 시작할 때의 원본 크기, 장치와 inode 번호, 수정 시간
+	long long srcSize;
+	long long srcDev;
+	long long srcIno;
+	long long srcMtimeSec;
+	long long srcMtimeNsec;
+	// 대상 파일에 기록을 마친 위치
+	long long offset;
+	// 마지막 체크포인트 구간의 길이와 체크섬(offset 바로 앞 구간)
+	long long checksumLength;
+	unsigned long long checksum;
+	// 앞의 항목들의 체크섬(기록 중에 중단된 체크포인트 확인용, 항상 마지막 항목)
+	unsigned long long headerChecksum;
+} CopyCheckpoint, *CopyCheckpointPtr;
+
+typedef struct _multi_copy_t
+{
+	// 원본 파일 디스크립터, 복사할 구간의 시작 위치와 길이
+	int srcFd;
+	off_t srcOffset;
+	off_t length;
+	// 내용을 직접 써야 하는 대상 파일 디스크립터 목록과 개수(리플링크한 대상은 제외)
+	int *destFdList;
+	int destNum;
+	// 번갈아 쓰는 버퍼(한 버퍼를 대상 파일들에 쓰는 동안 다른 버퍼에 다음 블록을 읽는다)
+	char *bufList[2];
+	// 이번 단계에서 대상 파일들에 쓰는 블록 번호
+	long long blockIndex;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} MultiCopy, *MultiCopyPtr;
+
+typedef struct _concat_piece_t
+{
+	// 입력 파일 디스크립터(묶음 파일의 항목이면 묶음 파일 디스크립터)
+	int srcFd;
+	// 직접 연 파일 디스크립터이면 True(묶음 파일 디스크립터는 닫지 않는다)
+	Bool isOwnFd;
+	// 입력 내용의 시작 위치, 대상 파일에서의 위치, 길이
+	off_t srcOffset;
+	off_t destOffset;
+	off_t length;
+} ConcatPiece, *ConcatPiecePtr;
+
+typedef struct _concat_copy_t
+{
+	// 입력 파일 순서대로의 복사 구간 목록
+	ConcatPiecePtr pieceList;
+	// 대상 파일 디스크립터
+	int destFd;
+	// 대상 파일 시스템의 블록 크기(리플링크 가능 여부 판단용)
+	off_t blockSize;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} ConcatCopy, *ConcatCopyPtr;
+
+typedef struct _split_piece_t
+{
+	// 조각 파일 디스크립터
+	int destFd;
+	// 원본 내용에서의 시작 위치와 길이
+	off_t offset;
+	off_t length;
+	// 조각 앞까지의 개행 문자 개수(조각 첫 라인의 원본 라인 번호), 조각 안의 개행 문자 개수
+	long long firstLine;
+	long long newlineCount;
+} SplitPiece, *SplitPiecePtr;
+
+typedef struct _split_copy_t
+{
+	// 원본 파일 디스크립터(묶음 파일의 항목이면 묶음 파일 디스크립터)와 내용의 시작 위치
+	int srcFd;
+	off_t srcOffset;
+	// 조각 순서대로의 조각 목록
+	SplitPiecePtr pieceList;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} SplitCopy, *SplitCopyPtr;
+
+typedef struct _sort_line_t
+{
+	// 라인 시작 주소(개행 문자 자리에 '\0' 을 넣어서 끝냄)와 길이(개행 문자 제외)
+	char *s;
+	size_t length;
+	// 라인 앞 8 바이트를 빅 엔디언 정수로 만든 값(대부분의 비교를 정수 비교 한 번으로 끝냄)
+	unsigned long long prefix;
+	// 숫자 기준 정렬 시 라인 앞의 숫자 값
+	double number;
+} SortLine, *SortLinePtr;
+
+typedef struct _sort_output_t
+{
+	// 결과 파일 디스크립터, 쓰기 버퍼와 버퍼 크기, 버퍼에 모인 길이
+	int fd;
+	char *buf;
+	size_t bufSize;
+	size_t bufLength;
+	// 버퍼에 모인 내용을 쓸 파일 위치
+	off_t offset;
+	// 정렬 방식(JFMSortFlag 값의 비트 조합)
+	int flags;
+	// 마지막으로 쓴 라인과 그 내용 복사본(중복 제거 시 비교용)
+	SortLine lastLine;
+	char *lastBuf;
+	size_t lastCapacity;
+	Bool hasLastLine;
+	// 쓴 라인 개수, 개행 문자를 뺀 문자 개수
+	long long lineCount;
+	long long charCount;
+	// 라인 위치 색인을 만들면 True, 만든 색인 목록, 개수, 할당한 개수
+	Bool isMarking;
+	JFileLineMarkPtr markList;
+	long long markCount;
+	long long markCapacity;
+} SortOutput, *SortOutputPtr;
+
+typedef struct _sort_run_t
+{
+	// 구간 시작 위치와 길이(정렬 전에는 원본 내용, 정렬 후에는 임시 파일에서의 위치와 길이)
+	off_t offset;
+	off_t length;
+} SortRun, *SortRunPtr;
+
+typedef struct _sort_context_t
+{
+	// 정렬할 파일 정보와 파일 디스크립터(묶음 파일의 항목이면 -1)
+	JFilePtr file;
+	int fd;
+	// 정렬 방식(JFMSortFlag 값의 비트 조합)
+	int flags;
+	// 결과 파일 경로(임시 파일도 같은 디렉터리에 만듦)
+	const char *destPath;
+	// 구간(런) 목록과 개수
+	SortRunPtr runList;
+	long long runNum;
+	// 정렬한 런을 저장하는 임시 파일과 여러 단계로 병합할 때 번갈아 쓰는 임시 파일 디스크립터
+	int tempFd[2];
+	// 한 번에 병합하는 최대 런 개수
+	long long mergeNum;
+	// 런 하나를 쓰거나 읽을 때 사용하는 버퍼 크기
+	size_t bufSize;
+	// 결과 파일(런이 하나면 정렬한 구간을 바로 씀)
+	SortOutputPtr output;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} SortContext, *SortContextPtr;
+
+typedef struct _sort_reader_t
+{
+	// 런 임시 파일 디스크립터, 다음에 읽을 위치, 런의 끝 위치
+	int fd;
+	off_t offset;
+	off_t endOffset;
+	// 읽기 버퍼와 버퍼 크기, 다음 라인 시작 위치, 읽은 내용 끝 위치
+	char *buf;
+	size_t bufSize;
+	size_t start;
+	size_t end;
+	// 현재 라인(버퍼 안을 가리킴), 런을 다 읽으면 True
+	SortLine line;
+	Bool isDone;
+} SortReader, *SortReaderPtr;
+
+typedef struct _sort_merge_t
+{
+	// 런별 읽기 정보와 런 개수
+	SortReaderPtr readerList;
+	long long readerNum;
+	// 패자 트리(0 번은 승자 런 번호, 나머지는 각 경기에서 진 런 번호)
+	long long *tree;
+	// 정렬 방식(JFMSortFlag 값의 비트 조합)
+	int flags;
+} SortMerge, *SortMergePtr;
+
+typedef struct _index_header_t
+{
+	// 형식 식별자(INDEX_MAGIC)
+	char magic[8];
+	// 형식 버전
+	unsigned int version;
+	// 항목 하나의 크기(sizeof(IndexEntry))
+	unsigned int entrySize;
+	// 항목 개수와 항목 배열 위치
+	long long entryCount;
+	long long entryOffset;
+	// 블록 시작 위치 배열 위치와 전체 개수
+	long long blockOffset;
+	long long blockCount;
+	// 트라이그램 표 위치와 전체 개수
+	long long trigramOffset;
+	long long trigramCount;
+	// 경로 문자열 테이블 위치와 크기
+	long long stringOffset;
+	long long stringSize;
+	// 블록 번호 목록(posting) 영역 위치와 크기
+	long long postingOffset;
+	long long postingSize;
+} IndexHeader, *IndexHeaderPtr;
+
+typedef struct _index_entry_t
+{
+	// 경로 문자열 위치(문자열 테이블 기준)와 길이
+	long long pathOffset;
+	unsigned int pathLength;
+	unsigned int reserved;
+	// 색인할 때의 파일 크기, 수정 시각(초, 나노초), 아이노드, 장치 번호(변경 여부 검사에 사용)
+	long long size;
+	long long mtime;
+	long long mtimeNsec;
+	long long ino;
+	long long dev;
+	// 색인한 내용 끝 위치
+	long long contentSize;
+	// 블록 시작 위치 배열에서의 시작 번호와 블록 개수
+	long long blockIndex;
+	long long blockCount;
+	// 트라이그램 표에서의 시작 번호와 개수
+	long long trigramIndex;
+	long long trigramCount;
+} IndexEntry, *IndexEntryPtr;
+
+typedef struct _index_trigram_t
+{
+	// 트라이그램(연속한 3 바이트)
+	unsigned int trigram;
+	// 블록 번호 개수
+	unsigned int blockCount;
+	// 블록 번호 목록 위치(posting 영역 기준, 앞 번호와의 차이를 가변 길이 정수로 저장)
+	long long postingOffset;
+} IndexTrigram, *IndexTrigramPtr;
+
+typedef struct _index_posting_t
+{
+	// 트라이그램 + 1(0 이면 빈 슬롯)
+	unsigned int key;
+	// 블록 번호 개수, 할당한 개수
+	unsigned int count;
+	unsigned int capacity;
+	// 트라이그램이 나오는 블록 번호 목록(오름차순)
+	unsigned int *blockList;
+} IndexPosting, *IndexPostingPtr;
+
+typedef struct _index_file_t
+{
+	// 색인한 파일
+	JFilePtr file;
+	// 색인할 때의 파일 상태(다른 곳에서 바뀌었는지 확인)
+	FileStatus stat;
+	// 색인한 내용 끝 위치
+	long long contentSize;
+	// 다시 색인해야 하는 첫 위치(없으면 -1)
+	long long dirtyOffset;
+	// 블록(INDEX_BLOCK_LINES 라인) 시작 위치 목록, 블록 개수, 할당한 개수
+	long long *blockOffsetList;
+	long long blockNum;
+	long long blockCapacity;
+	// 트라이그램 해시 테이블, 슬롯 개수, 사용 중인 슬롯 개수
+	IndexPostingPtr table;
+	long long tableSize;
+	long long trigramNum;
+	// 색인 파일에 매핑된 색인이면 True(블록 시작 위치 목록도 매핑된 영역을 가리킴)
+	Bool isMapped;
+	// 매핑된 트라이그램 표와 개수, posting 영역과 크기
+	IndexTrigramPtr mappedTrigramList;
+	long long mappedTrigramNum;
+	const unsigned char *mappedPosting;
+	long long mappedPostingSize;
+} IndexFile, *IndexFilePtr;
+
+typedef struct _index_update_t
+{
+	// 내용 색인 정보
+	struct _jfm_index_t *contentIndex;
+	// 다시 색인할 파일 색인 번호 목록
+	long long *targetList;
+	// 실패한 작업이 있으면 True
+	Bool isFailed;
+} IndexUpdate, *IndexUpdatePtr;
+
+typedef struct _query_context_t
+{
+	// 파일 관리 구조체와 검색 중인 파일의 인덱스 번호
+	JFMPtr fm;
+	int index;
+	// 찾을 문자열과 길이
+	const char *s;
+	size_t length;
+	// 찾은 라인을 전달할 콜백 함수(NULL 이면 개수만 셈)
+	JFMQueryFunc callback;
+	// 찾은 라인 개수, 콜백이 멈추라고 하면 True
+	long long matchNum;
+	Bool isStopped;
+	// 읽기 버퍼(콜백에 넘길 때 '\0' 을 넣을 수 있도록 1 바이트 더 할당)와 크기
+	char *buf;
+	size_t bufSize;
+} QueryContext, *QueryContextPtr;
+
+struct _jfm_index_t
+{
+	// 파일별 색인 목록
+	IndexFilePtr fileList;
+	// 색인한 파일 개수
+	long long fileNum;
+	// 목록 배열 크기
+	long long fileCapacity;
+	// 불러온 색인 파일 매핑(없으면 NULL)과 크기
+	char *map;
+	size_t mapSize;
+};
+
+typedef struct _jfm_path_node_t
+{
+	// 부모 노드에서 이 노드로 오는 간선의 문자열과 길이(루트는 빈 문자열)
+	char *label;
+	size_t labelLength;
+	// 자식 노드 목록(간선 첫 문자 순서로 정렬), 개수, 할당한 개수
+	struct _jfm_path_node_t **childList;
+	int childNum;
+	int childCapacity;
+	// 경로가 이 노드에서 끝나는 파일과 인덱스 번호(없으면 NULL, -1)
+	JFilePtr file;
+	int fileIndex;
+} PathNode, *PathNodePtr;
+
+struct _jfm_path_iter_t
+{
+	// 찾은 파일의 인덱스 번호 목록(경로 순서), 개수, 할당한 개수
+	int *indexList;
+	long long indexNum;
+	long long indexCapacity;
+	// 다음에 반환할 위치
+	long long position;
+};
+
+typedef struct _copy_task_t
+{
+	// 복사할 파일 정보
+	JFilePtr file;
+	// 대상 경로
+	const char *destPath;
+	// 파일 크기(큰 파일부터 복사하기 위한 정렬 기준)
+	long long size;
+	// 전달받은 목록에서의 위치(결과 저장 위치)
+	int position;
+} CopyTask, *CopyTaskPtr;
+
+typedef struct _batch_copy_t
+{
+	// 크기가 큰 순서로 정렬한 복사 작업 목록
+	CopyTaskPtr taskList;
+	// 복사 옵션
+	JFMCopyOptionPtr option;
+	// 파일별 복사 결과(전달받은 목록 순서)
+	JFMCopyResultPtr resultList;
+} BatchCopy, *BatchCopyPtr;
+
+typedef struct _dirty_file_t
+{
+	// 쓰기 대기 중인 파일 정보
+	JFilePtr file;
+	// 쓰기 대기 내용
+	char *buf;
+	// 쓰기 대기 내용의 길이
+	size_t size;
+	// 버퍼 크기
+	size_t capacity;
+	// 저장하기 전에 파일 내용을 모두 지워야 하면 True("w" 모드)
+	Bool isTruncate;
+	// 처음 쓰기 대기 상태가 된 시간(밀리초)
+	long long dirtyTime;
+	// 저장하는 중이면 True
+	Bool isFlushing;
+	// 백그라운드 저장에 실패했으면 True(JFMFlush 로 다시 시도할 때까지 건너뜀)
+	Bool isFailed;
+} DirtyFile, *DirtyFilePtr;
+
+struct _jfm_write_back_t
+{
+	// 저장 조건
+	JFMWriteBackOption option;
+	// 백그라운드 저장 스레드
+	pthread_t thread;
+	// 쓰기 대기 목록 보호용 뮤텍스
+	pthread_mutex_t mutex;
+	// 저장 스레드를 깨우는 조건 변수
+	pthread_cond_t wakeCond;
+	// 파일 하나의 저장이 끝났음을 알리는 조건 변수
+	pthread_cond_t flushedCond;
+	// 쓰기 대기 중인 파일 목록
+	DirtyFilePtr dirtyList;
+	// 쓰기 대기 중인 파일 개수
+	long long dirtyNum;
+	// 목록 배열 크기
+	long long dirtyCapacity;
+	// 전체 쓰기 대기 내용의 길이
+	size_t totalDirtySize;
+	// 저장 스레드를 멈춰야 하면 True
+	Bool isStopping;
+};
+
+typedef struct _edit_piece_t
+{
+	// 원본 파일의 내용이면 True, 추가 버퍼의 내용이면 False
+	Bool isOriginal;
+	// 내용이 시작하는 위치(원본 파일 또는 추가 버퍼 안의 위치)
+	long long offset;
+	// 내용의 길이
+	long long length;
+	// 라인 개수(개행 문자로 끝나지 않은 마지막 라인 포함)
+	long long lineNum;
+	// 원본 파일에서 첫 라인의 라인 번호(원본 조각만 사용)
+	long long firstLine;
+} EditPiece, *EditPiecePtr;
+
+struct _jfm_edit_t
+{
+	// 파일 관리 구조체의 주소
+	JFMPtr fm;
+	// 편집할 파일 정보와 인덱스 번호
+	JFilePtr file;
+	int index;
+	// 원본 파일 디스크립터(읽기 전용)
+	int fd;
+	// 편집을 시작할 때의 파일 상태(다른 곳에서 바뀌었는지 확인)
+	FileStatus stat;
+	// 편집한 내용을 순서대로 나타내는 조각 목록
+	EditPiecePtr pieceList;
+	// 조각 개수
+	long long pieceNum;
+	// 조각 목록 배열 크기
+	long long pieceCapacity;
+	// 추가하거나 바꾼 라인 내용을 이어서 저장하는 버퍼
+	char *addBuffer;
+	// 추가 버퍼에 저장된 길이
+	size_t addSize;
+	// 추가 버퍼 크기
+	size_t addCapacity;
+	// 편집한 내용의 전체 라인 개수
+	long long lineNum;
+	// 마지막 라인이 개행 문자로 끝나지 않으면 True
+	Bool isLastLineOpen;
+	// 라인 위치를 찾을 때 사용하는 버퍼(READ_BUF_SIZE 크기)
+	char *buf;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Predefinitions of Static Functions for JFile
 ///////////////////////////////////////////////////////////////////////////////
 
-static JFilePtr JFileNew(const char *path);
+static JFilePtr JFileNew(const char *path, JFMAccessPolicy policy);
 static void JFileDelete(JFilePtrContainer fileContainer);
 static void JFileDataListClear(JFilePtr file);
 static JFilePtr JFileLoad(JFilePtr file);
 static void JFileRemove(JFilePtr file);
 static JFilePtr JFileWrite(JFilePtr file, const char *s, const char *mode);
+static ssize_t JFileWriteV(JFilePtr file, const struct iovec *iov, int iovcnt, off_t offset, Bool isTruncate);
+static JFilePtr JFileReplace(JFilePtr file, const void *data, size_t length, int flags);
+static long long JFileCountData(JFilePtr file, const char *data, size_t length, long long offset, long long firstLine, Bool isMarking);
 static char** JFileRead(JFilePtr file, int length);
 static void JFileGetLine(const JFilePtr file);
+static Bool JFileGetLineParallel(JFilePtr file, int fd, off_t size);
 static char* JFileGetName(const JFilePtr file);
 static char* JFileGetPath(const JFilePtr file);
 static char* JFileGetMode(const JFilePtr file);
@@ -67,6 +899,43 @@ static char* JFileSetName(JFilePtr file, const char *newFileName);
 static char* JFileSetPath(JFilePtr file, const char *newFilePath);
 static int JFileIncDupleNum(JFilePtr file);
 static char** JFileNewDataList(JFilePtr file);
+static JFilePtr JFileUpdateStat(JFilePtr file);
+static JFilePtr JFileReloadIfChanged(JFilePtr file);
+static JFilePtr JFileCopy(JFilePtr file, const char *destPath, const JFMCopyOptionPtr option);
+static JFilePtr JFileCopyMulti(JFilePtr file, const char *destPaths[], int n);
+static JFilePtr JFileNewFromCount(const char *path, long long line, long long totalCharCount, const JFileLineMarkPtr markList, long long markCount);
+static JFilePtr JFileConcat(JFilePtr files[], int n, const char *destPath);
+static off_t JFileFindLineAtOffset(JFilePtr file, int fd, char *buf, off_t offset, long long *lineNumber);
+static Bool JFileSplit(JFilePtr file, JFMSplitMode mode, int n, char *paths[], JFilePtr pieces[]);
+static JFilePtr JFileSort(JFilePtr file, const char *destPath, int flags, size_t memoryLimit, int threadNum);
+static void JFileSortRunTask(void *arg, long long taskIndex);
+static Bool JFileIndexScan(JFilePtr file, IndexFilePtr entry);
+static Bool JFileQueryRange(JFilePtr file, int fd, QueryContextPtr query, off_t start, off_t end, long long firstLine);
+static Bool JFileQuery(JFilePtr file, const IndexFilePtr entry, QueryContextPtr query);
+static void JFileDataListFree(JFilePtr file);
+static void JFileClearLineIndex(JFilePtr file);
+static Bool JFileAddLineMark(JFilePtr file, long long line, long long offset);
+static JFileLineMarkPtr JFileFindLineMark(const JFilePtr file, long long line);
+static Bool JFileSetLineIndex(JFilePtr file, const JFileLineMarkPtr markList, long long markCount);
+static void JFileClearCompress(JFilePtr file);
+static Bool JFileLoadCompress(JFilePtr file);
+static long long JFileFindBlock(const JFilePtr file, long long offset);
+static char* JFileReadBlock(JFilePtr file, int fd, long long blockIndex);
+static ssize_t JFileReadAt(JFilePtr file, int fd, char *buf, size_t length, off_t offset);
+static off_t JFileFindLineOffset(JFilePtr file, int fd, char *buf, long long lineNumber);
+static char* JFileReadLine(JFilePtr file, long long lineNumber);
+static char** JFileReadLines(JFilePtr file);
+static JFilePtr JFileCompress(JFilePtr file);
+static JFilePtr JFileDecompress(JFilePtr file);
+static struct _jfile_pack_t* JFilePackOpen(const char *packPath);
+static void JFilePackRelease(struct _jfile_pack_t *pack);
+static JFilePtr JFileNewFromPack(struct _jfile_pack_t *pack, long long packIndex);
+static JFilePtr JFileNewFromManifest(const char *path, const ManifestEntryPtr entry, const JFileLineMarkPtr markList);
+static void JFileFollowReset(JFilePtr file);
+static off_t JFileFindTailStart(JFilePtr file, int fd, off_t size, long long n);
+static Bool JFileSplitLines(JFilePtr file, int fd, off_t start, off_t end, JFMLinesPtr out);
+static int JFileFollowRead(JFilePtr file, int fd, JFMPtr fm, int index, JFMFollowFunc callback);
+static JFilePtr JFilePrefetch(JFilePtr file);
 
 ///////////////////////////////////////////////////////////////////////////////
 /// Predefinitions of Static Functions for JFile
@@ -75,6 +944,37 @@ static char** JFileNewDataList(JFilePtr file);
 static Bool JFMCheckIndex(const JFMPtr fm, int index);
 static FileType JFMCheckFileType(const JFMPtr fm, int index);
 static int JFMFindEmptyFileIndex(const JFMPtr fm);
+static JFMPtr JFMAddFiles(JFMPtr fm, JFilePtr files[], long long n);
+static Bool JFMCheckNewPath(const JFMPtr fm, const char *path);
+static void JFMCopyFilesTask(void *arg, long long taskIndex);
+static long long JFMWriteBackFind(const struct _jfm_write_back_t *writeBack, const JFilePtr file);
+static void JFMWriteBackRemove(struct _jfm_write_back_t *writeBack, long long dirtyIndex);
+static Bool JFMWriteBackAppend(struct _jfm_write_back_t *writeBack, JFilePtr file, const char *s, const char *mode);
+static Bool JFMWriteBackFlushFile(struct _jfm_write_back_t *writeBack, JFilePtr file);
+static void JFMWriteBackDiscard(struct _jfm_write_back_t *writeBack, JFilePtr file);
+static void JFMWriteBackStop(JFMPtr fm);
+static void* JFMWriteBackWorker(void *arg);
+static JFMEditPtr JFMEditReset(JFMEditPtr edit);
+static Bool JFMEditInsertPiece(JFMEditPtr edit, long long pieceIndex, const EditPiecePtr piece);
+static void JFMEditRemovePieces(JFMEditPtr edit, long long startIndex, long long endIndex);
+static long long JFMEditSplit(JFMEditPtr edit, long long lineNumber);
+static Bool JFMEditAddText(JFMEditPtr edit, const char *line, EditPiecePtr piece);
+static Bool JFMEditCloseLastLine(JFMEditPtr edit);
+static IndexFilePtr JFMIndexFind(const struct _jfm_index_t *contentIndex, const JFilePtr file);
+static IndexFilePtr JFMIndexAdd(struct _jfm_index_t *contentIndex, JFilePtr file);
+static void JFMIndexRemove(struct _jfm_index_t *contentIndex, const JFilePtr file);
+static void JFMIndexMarkDirty(JFMPtr fm, const JFilePtr file, long long offset);
+static Bool JFMIndexSync(JFMPtr fm, int index);
+static void JFMIndexUpdateTask(void *arg, long long taskIndex);
+static void JFMIndexUnmap(struct _jfm_index_t *contentIndex);
+static void JFMIndexFree(JFMPtr fm);
+static PathNodePtr JFMPathIndexGet(JFMPtr fm);
+static void JFMPathIndexAdd(JFMPtr fm, JFilePtr file, int index);
+static void JFMPathIndexRemove(JFMPtr fm, const JFilePtr file);
+static void JFMPathIndexFree(JFMPtr fm);
+static Bool JFMSetFilePath(JFMPtr fm, int index, const char *path);
+static JFMPathIterPtr JFMPathIterNew(JFMPtr fm, const char *prefix, size_t prefixLength, const char *pattern);
+static Bool JFMPathIterCollect(const JFMPtr fm, JFMPathIterPtr iter, const PathNodePtr node, const char *pattern);
 
 ///////////////////////////////////////////////////////////////////////////////
 /// Static Util Functions
@@ -83,18 +983,96 @@ static int JFMFindEmptyFileIndex(const JFMPtr fm);
 static Bool _CheckIfPath(const char *s);
 static void _ConvertModeToString(char *s, mode_t mode);
 static Bool _CheckIfStringIsDigits(const char *s);
+static Bool _CompareFileContents(const char *path1, const char *path2);
+static int _ReflinkFile(const char *srcPath, const char *destPath);
+static int _HardlinkFile(const char *srcPath, const char *destPath);
+static Bool _GetDirPath(const char *path, char *dirPath, size_t size);
+static long long _GetMonotonicTime();
+static int _OpenTempFile(const char *path);
+static int _GetThreadNum(int threadNum);
+static int _RunTasks(TaskFunc func, void *arg, long long taskNum, int threadNum);
+static void* _RunTaskWorker(void *arg);
+static ssize_t _ReadFull(int fd, void *buf, size_t length, off_t offset);
+static void _AdviseAccess(int fd, off_t offset, off_t length, JFMAccessPolicy policy);
+static void _DropCache(int fd, off_t offset, off_t length, Bool isWritten);
+static ssize_t _WriteFull(int fd, const void *buf, size_t length, off_t offset);
+static ssize_t _WriteVFull(int fd, const struct iovec *iov, int iovcnt, off_t offset);
+static int _CopyFull(int srcFd, int destFd);
+static int _CopyParallel(int srcFd, int destFd, int threadNum);
+static void _CopyParallelChunk(void *arg, long long taskIndex);
+static int _CopyDataRange(int srcFd, int destFd, off_t offset, off_t endOffset);
+static ssize_t _CopyFileRange(int srcFd, loff_t *srcOffset, int destFd, loff_t *destOffset, size_t length);
+static int _CopyRange(int srcFd, int destFd, off_t offset, off_t length);
+static int _CopyRangeTo(int srcFd, off_t srcOffset, int destFd, off_t destOffset, off_t length);
+static int _CopyDelta(int srcFd, int destFd, const JFMCopyOptionPtr option);
+static int _CopyDirect(const char *srcPath, int srcFd, const char *destPath, int destFd);
+static void* _CopyDirectReader(void *arg);
+static int _CopyResume(int srcFd, const char *destPath, int destFd, const JFMCopyOptionPtr option);
+static off_t _CopyResumeValidate(const FileStatus *srcStat, int destFd, int checkpointFd, char *buf);
+static unsigned long long _Checksum(const void *data, size_t length, unsigned long long checksum);
+static void _CopyMultiBlock(void *arg, long long taskIndex);
+static void _ConcatFilesPiece(void *arg, long long taskIndex);
+static void _SplitFilePiece(void *arg, long long taskIndex);
+static Bool _CheckSplitPattern(const char *pattern);
+static double _ParseSortNumber(const char *s);
+static void _SortLineInit(SortLinePtr line, char *s, size_t length, int flags);
+static int _CompareSortLine(const SortLine *a, const SortLine *b, int flags);
+static int _CompareSortLineQsort(const void *a, const void *b, void *flags);
+static Bool _SortOutputInit(SortOutputPtr output, int fd, size_t bufSize, int flags, Bool isMarking);
+static Bool _SortOutputWrite(SortOutputPtr output, const SortLinePtr line);
+static Bool _SortOutputFlush(SortOutputPtr output);
+static void _SortOutputFree(SortOutputPtr output);
+static Bool _SortReaderNext(SortReaderPtr reader, int flags);
+static Bool _SortMergeLess(const SortMergePtr merge, long long a, long long b);
+static void _SortMergeAdjust(SortMergePtr merge, long long winner);
+static Bool _SortMerge(const SortContextPtr sort, long long startIndex, long long runNum, int fd, SortOutputPtr output);
+static Bool _SortMergePass(SortContextPtr sort, int srcFd, int destFd);
+static unsigned int _GetTrigram(const char *s);
+static void _IndexFileInit(IndexFilePtr entry, JFilePtr file);
+static void _IndexFileFree(IndexFilePtr entry);
+static Bool _IndexFileToMemory(IndexFilePtr entry);
+static void _IndexFileTruncate(IndexFilePtr entry, long long blockIndex);
+static long long _IndexFindBlock(const IndexFilePtr entry, long long offset);
+static IndexPostingPtr _IndexFindSlot(const IndexFilePtr entry, unsigned int trigram);
+static Bool _IndexAddPosting(IndexFilePtr entry, unsigned int trigram, unsigned int blockIndex);
+static Bool _IndexAddBlock(IndexFilePtr entry, long long offset);
+static Bool _IndexAddLine(IndexFilePtr entry, const char *s, size_t length);
+static long long _IndexGetPostings(const IndexFilePtr entry, unsigned int trigram, unsigned int *postingList);
+static size_t _IndexEncodePostings(const unsigned int *postingList, long long postingNum, unsigned char *out);
+static long long _IndexDecodePostings(const unsigned char *data, long long size, unsigned int postingNum, long long blockNum, unsigned int *postingList);
+static int _CompareUnsignedInt(const void *a, const void *b);
+static int _CompareString(const void *a, const void *b);
+static Bool _CheckUniqueStrings(const char **stringList, long long n);
+static PathNodePtr _PathNodeNew(const char *label, size_t length);
+static void _PathNodeFree(PathNodePtr node);
+static int _PathNodeFindChild(const PathNodePtr node, char c, int *position);
+static Bool _PathNodeAddChild(PathNodePtr node, int position, PathNodePtr child);
+static Bool _PathNodeInsert(PathNodePtr root, const char *path, JFilePtr file, int fileIndex);
+static void _PathNodeRemove(PathNodePtr node, const char *s, size_t length, const JFilePtr file);
+static PathNodePtr _PathNodeFind(const PathNodePtr root, const char *s, size_t length, Bool isPrefix);
+static Bool _MatchGlob(const char *pattern, const char *s);
+static Bool _MakeParentDirs(const char *path);
+static int _CompareCopyTaskSize(const void *a, const void *b);
+static void _CopyDeltaBlock(void *arg, long long taskIndex);
+static void _CountLineChunk(void *arg, long long taskIndex);
+static off_t _FindLineStart(int fd, off_t offset);
+static size_t _LZCompressBound(size_t length);
+static size_t _LZCompress(const char *src, size_t srcLength, char *dest, size_t destCapacity);
+static ssize_t _LZDecompress(const char *src, size_t srcLength, char *dest, size_t destCapacity);
+static size_t _LZWriteSequence(unsigned char *out, size_t outPos, size_t outCapacity, const unsigned char *literals, size_t literalLength, size_t offset, size_t matchLength);
 
 ///////////////////////////////////////////////////////////////////////////////
 /// Static Functions for JFile
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
- * @fn static JFilePtr JFileNew(const char *path)
+ * @fn static JFilePtr JFileNew(const char *path, JFMAccessPolicy policy)
  * @brief 파일 정보 관리 구조체 객체를 새로 생성하는 함수
  * @param path 파일 경로(입력, 읽기 전용) 
+ * @param policy 파일 접근 방식(입력, 처음 라인 수를 셀 때부터 적용)
  * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
  */
-static JFilePtr JFileNew(const char *path)
+static JFilePtr JFileNew(const char *path, JFMAccessPolicy policy)
 {
 	JFilePtr file = (JFilePtr)malloc(sizeof(JFile));
 	if(file == NULL) return NULL;
@@ -107,6 +1085,14 @@ static JFilePtr JFileNew(const char *path)
 	file->dupleNum = 0;
 	file->line = 0;
 	file->totalCharCount = 0;
+	file->lineIndex = NULL;
+	file->lineIndexSize = 0;
+	file->compress = NULL;
+	file->pack = NULL;
+	file->packIndex = -1;
+	file->followOffset = -1;
+	file->followLine = 0;
+	file->accessPolicy = policy;
 
 	if(_CheckIfPath(path) == False)
 	{
@@ -147,23 +1133,10 @@ static void JFileDelete(JFilePtrContainer fileContainer)
 	if((*fileContainer)->path != NULL) free((*fileContainer)->path);
 	if((*fileContainer)->mode != NULL) free((*fileContainer)->mode);
 	JFileClose(*fileContainer);
-
-	if((*fileContainer)->dataList != NULL)
-	{
-		int dataListIndex = 0;
-		printf("line:%d\n", (*fileContainer)->line);
-		for( ; dataListIndex < (*fileContainer)->line; dataListIndex++)
-		{
-			printf("dataListIndex:%d\n", dataListIndex);
-			if(((*fileContainer)->dataList)[dataListIndex] != NULL)
-			{
-				free(((*fileContainer)->dataList)[dataListIndex]);
-				((*fileContainer)->dataList)[dataListIndex] = NULL;
-			}
-		}
-		free((*fileContainer)->dataList);
-		(*fileContainer)->dataList = NULL;
-	}
+	JFileDataListFree(*fileContainer);
+	JFileClearLineIndex(*fileContainer);
+	JFileClearCompress(*fileContainer);
+	if((*fileContainer)->pack != NULL) JFilePackRelease((*fileContainer)->pack);
 
 	free(*fileContainer);
 	*fileContainer = NULL;
@@ -179,6 +1152,9 @@ static JFilePtr JFileLoad(JFilePtr file)
 {
 	if((file == NULL) || (file->path == NULL)) return NULL;
 
+	// 묶음 파일의 항목은 내용이 바뀌지 않으므로 목차에 저장된 정보를 그대로 사용
+	if(file->pack != NULL) return file;
+
 	// 파일 열려져 있으면 닫기
 	if(file->filePointer != NULL) fclose(file->filePointer);
 
@@ -197,8 +1173,15 @@ static JFilePtr JFileLoad(JFilePtr file)
 		return NULL;
 	}
 
-	// 파일 라인 수 및 전체 문자 개수 카운트
-	JFileGetLine(file);
+	// 이전에 읽은 내용과 색인, 따라 읽기 위치는 더 이상 유효하지 않으므로 해제
+	JFileDataListFree(file);
+	JFileClearLineIndex(file);
+	JFileClearCompress(file);
+	file->followOffset = -1;
+	file->followLine = 0;
+
+	// 압축 파일이면 헤더에 저장된 값을 사용하고, 아니면 파일 라인 수 및 전체 문자 개수 카운트
+	if(JFileLoadCompress(file) == False) JFileGetLine(file);
 
 	// 파일 모드를 문자열로 저장
 	if(JFileGetMode(file) == NULL) return NULL;
@@ -263,6 +1246,8 @@ static void JFileRemove(JFilePtr file)
 static JFilePtr JFileWrite(JFilePtr file, const char *s, const char *mode)
 {
 	if((file == NULL) || (s == NULL) || (mode == NULL)) return NULL;
+	// 압축 파일은 복원한 후에 써야 하고, 묶음 파일의 항목은 읽기 전용이다.
+	if((file->compress != NULL) || (file->pack != NULL)) return NULL;
 	if(JFileOpen(file, mode) == NULL) return NULL;
 	if(fputs(s, file->filePointer) < 0) return NULL;
 	JFileClose(file);
@@ -270,6 +1255,267 @@ static JFilePtr JFileWrite(JFilePtr file, const char *s, const char *mode)
 	return file;
 }
 
+/*
+ * @fn static ssize_t JFileWriteV(JFilePtr file, const struct iovec *iov, int iovcnt, off_t offset, Bool isTruncate)
+ * @brief 여러 버퍼의 내용을 지정한 위치에 한 번에 쓰고 파일을 다시 읽지 않고 라인 수와 문자 개수를 갱신하는 함수
+ * 덮어쓰는 구간의 기존 개행 문자 개수만 읽어서 빼고 새로 쓴 내용의 개행 문자 개수를 더한다.
+ * 파일 끝에 추가하면 라인 위치 색인도 이어서 만들고, 중간을 덮어쓰면 쓰기 시작 위치 이후의 색인만 버린다.
+ * 파일 정보에 기록된 크기나 수정 시간이 실제 파일과 다르면 다른 곳에서 바뀐 것이므로 쓴 후에 JFileLoad 로 다시 센다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param iov 쓸 내용이 저장된 버퍼 배열(입력, 읽기 전용)
+ * @param iovcnt 버퍼 개수(입력)
+ * @param offset 쓰기 시작할 위치(입력, 음수면 파일 끝)
+ * @param isTruncate 쓰기 전에 파일 내용을 모두 지울지 여부(입력, Bool 열거형 참고)
+ * @return 성공 시 쓴 길이, 실패 시 -1 반환
+ */
+static ssize_t JFileWriteV(JFilePtr file, const struct iovec *iov, int iovcnt, off_t offset, Bool isTruncate)
+{
+	if((file == NULL) || (file->path == NULL) || (iov == NULL) || (iovcnt <= 0) || (iovcnt > IOV_MAX)) return -1;
+	// 압축 파일은 복원한 후에 써야 하고, 묶음 파일의 항목은 읽기 전용이다.
+	if((file->compress != NULL) || (file->pack != NULL)) return -1;
+
+	int fd = open(file->path, O_RDWR | O_CREAT | ((isTruncate == True) ? O_TRUNC : 0), 0666);
+	if(fd == -1) return -1;
+
+	FileStatus fileStat;
+	if(fstat(fd, &fileStat) == -1)
+	{
+		close(fd);
+		return -1;
+	}
+
+	Bool isStale = ((fileStat.st_size != file->stat.st_size) || (fileStat.st_mtim.tv_sec != file->stat.st_mtim.tv_sec) || (fileStat.st_mtim.tv_nsec != file->stat.st_mtim.tv_nsec)) ? True : False;
+	if(isTruncate == True)
+	{
+		// 비어 있는 파일에서 시작하므로 기록된 정보와 비교할 필요가 없다.
+		JFileDataListFree(file);
+		JFileClearLineIndex(file);
+		file->line = 0;
+		file->totalCharCount = 0;
+		isStale = False;
+	}
+
+	off_t oldSize = fileStat.st_size;
+	off_t writeOffset = (offset < 0) ? oldSize : offset;
+	size_t totalLength = 0;
+	int iovIndex = 0;
+	for( ; iovIndex < iovcnt; iovIndex++)
+	{
+		totalLength += iov[iovIndex].iov_len;
+	}
+
+	// 덮어쓸 구간에 있던 개행 문자 개수
+	long long oldNewline = 0;
+	off_t overlapEnd = writeOffset + (off_t)totalLength;
+	if(overlapEnd > oldSize) overlapEnd = oldSize;
+	if((isStale == False) && (writeOffset < overlapEnd))
+	{
+		size_t bufSize = ((size_t)(overlapEnd - writeOffset) < READ_BUF_SIZE) ? (size_t)(overlapEnd - writeOffset) : READ_BUF_SIZE;
+		char *buf = (char*)malloc(bufSize);
+		off_t readOffset = writeOffset;
+		while((buf != NULL) && (readOffset < overlapEnd))
+		{
+			size_t readLength = bufSize;
+			if(readOffset + (off_t)readLength > overlapEnd) readLength = (size_t)(overlapEnd - readOffset);
+
+			ssize_t readSize = _ReadFull(fd, buf, readLength, readOffset);
+			if(readSize <= 0) break;
+
+			char *s = buf;
+			char *end = buf + readSize;
+			char *newline = NULL;
+			while((newline = (char*)memchr(s, '\n', (size_t)(end - s))) != NULL)
+			{
+				oldNewline++;
+				s = newline + 1;
+			}
+			readOffset += readSize;
+		}
+		// 기존 내용을 세지 못하면 쓴 후에 다시 센다.
+		if((buf == NULL) || (readOffset < overlapEnd)) isStale = True;
+		if(buf != NULL) free(buf);
+	}
+
+	ssize_t writtenSize = _WriteVFull(fd, iov, iovcnt, writeOffset);
+	if((writtenSize < 0) || (fstat(fd, &fileStat) == -1))
+	{
+		close(fd);
+		// 일부만 썼을 수 있으므로 기록된 정보는 다시 센다.
+		JFileLoad(file);
+		return -1;
+	}
+	close(fd);
+
+	if(isStale == True)
+	{
+		if(JFileLoad(file) == NULL) return -1;
+		return writtenSize;
+	}
+
+	// 기록된 정보에서 개행 문자 개수와 마지막 라인이 완성되었는지 구한다.
+	long long countedNewline = (long long)oldSize - file->totalCharCount;
+	Bool isLastLineOpen = ((oldSize > 0) && (file->line > countedNewline)) ? True : False;
+	Bool isAppend = (writeOffset >= oldSize) ? True : False;
+
+	JFileDataListFree(file);
+	if(isAppend == False)
+	{
+		// 쓰기 시작 위치 이후에 있는 라인의 위치는 바뀌었을 수 있다.
+		long long markIndex = file->lineIndexSize;
+		while((markIndex > 0) && (file->lineIndex[markIndex - 1].offset > (long long)writeOffset)) markIndex--;
+		file->lineIndexSize = markIndex;
+	}
+
+	long long newNewline = 0;
+	off_t dataOffset = writeOffset;
+	for(iovIndex = 0; iovIndex < iovcnt; iovIndex++)
+	{
+		newNewline += JFileCountData(file, (const char*)iov[iovIndex].iov_base, iov[iovIndex].iov_len, (long long)dataOffset, countedNewline - oldNewline + newNewline, isAppend);
+		dataOffset += (off_t)iov[iovIndex].iov_len;
+	}
+
+	// 파일 끝까지 덮어썼으면 새로 쓴 내용의 마지막 문자로 마지막 라인이 완성되었는지 정한다.
+	if((totalLength > 0) && (dataOffset >= oldSize))
+	{
+		int lastIndex = iovcnt - 1;
+		while(iov[lastIndex].iov_len == 0) lastIndex--;
+		isLastLineOpen = (((const char*)iov[lastIndex].iov_base)[iov[lastIndex].iov_len - 1] != '\n') ? True : False;
+	}
+
+	long long newlineCount = countedNewline - oldNewline + newNewline;
+	long long size = (long long)fileStat.st_size;
+	file->line = newlineCount + ((isLastLineOpen == True) ? 1 : 0);
+	file->totalCharCount = size - newlineCount;
+	file->stat = fileStat;
+
+	// 추가한 내용은 따라 읽기가 이어서 읽고, 기존 내용이 바뀌면 처음 위치를 다시 찾는다.
+	if(isAppend == False)
+	{
+		file->followOffset = -1;
+		file->followLine = 0;
+	}
+
+	if(JFileGetMode(file) == NULL) return -1;
+	return writtenSize;
+}
+
+/*
+ * @fn static long long JFileCountData(JFilePtr file, const char *data, size_t length, long long offset, long long firstLine, Bool isMarking)
+ * @brief 파일에 쓴 내용의 개행 문자 개수를 세고 필요하면 라인 위치 색인을 이어서 만드는 함수
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param data 파일에 쓴 내용(입력, 읽기 전용)
+ * @param length 내용의 길이(입력)
+ * @param offset 내용이 저장된 파일 안의 위치(입력)
+ * @param firstLine 내용 앞까지의 개행 문자 개수(입력)
+ * @param isMarking 라인 위치 색인을 만들지 여부(입력, Bool 열거형 참고)
+ * @return 개행 문자 개수 반환
+ */
+static long long JFileCountData(JFilePtr file, const char *data, size_t length, long long offset, long long firstLine, Bool isMarking)
+{
+	long long newlineCount = 0;
+	if((data == NULL) || (length == 0)) return 0;
+
+	const char *s = data;
+	const char *end = data + length;
+	const char *newline = NULL;
+	while((newline = (const char*)memchr(s, '\n', (size_t)(end - s))) != NULL)
+	{
+		newlineCount++;
+		if((isMarking == True) && (((firstLine + newlineCount) % LINE_INDEX_INTERVAL) == 0))
+		{
+			JFileAddLineMark(file, firstLine + newlineCount, offset + (newline - data) + 1);
+		}
+		s = newline + 1;
+	}
+
+	return newlineCount;
+}
+
+/*
+ * @fn static JFilePtr JFileReplace(JFilePtr file, const void *data, size_t length, int flags)
+ * @brief 새 내용을 같은 디렉터리의 이름 없는 임시 파일(O_TMPFILE)에 쓴 후 원래 파일과 원자적으로 교체하는 함수
+ * 임시 파일은 linkat 으로 이름을 붙인 후 rename 으로 원래 경로를 덮어쓰므로, 읽는 쪽은 이전 내용이나 새 내용 중 하나만 본다.
+ * O_TMPFILE 을 지원하지 않는 파일 시스템에서는 이름 있는 임시 파일을 사용한다.
+ * 파일은 새 inode 로 바뀌므로 하드링크로 공유하던 다른 경로는 이전 내용을 유지한다.
+ * 쓴 내용으로 라인 수와 문자 개수, 라인 위치 색인을 만들므로 파일을 다시 읽지 않는다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param data 저장할 내용(입력, 읽기 전용)
+ * @param length 내용의 길이(입력)
+ * @param flags 교체 방식(입력, JFMReplaceFlag 값의 비트 조합)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileReplace(JFilePtr file, const void *data, size_t length, int flags)
+{
+	if((file == NULL) || (file->path == NULL) || ((data == NULL) && (length > 0))) return NULL;
+	// 압축 파일은 복원한 후에 써야 하고, 묶음 파일의 항목은 읽기 전용이다.
+	if((file->compress != NULL) || (file->pack != NULL)) return NULL;
+
+	char dirPath[PATH_MAX];
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmrep.%ld", file->path, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+	if(_GetDirPath(file->path, dirPath, sizeof(dirPath)) == False) return NULL;
+
+	// 기존 파일의 권한을 그대로 사용한다.
+	FileStatus oldStat;
+	mode_t mode = (stat(file->path, &oldStat) == 0) ? (oldStat.st_mode & 07777) : 0666;
+
+	Bool isAnonymous = True;
+	int fd = open(dirPath, O_TMPFILE | O_WRONLY, mode);
+	if(fd == -1)
+	{
+		isAnonymous = False;
+		fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, mode);
+		if(fd == -1) return NULL;
+	}
+
+	FileStatus fileStat;
+	Bool isFailed = False;
+	if((length > 0) && (_WriteFull(fd, data, length, 0) != (ssize_t)length)) isFailed = True;
+	if((isFailed == False) && (fchmod(fd, mode) == -1)) isFailed = True;
+	if((isFailed == False) && (flags & JFMReplaceSync) && (fdatasync(fd) == -1)) isFailed = True;
+
+	if((isFailed == False) && (isAnonymous == True))
+	{
+		// 이름 없는 파일은 /proc 의 파일 디스크립터 경로로 이름을 붙이고, /proc 이 없으면 AT_EMPTY_PATH 로 시도한다.
+		char procPath[64];
+		snprintf(procPath, sizeof(procPath), "/proc/self/fd/%d", fd);
+		unlink(tempPath);
+		if((linkat(AT_FDCWD, procPath, AT_FDCWD, tempPath, AT_SYMLINK_FOLLOW) == -1) && (linkat(fd, "", AT_FDCWD, tempPath, AT_EMPTY_PATH) == -1)) isFailed = True;
+	}
+
+	if((isFailed == False) && (fstat(fd, &fileStat) == -1)) isFailed = True;
+	if(close(fd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, file->path) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	if(flags & JFMReplaceSync)
+	{
+		int dirFd = open(dirPath, O_RDONLY | O_DIRECTORY);
+		if(dirFd == -1) return NULL;
+		isFailed = (fsync(dirFd) == -1) ? True : False;
+		close(dirFd);
+		if(isFailed == True) return NULL;
+	}
+
+	// 이전 내용으로 만든 정보는 버리고 쓴 내용으로 다시 만든다.
+	JFileClose(file);
+	JFileDataListFree(file);
+	JFileClearLineIndex(file);
+	long long newlineCount = JFileCountData(file, (const char*)data, length, 0, 0, True);
+	file->line = newlineCount + (((length > 0) && (((const char*)data)[length - 1] != '\n')) ? 1 : 0);
+	file->totalCharCount = (long long)length - newlineCount;
+	file->stat = fileStat;
+	file->followOffset = -1;
+	file->followLine = 0;
+
+	if(JFileGetMode(file) == NULL) return NULL;
+	return file;
+}
+
 /*
  * @fn static void JFileDataListClear(JFilePtr file)
  * @brief 파일 관리 구조체에 저장된 파일 내용을 모두 삭제하는 함수
@@ -278,13 +1524,13 @@ static JFilePtr JFileWrite(JFilePtr file, const char *s, const char *mode)
  */
 static void JFileDataListClear(JFilePtr file)
 {
-	int fileIndex = 0;
-	for( ; fileIndex < file->line; fileIndex++)
+	long long lineIndex = 0;
+	for( ; lineIndex < file->line; lineIndex++)
 	{
-		if(file->dataList[fileIndex] != NULL)
+		if(file->dataList[lineIndex] != NULL)
 		{
-			free(file->dataList[fileIndex]);
-			file->dataList[fileIndex] = NULL;
+			free(file->dataList[lineIndex]);
+			file->dataList[lineIndex] = NULL;
 		}
 	}
 }
@@ -299,14 +1545,14 @@ static char** JFileNewDataList(JFilePtr file)
 {
 	if(file->dataList == NULL)
 	{
-		int dataListSize = file->line;
-		file->dataList = (char**)malloc(sizeof(char*) * dataListSize);
+		long long dataListSize = file->line;
+		file->dataList = (char**)malloc(sizeof(char*) * (size_t)dataListSize);
 		if(file->dataList == NULL) return NULL;
 
-		int fileIndex = 0;
-		for( ; fileIndex < dataListSize; fileIndex++)
+		long long lineIndex = 0;
+		for( ; lineIndex < dataListSize; lineIndex++)
 		{
-			file->dataList[fileIndex] = NULL;
+			file->dataList[lineIndex] = NULL;
 		}
 	}
 	else JFileDataListClear(file);
@@ -324,6 +1570,7 @@ static char** JFileNewDataList(JFilePtr file)
 static char** JFileRead(JFilePtr file, int length)
 {
 	if((file == NULL) || (file->line <= 0) || (length <= 0)) return NULL;
+	if((file->compress != NULL) || (file->pack != NULL)) return JFileReadLines(file);
 
 	if(JFileOpen(file, "r") == NULL) return NULL;
 	if(JFileNewDataList(file) == NULL)
@@ -331,69 +1578,165 @@ static char** JFileRead(JFilePtr file, int length)
 		JFileClose(file);
 		return NULL;
 	}
+	_AdviseAccess(fileno(file->filePointer), 0, 0, file->accessPolicy);
 
-	int fileIndex = 0;
-	for( ; fileIndex < file->line; fileIndex++)
+	long long lineIndex = 0;
+	for( ; lineIndex < file->line; lineIndex++)
 	{
-		if(file->dataList[fileIndex] == NULL)
+		if(file->dataList[lineIndex] == NULL)
 		{
-			file->dataList[fileIndex] = (char*)malloc(sizeof(char) * length);
-			if(file->dataList[fileIndex] == NULL)
+			file->dataList[lineIndex] = (char*)malloc(sizeof(char) * length);
+			if(file->dataList[lineIndex] == NULL)
 			{
 				JFileDataListClear(file);
 				break;
 			}
 
-			char *s = fgets(file->dataList[fileIndex], length, file->filePointer);
+			char *s = fgets(file->dataList[lineIndex], length, file->filePointer);
 			if(s == NULL)
 			{
 				JFileDataListClear(file);
 				break;
 			}
 
-			int dataLength = strlen(file->dataList[fileIndex]);
-			char *newData = (char*)realloc(file->dataList[fileIndex], dataLength + 1);
+			int dataLength = strlen(file->dataList[lineIndex]);
+			char *newData = (char*)realloc(file->dataList[lineIndex], dataLength + 1);
 			if(newData == NULL)
 			{
 				JFileDataListClear(file);
 				break;
 			}
 			newData[dataLength] = '\0';
-			file->dataList[fileIndex] = newData; 
+			file->dataList[lineIndex] = newData; 
 		}
 	}
 
+	if(file->accessPolicy == JFMAccessOnce) _DropCache(fileno(file->filePointer), 0, 0, False);
 	JFileClose(file);
 	return file->dataList;
 }
 
 /*
  * @fn static void JFileGetLine(const JFilePtr file)
- * @brief 지정한 파일의 전체 라인수를 구하는 함수
+ * @brief 지정한 파일의 전체 라인수와 전체 문자 개수를 구하고 라인 위치 색인을 만드는 함수
+ * 마지막 라인이 개행 문자로 끝나지 않아도 한 라인으로 센다. 전체 문자 개수에 개행 문자는 포함하지 않는다.
+ * COUNT_PARALLEL_MIN_SIZE 이상인 파일은 구간별로 나눠서 병렬로 센다(JFileGetLineParallel).
  * @param file 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
  * @return 반환값 업음
  */
 static void JFileGetLine(const JFilePtr file)
 {
-	char c = '\0';
-	FILE *fp = fopen(file->path, "r");
-	if(fp == NULL) return;
+	file->line = 0;
+	file->totalCharCount = 0;
+
+	int fd = open(file->path, O_RDONLY);
+	if(fd == -1) return;
+	_AdviseAccess(fd, 0, 0, file->accessPolicy);
+
+	FileStatus fileStat;
+	if((fstat(fd, &fileStat) == 0) && ((long long)fileStat.st_size >= COUNT_PARALLEL_MIN_SIZE) && (_GetThreadNum(0) > 1))
+	{
+		if(JFileGetLineParallel(file, fd, fileStat.st_size) == True)
+		{
+			if(file->accessPolicy == JFMAccessOnce) _DropCache(fd, 0, 0, False);
+			close(fd);
+			return;
+		}
+		// 병렬로 세지 못하면 처음부터 순서대로 다시 센다.
+		JFileClearLineIndex(file);
+	}
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL)
+	{
+		close(fd);
+		return;
+	}
+
+	long long newlineCount = 0;
+	long long totalSize = 0;
+	char lastChar = '\n';
+
+	while(1)
+	{
+		ssize_t readSize = _ReadFull(fd, buf, READ_BUF_SIZE, (off_t)totalSize);
+		if(readSize <= 0) break;
+
+		char *s = buf;
+		char *end = buf + readSize;
+		char *newline = NULL;
+		while((newline = (char*)memchr(s, '\n', (size_t)(end - s))) != NULL)
+		{
+			newlineCount++;
+			if((newlineCount % LINE_INDEX_INTERVAL) == 0)
+			{
+				JFileAddLineMark(file, newlineCount, totalSize + (newline - buf) + 1);
+			}
+			s = newline + 1;
+		}
+
+		lastChar = end[-1];
+		totalSize += readSize;
+	}
+
+	// 개행 문자로 끝나지 않은 마지막 라인도 한 라인으로 센다.
+	file->line = newlineCount + (((totalSize > 0) && (lastChar != '\n')) ? 1 : 0);
+	file->totalCharCount = totalSize - newlineCount;
+
+	if(file->accessPolicy == JFMAccessOnce) _DropCache(fd, 0, 0, False);
+	free(buf);
+	close(fd);
+}
+
+/*
+ * @fn static Bool JFileGetLineParallel(JFilePtr file, int fd, off_t size)
+ * @brief 파일을 COUNT_CHUNK_SIZE 구간으로 나눠서 구간별 개행 문자 개수를 병렬로 세고 합치는 함수
+ * 각 구간은 구간 처음 기준의 라인 번호로 라인 위치 색인을 만들고, 합칠 때 앞 구간들의 개행 문자 개수를 더한다.
+ * 라인 수와 문자 개수는 순서대로 센 결과와 같고, 라인 위치 색인은 구간마다 LINE_INDEX_INTERVAL 라인 간격으로 만들어진다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param fd 파일 디스크립터(입력)
+ * @param size 파일 크기(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileGetLineParallel(JFilePtr file, int fd, off_t size)
+{
+	LineCount count;
+	count.fd = fd;
+	count.size = size;
+	count.chunkSize = (off_t)COUNT_CHUNK_SIZE;
+
+	long long chunkNum = ((long long)size + COUNT_CHUNK_SIZE - 1) / COUNT_CHUNK_SIZE;
+	count.chunkList = (LineCountChunkPtr)calloc((size_t)chunkNum, sizeof(LineCountChunk));
+	if(count.chunkList == NULL) return False;
+
+	Bool result = (_RunTasks(_CountLineChunk, &count, chunkNum, 0) == 0) ? True : False;
 
-	file->line = 1;
-	while((c = fgetc(fp)) != EOF)
+	long long newlineCount = 0;
+	long long chunkIndex = 0;
+	for( ; chunkIndex < chunkNum; chunkIndex++)
 	{
-		//개행 문자 다음 문자가 널문자가 아니면 줄 하나 증가
-		if(c == '\n')
+		LineCountChunkPtr chunk = &(count.chunkList[chunkIndex]);
+		if(chunk->isFailed == True) result = False;
+
+		long long markIndex = 0;
+		for( ; (result == True) && (markIndex < chunk->markCount); markIndex++)
 		{
-			if((c = fgetc(fp)) == EOF) break;
-			(file->line)++;
+			if(JFileAddLineMark(file, newlineCount + chunk->markList[markIndex].line, chunk->markList[markIndex].offset) == False) result = False;
 		}
-		(file->totalCharCount)++;
+		newlineCount += chunk->newlineCount;
+
+		if(chunk->markList != NULL) free(chunk->markList);
 	}
+	free(count.chunkList);
 
-	// 아무 내용도 없을 때 line 수를 0 으로 설정
-	if((file->totalCharCount == 0) && (file->line == 1)) file->line = 0;
-	fclose(fp);
+	// 마지막 라인이 개행 문자로 끝나는지 확인한다.
+	char lastChar = '\n';
+	if((result == True) && (_ReadFull(fd, &lastChar, 1, size - 1) != 1)) result = False;
+	if(result == False) return False;
+
+	file->line = newlineCount + ((lastChar != '\n') ? 1 : 0);
+	file->totalCharCount = (long long)size - newlineCount;
+	return True;
 }
 
 /*
@@ -429,6 +1772,8 @@ static char* JFileGetPath(const JFilePtr file)
 static long long JFileGetSize(const JFilePtr file)
 {
 	if(file == NULL) return -1;
+	// 압축 파일은 압축 해제된 논리 크기를 반환한다.
+	if(file->compress != NULL) return file->compress->header.logicalSize;
 	return file->stat.st_size;
 }
 
@@ -468,7 +1813,7 @@ static char* JFileSetName(JFilePtr file, const char *name)
 	if(strncat(file->path, file->name, strlen(file->name)) == NULL) return NULL;
 
 	int pathLength = strlen(file->path);
-	char *newFilePath = realloc(file->path, pathLength);
+	char *newFilePath = realloc(file->path, pathLength + 1);
 	if(newFilePath == NULL)
 	{
 		free(file);
@@ -558,596 +1903,8715 @@ static char* JFileGetMode(JFilePtr file)
 	return file->mode;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-/// Functions for JFileManager
-///////////////////////////////////////////////////////////////////////////////
-
 /*
- * @fn JFMPtr JFMNew()
- * @brief 파일 관리 구조체 객체를 새로 생성하는 함수
- * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
+ * @fn static JFilePtr JFileUpdateStat(JFilePtr file)
+ * @brief 파일 내용은 다시 읽지 않고 파일 상태 및 정보만 갱신하는 함수
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
  */
-JFMPtr JFMNew()
+static JFilePtr JFileUpdateStat(JFilePtr file)
 {
-	JFMPtr fm = (JFMPtr)malloc(sizeof(JFM));
-	if(fm == NULL) return NULL;
+	if((file == NULL) || (file->path == NULL)) return NULL;
+	if(file->pack != NULL) return file;
+	if(stat(file->path, &(file->stat)) < 0) return NULL;
+	if(JFileGetMode(file) == NULL) return NULL;
+	return file;
+}
 
-	// 맨 처음에 NULL 을 넣어서 데이터 없음을 체크
-	fm->fileContainer = (JFilePtrContainer)malloc(sizeof(JFilePtr) * 1);
-	if(fm->fileContainer == NULL)
+/*
+ * @fn static JFilePtr JFileReloadIfChanged(JFilePtr file)
+ * @brief 파일의 크기나 수정 시간이 마지막으로 읽은 후에 바뀌었으면 파일 정보를 다시 수집하는 함수
+ * 저장된 라인 수, 문자 개수, 라인 위치 색인을 그대로 사용하기 전에 호출한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileReloadIfChanged(JFilePtr file)
+{
+	if((file == NULL) || (file->path == NULL)) return NULL;
+	// 묶음 파일의 항목은 내용이 바뀌지 않는다.
+	if(file->pack != NULL) return file;
+
+	FileStatus fileStat;
+	if(stat(file->path, &fileStat) < 0) return NULL;
+	if((fileStat.st_size != file->stat.st_size)
+		|| (fileStat.st_mtim.tv_sec != file->stat.st_mtim.tv_sec)
+		|| (fileStat.st_mtim.tv_nsec != file->stat.st_mtim.tv_nsec))
 	{
-		free(fm);
-		return NULL;
+		return JFileLoad(file);
 	}
-	fm->fileContainer[0] = NULL;
-
-	fm->size = 1;
-	fm->userData = NULL;
-
-	return fm;
+	return file;
 }
 
 /*
- * @fn void JFMDelete(JFMPtrContainer fmContainer)
- * @brief 파일 관리 구조체 객체를 삭제하는 함수
- * @param fmContainer 파일 관리 구조체 객체 주소를 저장하는 포인터(입력, 이중 포인터)
- * @return 반환값 없음
+ * @fn static JFilePtr JFileCopy(JFilePtr file, const char *destPath, const JFMCopyOptionPtr option)
+ * @brief 지정한 파일의 내용을 대상 경로에 복사하는 함수
+ * 차등 복사 옵션이 있고 대상 파일이 이미 있으면 달라진 구간만 다시 쓴다.
+ * 페이지 캐시 비우기 옵션이 있거나 파일 접근 방식이 JFMAccessOnce 이면 복사한 후 원본과 대상 파일의 페이지 캐시를 비운다.
+ * O_DIRECT 옵션이 있으면 페이지 캐시를 거치지 않고 복사하고(_CopyDirect), 아니면 큰 파일은 구간별로 병렬 복사한다(_CopyParallel).
+ * 이어서 복사 옵션이 있으면 체크포인트를 남기면서 순서대로 복사하고, 중단된 복사는 마지막 체크포인트부터 이어서 복사한다(_CopyResume).
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param destPath 복사할 대상 경로(입력, 읽기 전용)
+ * @param option 복사 옵션(입력, 읽기 전용, NULL 이면 기본 복사)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
  */
-void JFMDelete(JFMPtrContainer fmContainer)
+static JFilePtr JFileCopy(JFilePtr file, const char *destPath, const JFMCopyOptionPtr option)
 {
-	if((fmContainer == NULL) || (*fmContainer == NULL)) return;
+	if((file == NULL) || (file->path == NULL) || (destPath == NULL)) return NULL;
 
-	if((*fmContainer)->fileContainer != NULL)
+	// 묶음 파일의 항목은 묶음 파일에서 해당 구간만 꺼내서 복사한다.
+	if(file->pack != NULL)
 	{
-		int fileIndex = 0;
-		int fmSize = (*fmContainer)->size;
-		for( ; fileIndex <= fmSize; fileIndex++)
-		{
-			JFileDelete(&(((*fmContainer)->fileContainer)[fileIndex]));
-		}
+		PackEntryPtr entry = &(file->pack->entryList[file->packIndex]);
+		int packDestFd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if(packDestFd == -1) return NULL;
+
+		int packResult = _CopyRangeTo(file->pack->fd, (off_t)entry->offset, packDestFd, 0, (off_t)entry->length);
+		if((packResult == 0) && (ftruncate(packDestFd, (off_t)entry->length) == -1)) packResult = -1;
+		if(close(packDestFd) == -1) packResult = -1;
+		return (packResult == -1) ? NULL : file;
+	}
+
+	int srcFd = open(file->path, O_RDONLY);
+	if(srcFd == -1) return NULL;
+	_AdviseAccess(srcFd, 0, 0, file->accessPolicy);
+
+	int destFd = -1;
+	int result = -1;
+	FileStatus destStat;
+	Bool isDropCache = (((option != NULL) && (option->flags & JFMCopyDropCache)) || (file->accessPolicy == JFMAccessOnce)) ? True : False;
+
+	if((option != NULL) && (option->flags & JFMCopyResume))
+	{
+		// 이미 복사한 앞부분을 살려야 하므로 잘라내지 않고 연다.
+		destFd = open(destPath, O_RDWR | O_CREAT, 0666);
+		if(destFd != -1) result = _CopyResume(srcFd, destPath, destFd, option);
+	}
+	else if((option != NULL) && (option->flags & JFMCopyDelta) && (stat(destPath, &destStat) == 0) && S_ISREG(destStat.st_mode))
+	{
+		// 기존 내용을 비교해야 하므로 잘라내지 않고 연다.
+		destFd = open(destPath, O_RDWR);
+		if(destFd != -1) result = _CopyDelta(srcFd, destFd, option);
+	}
+	else
+	{
+		destFd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if(destFd != -1)
+		{
+			if((option != NULL) && (option->flags & JFMCopyDirect)) result = _CopyDirect(file->path, srcFd, destPath, destFd);
+			else result = _CopyParallel(srcFd, destFd, (option != NULL) ? option->threadNum : 0);
+		}
+	}
+
+	// 한 번만 쓰는 복사가 자주 쓰는 다른 파일의 페이지 캐시를 밀어내지 않도록 한다.
+	if((result == 0) && (isDropCache == True))
+	{
+		_DropCache(srcFd, 0, 0, False);
+		_DropCache(destFd, 0, 0, True);
+	}
+
+	close(srcFd);
+	if(destFd != -1) close(destFd);
+	return (result == -1) ? NULL : file;
+}
+
+/*
+ * @fn static JFilePtr JFileCopyMulti(JFilePtr file, const char *destPaths[], int n)
+ * @brief 지정한 파일의 내용을 한 번만 읽어서 여러 대상 경로에 복사하는 함수
+ * 원본과 같은 파일 시스템에 있는 대상 파일은 먼저 리플링크로 데이터 블록을 공유하고, 나머지 대상 파일에는 블록을 하나씩 읽어서 모두에게 병렬로 쓴다.
+ * 블록 하나를 대상 파일들에 쓰는 동안 다음 블록을 미리 읽으므로 원본 읽기 양은 대상 개수와 관계없이 파일 크기 한 번이다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param destPaths 대상 경로 배열(입력, 읽기 전용)
+ * @param n 대상 경로 개수(입력)
+ * @return 모든 대상에 복사하면 파일 정보 관리 구조체의 주소, 하나라도 실패하면 NULL 반환
+ */
+static JFilePtr JFileCopyMulti(JFilePtr file, const char *destPaths[], int n)
+{
+	if((file == NULL) || (file->path == NULL) || (destPaths == NULL) || (n <= 0)) return NULL;
+
+	MultiCopy multi;
+	multi.destNum = 0;
+	multi.blockIndex = 0;
+	multi.isFailed = False;
+	multi.destFdList = (int*)malloc(sizeof(int) * (size_t)n);
+	multi.bufList[0] = (char*)malloc(MULTI_COPY_BUF_SIZE);
+	multi.bufList[1] = (char*)malloc(MULTI_COPY_BUF_SIZE);
+	if((multi.destFdList == NULL) || (multi.bufList[0] == NULL) || (multi.bufList[1] == NULL))
+	{
+		if(multi.destFdList != NULL) free(multi.destFdList);
+		if(multi.bufList[0] != NULL) free(multi.bufList[0]);
+		if(multi.bufList[1] != NULL) free(multi.bufList[1]);
+		return NULL;
+	}
+
+	// 묶음 파일의 항목은 묶음 파일에서 해당 구간만 읽는다.
+	if(file->pack != NULL)
+	{
+		multi.srcFd = file->pack->fd;
+		multi.srcOffset = (off_t)file->pack->entryList[file->packIndex].offset;
+		multi.length = (off_t)file->pack->entryList[file->packIndex].length;
+	}
+	else
+	{
+		FileStatus srcStat;
+		multi.srcFd = open(file->path, O_RDONLY);
+		multi.srcOffset = 0;
+		if((multi.srcFd == -1) || (fstat(multi.srcFd, &srcStat) == -1)) multi.isFailed = True;
+		else multi.length = srcStat.st_size;
+	}
+
+	int destIndex = 0;
+	for( ; (multi.isFailed == False) && (destIndex < n); destIndex++)
+	{
+		int destFd = open(destPaths[destIndex], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if(destFd == -1)
+		{
+			multi.isFailed = True;
+			continue;
+		}
+
+		if(file->pack == NULL)
+		{
+			struct file_clone_range range;
+			range.src_fd = multi.srcFd;
+			range.src_offset = 0;
+			// 길이가 0 이면 원본 파일 끝까지 공유
+			range.src_length = 0;
+			range.dest_offset = 0;
+			if(ioctl(destFd, FICLONERANGE, &range) == 0)
+			{
+				close(destFd);
+				continue;
+			}
+		}
+
+		multi.destFdList[multi.destNum] = destFd;
+		multi.destNum++;
+	}
+
+	if((multi.isFailed == False) && (multi.destNum > 0))
+	{
+		_AdviseAccess(multi.srcFd, multi.srcOffset, multi.length, file->accessPolicy);
+
+		long long blockNum = (long long)((multi.length + MULTI_COPY_BUF_SIZE - 1) / MULTI_COPY_BUF_SIZE);
+		off_t firstLength = (multi.length < MULTI_COPY_BUF_SIZE) ? multi.length : MULTI_COPY_BUF_SIZE;
+		if(_ReadFull(multi.srcFd, multi.bufList[0], (size_t)firstLength, multi.srcOffset) != (ssize_t)firstLength) multi.isFailed = True;
+
+		// 마지막 블록이 아니면 대상 파일 개수만큼의 쓰기 작업 뒤에 다음 블록 읽기 작업을 하나 더 붙인다.
+		for( ; (multi.isFailed == False) && (multi.blockIndex < blockNum); multi.blockIndex++)
+		{
+			long long taskNum = (long long)multi.destNum + ((multi.blockIndex + 1 < blockNum) ? 1 : 0);
+			if(_RunTasks(_CopyMultiBlock, &multi, taskNum, 0) == -1) multi.isFailed = True;
+		}
+
+		for(destIndex = 0; destIndex < multi.destNum; destIndex++)
+		{
+			if((multi.isFailed == False) && (ftruncate(multi.destFdList[destIndex], multi.length) == -1)) multi.isFailed = True;
+		}
+
+		if(file->accessPolicy == JFMAccessOnce) _DropCache(multi.srcFd, multi.srcOffset, multi.length, False);
+	}
+
+	for(destIndex = 0; destIndex < multi.destNum; destIndex++)
+	{
+		if(close(multi.destFdList[destIndex]) == -1) multi.isFailed = True;
+	}
+	if((file->pack == NULL) && (multi.srcFd != -1)) close(multi.srcFd);
+
+	free(multi.bufList[1]);
+	free(multi.bufList[0]);
+	free(multi.destFdList);
+	return (multi.isFailed == True) ? NULL : file;
+}
+
+/*
+ * @fn static JFilePtr JFileNewFromCount(const char *path, long long line, long long totalCharCount, const JFileLineMarkPtr markList, long long markCount)
+ * @brief 내용을 직접 만든 파일에 대해 이미 알고 있는 라인 수, 문자 개수, 라인 위치 색인으로 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 파일 내용을 다시 읽지 않는다.
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @param line 전체 라인 수(입력)
+ * @param totalCharCount 전체 문자 개수(입력)
+ * @param markList 라인 번호 순서로 정렬된 라인 위치 색인 목록(입력, 읽기 전용, 없으면 NULL)
+ * @param markCount 색인 개수(입력)
+ * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileNewFromCount(const char *path, long long line, long long totalCharCount, const JFileLineMarkPtr markList, long long markCount)
+{
+	JFilePtr file = (JFilePtr)malloc(sizeof(JFile));
+	if(file == NULL) return NULL;
+
+	file->name = NULL;
+	file->path = NULL;
+	file->filePointer = NULL;
+	file->dataList = NULL;
+	file->mode = NULL;
+	file->dupleNum = 0;
+	file->line = line;
+	file->totalCharCount = totalCharCount;
+	file->lineIndex = NULL;
+	file->lineIndexSize = 0;
+	file->compress = NULL;
+	file->pack = NULL;
+	file->packIndex = -1;
+	file->followOffset = -1;
+	file->followLine = 0;
+	file->accessPolicy = JFMAccessDefault;
+
+	if((JFileSetPath(file, path) == NULL)
+		|| (stat(file->path, &(file->stat)) < 0)
+		|| (JFileSetLineIndex(file, markList, markCount) == False)
+		|| (JFileGetMode(file) == NULL))
+	{
+		JFileDelete(&file);
+		return NULL;
+	}
+
+	return file;
+}
+
+/*
+ * @fn static JFilePtr JFileConcat(JFilePtr files[], int n, const char *destPath)
+ * @brief 여러 파일의 내용을 순서대로 이어 붙여서 새 파일을 만들고 그 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 파일별 구간은 대상 파일에서의 위치가 미리 정해지므로 병렬로 복사하며, 블록 경계가 맞는 구간은 리플링크로 공유하고 나머지는 copy_file_range 로 복사한다.
+ * 새 파일의 라인 수, 문자 개수, 라인 위치 색인은 입력 파일의 값을 더하고 옮겨서 만들므로 새 파일을 다시 읽지 않는다.
+ * 입력 파일이 마지막으로 읽은 후에 바뀌었으면 그 입력 파일만 다시 읽는다.
+ * @param files 이어 붙일 파일 정보 관리 구조체 객체 배열(입력, 압축 파일은 사용할 수 없음)
+ * @param n 파일 개수(입력)
+ * @param destPath 새 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileConcat(JFilePtr files[], int n, const char *destPath)
+{
+	long long markCapacity = 0;
+	int fileIndex = 0;
+	for( ; fileIndex < n; fileIndex++)
+	{
+		JFilePtr file = files[fileIndex];
+		// 압축 파일은 파일 크기와 내용 길이가 다르다.
+		if(file->compress != NULL) return NULL;
+		if(JFileReloadIfChanged(file) == NULL) return NULL;
+		// 파일 경계마다 색인을 하나씩 더 넣을 수 있다.
+		markCapacity += file->lineIndexSize + 1;
+	}
+
+	ConcatCopy concat;
+	concat.pieceList = (ConcatPiecePtr)malloc(sizeof(ConcatPiece) * (size_t)n);
+	JFileLineMarkPtr markList = (JFileLineMarkPtr)malloc(sizeof(JFileLineMark) * (size_t)markCapacity);
+	if((concat.pieceList == NULL) || (markList == NULL))
+	{
+		if(concat.pieceList != NULL) free(concat.pieceList);
+		if(markList != NULL) free(markList);
+		return NULL;
+	}
+
+	concat.isFailed = False;
+	concat.destFd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	FileStatus destStat;
+	if((concat.destFd == -1) || (fstat(concat.destFd, &destStat) == -1)) concat.isFailed = True;
+	else concat.blockSize = (off_t)destStat.st_blksize;
+
+	long long markCount = 0;
+	long long newlineBefore = 0;
+	long long charCount = 0;
+	long long destOffset = 0;
+	Bool isLastLineOpen = False;
+	for(fileIndex = 0; fileIndex < n; fileIndex++)
+	{
+		JFilePtr file = files[fileIndex];
+		ConcatPiecePtr piece = &(concat.pieceList[fileIndex]);
+		piece->isOwnFd = (file->pack == NULL) ? True : False;
+		piece->srcFd = (file->pack == NULL) ? open(file->path, O_RDONLY) : file->pack->fd;
+		piece->srcOffset = (file->pack == NULL) ? 0 : (off_t)file->pack->entryList[file->packIndex].offset;
+		piece->destOffset = (off_t)destOffset;
+		piece->length = file->stat.st_size;
+		if(piece->srcFd == -1) concat.isFailed = True;
+
+		// 앞 파일이 개행 문자로 끝났으면 이 파일의 시작 위치가 라인의 시작이다.
+		if((destOffset > 0) && (isLastLineOpen == False) && ((markCount == 0) || (markList[markCount - 1].offset != destOffset)))
+		{
+			markList[markCount].line = newlineBefore;
+			markList[markCount].offset = destOffset;
+			markCount++;
+		}
+
+		long long markIndex = 0;
+		for( ; markIndex < file->lineIndexSize; markIndex++)
+		{
+			markList[markCount].line = file->lineIndex[markIndex].line + newlineBefore;
+			markList[markCount].offset = file->lineIndex[markIndex].offset + destOffset;
+			markCount++;
+		}
+
+		long long newlineCount = (long long)piece->length - file->totalCharCount;
+		if(piece->length > 0) isLastLineOpen = (file->line > newlineCount) ? True : False;
+		newlineBefore += newlineCount;
+		charCount += file->totalCharCount;
+		destOffset += (long long)piece->length;
+	}
+
+	if(concat.isFailed == False)
+	{
+		if(_RunTasks(_ConcatFilesPiece, &concat, n, 0) == -1) concat.isFailed = True;
+	}
+	if((concat.isFailed == False) && (ftruncate(concat.destFd, (off_t)destOffset) == -1)) concat.isFailed = True;
+
+	for(fileIndex = 0; fileIndex < n; fileIndex++)
+	{
+		ConcatPiecePtr piece = &(concat.pieceList[fileIndex]);
+		if((piece->isOwnFd == True) && (piece->srcFd != -1)) close(piece->srcFd);
+	}
+	if((concat.destFd != -1) && (close(concat.destFd) == -1)) concat.isFailed = True;
+	free(concat.pieceList);
+
+	JFilePtr newFile = NULL;
+	if(concat.isFailed == False)
+	{
+		newFile = JFileNewFromCount(destPath, newlineBefore + ((isLastLineOpen == True) ? 1 : 0), charCount, markList, markCount);
+	}
+
+	free(markList);
+	return newFile;
+}
+
+/*
+ * @fn static off_t JFileFindLineAtOffset(JFilePtr file, int fd, char *buf, off_t offset, long long *lineNumber)
+ * @brief 지정한 위치나 그 뒤에서 처음 시작하는 라인의 시작 위치와 라인 번호를 찾는 함수
+ * 라인 위치 색인에서 지정한 위치 앞의 가장 가까운 색인을 찾고, 그 위치부터 개행 문자를 세면서 찾는다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 -1)
+ * @param buf 읽기에 사용할 버퍼(출력, READ_BUF_SIZE 크기)
+ * @param offset 찾기 시작할 위치(입력)
+ * @param lineNumber 찾은 라인의 번호를 저장할 주소(출력, 파일 끝이면 전체 개행 문자 개수)
+ * @return 성공 시 라인 시작 위치(그 뒤에 시작하는 라인이 없으면 파일 크기), 실패 시 -1 반환
+ */
+static off_t JFileFindLineAtOffset(JFilePtr file, int fd, char *buf, off_t offset, long long *lineNumber)
+{
+	// 색인은 라인 번호와 위치가 모두 오름차순이므로 위치로도 이진 탐색할 수 있다.
+	long long low = 0;
+	long long high = file->lineIndexSize - 1;
+	off_t position = 0;
+	long long line = 0;
+	while(low <= high)
+	{
+		long long mid = low + (high - low) / 2;
+		if((off_t)file->lineIndex[mid].offset <= offset)
+		{
+			position = (off_t)file->lineIndex[mid].offset;
+			line = file->lineIndex[mid].line;
+			low = mid + 1;
+		}
+		else high = mid - 1;
+	}
+
+	Bool isFound = (position >= offset) ? True : False;
+	while(isFound == False)
+	{
+		ssize_t readSize = JFileReadAt(file, fd, buf, READ_BUF_SIZE, position);
+		if(readSize < 0) return -1;
+		if(readSize == 0) break;
+
+		char *s = buf;
+		char *newline = NULL;
+		while((newline = (char*)memchr(s, '\n', (size_t)(buf + readSize - s))) != NULL)
+		{
+			line++;
+			s = newline + 1;
+			if(position + (off_t)(s - buf) >= offset)
+			{
+				isFound = True;
+				break;
+			}
+		}
+		position += (isFound == True) ? (off_t)(s - buf) : (off_t)readSize;
+	}
+
+	*lineNumber = line;
+	return position;
+}
+
+/*
+ * @fn static Bool JFileSplit(JFilePtr file, JFMSplitMode mode, int n, char *paths[], JFilePtr pieces[])
+ * @brief 파일을 라인 경계에서 n 개의 조각 파일로 나누고 조각별 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 자를 위치는 라인 위치 색인으로 찾으므로 색인 사이의 라인만 읽고, 조각은 copy_file_range 로 병렬 복사한다.
+ * 조각의 라인 수, 문자 개수, 라인 위치 색인은 원본의 값으로 계산하므로 조각을 다시 읽지 않는다.
+ * 라인이 조각 개수보다 적거나 한 라인이 여러 조각 크기에 걸치면 빈 조각이 생길 수 있다.
+ * @param file 파일 정보 관리 구조체의 주소(입력, 압축 파일은 사용할 수 없음)
+ * @param mode 나누는 기준(입력, JFMSplitMode 열거형 참고)
+ * @param n 조각 개수(입력)
+ * @param paths 조각 파일 경로 배열(입력, 읽기 전용)
+ * @param pieces 생성한 조각 파일 정보 관리 구조체 객체를 저장할 배열(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileSplit(JFilePtr file, JFMSplitMode mode, int n, char *paths[], JFilePtr pieces[])
+{
+	// 압축 파일은 파일 크기와 내용 길이가 다르다.
+	if(file->compress != NULL) return False;
+	if(JFileReloadIfChanged(file) == NULL) return False;
+
+	SplitCopy split;
+	split.isFailed = False;
+	split.srcFd = (file->pack == NULL) ? open(file->path, O_RDONLY) : file->pack->fd;
+	split.srcOffset = (file->pack == NULL) ? 0 : (off_t)file->pack->entryList[file->packIndex].offset;
+	split.pieceList = (SplitPiecePtr)malloc(sizeof(SplitPiece) * (size_t)n);
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if((split.srcFd == -1) || (split.pieceList == NULL) || (buf == NULL))
+	{
+		if((file->pack == NULL) && (split.srcFd != -1)) close(split.srcFd);
+		if(split.pieceList != NULL) free(split.pieceList);
+		if(buf != NULL) free(buf);
+		return False;
+	}
+
+	// 라인 위치 색인으로 찾을 때 묶음 파일의 항목은 파일 디스크립터 없이 읽는다.
+	int readFd = (file->pack == NULL) ? split.srcFd : -1;
+	off_t size = file->stat.st_size;
+	long long newlineTotal = (long long)size - file->totalCharCount;
+
+	// 조각 k 는 k 번째 자르는 위치부터 k + 1 번째 자르는 위치 앞까지이다.
+	off_t cutOffset = 0;
+	long long cutLine = 0;
+	int pieceIndex = 0;
+	for( ; pieceIndex < n; pieceIndex++)
+	{
+		split.pieceList[pieceIndex].destFd = -1;
+	}
+
+	for(pieceIndex = 0; (split.isFailed == False) && (pieceIndex < n); pieceIndex++)
+	{
+		SplitPiecePtr piece = &(split.pieceList[pieceIndex]);
+		piece->offset = cutOffset;
+		piece->firstLine = cutLine;
+
+		if(pieceIndex == n - 1)
+		{
+			cutOffset = size;
+			cutLine = newlineTotal;
+		}
+		else if(mode == JFMSplitBySize)
+		{
+			cutOffset = JFileFindLineAtOffset(file, readFd, buf, (off_t)((long long)size * (pieceIndex + 1) / n), &cutLine);
+		}
+		else
+		{
+			cutLine = file->line * (pieceIndex + 1) / n;
+			cutOffset = JFileFindLineOffset(file, readFd, buf, cutLine);
+		}
+
+		if(cutOffset < piece->offset) split.isFailed = True;
+		piece->length = cutOffset - piece->offset;
+		piece->newlineCount = cutLine - piece->firstLine;
+	}
+	free(buf);
+
+	for(pieceIndex = 0; (split.isFailed == False) && (pieceIndex < n); pieceIndex++)
+	{
+		split.pieceList[pieceIndex].destFd = open(paths[pieceIndex], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if(split.pieceList[pieceIndex].destFd == -1) split.isFailed = True;
+	}
+
+	if(split.isFailed == False)
+	{
+		_AdviseAccess(split.srcFd, split.srcOffset, size, file->accessPolicy);
+		if(_RunTasks(_SplitFilePiece, &split, n, 0) == -1) split.isFailed = True;
+	}
+
+	for(pieceIndex = 0; pieceIndex < n; pieceIndex++)
+	{
+		SplitPiecePtr piece = &(split.pieceList[pieceIndex]);
+		if((piece->destFd != -1) && (close(piece->destFd) == -1)) split.isFailed = True;
+		pieces[pieceIndex] = NULL;
+	}
+	if(file->pack == NULL) close(split.srcFd);
+
+	// 조각 안에 있는 원본의 라인 위치 색인을 조각 기준으로 옮긴다.
+	long long markIndex = 0;
+	for(pieceIndex = 0; (split.isFailed == False) && (pieceIndex < n); pieceIndex++)
+	{
+		SplitPiecePtr piece = &(split.pieceList[pieceIndex]);
+		long long markStart = markIndex;
+		while((markIndex < file->lineIndexSize) && ((off_t)file->lineIndex[markIndex].offset < piece->offset + piece->length)) markIndex++;
+
+		JFileLineMarkPtr markList = NULL;
+		long long markCount = 0;
+		if(markIndex > markStart)
+		{
+			markList = (JFileLineMarkPtr)malloc(sizeof(JFileLineMark) * (size_t)(markIndex - markStart));
+			if(markList == NULL)
+			{
+				split.isFailed = True;
+				break;
+			}
+			long long sourceIndex = markStart;
+			for( ; sourceIndex < markIndex; sourceIndex++)
+			{
+				// 조각의 시작 위치에 있는 색인은 필요 없다.
+				if((off_t)file->lineIndex[sourceIndex].offset <= piece->offset) continue;
+				markList[markCount].line = file->lineIndex[sourceIndex].line - piece->firstLine;
+				markList[markCount].offset = file->lineIndex[sourceIndex].offset - (long long)piece->offset;
+				markCount++;
+			}
+		}
+
+		// 개행 문자로 끝나지 않는 마지막 라인은 파일 끝까지 내용이 있는 조각이 가진다(크기 기준이면 그 뒤 조각은 모두 빈 조각).
+		Bool hasOpenLine = ((file->line > newlineTotal) && (piece->length > 0) && (piece->offset + piece->length == size)) ? True : False;
+		long long line = piece->newlineCount + ((hasOpenLine == True) ? 1 : 0);
+		pieces[pieceIndex] = JFileNewFromCount(paths[pieceIndex], line, (long long)piece->length - piece->newlineCount, markList, markCount);
+		if(markList != NULL) free(markList);
+		if(pieces[pieceIndex] == NULL) split.isFailed = True;
+	}
+
+	free(split.pieceList);
+	if(split.isFailed == True)
+	{
+		for(pieceIndex = 0; pieceIndex < n; pieceIndex++)
+		{
+			if(pieces[pieceIndex] != NULL) JFileDelete(&(pieces[pieceIndex]));
+		}
+		return False;
+	}
+	return True;
+}
+
+/*
+ * @fn static JFilePtr JFileSort(JFilePtr file, const char *destPath, int flags, size_t memoryLimit, int threadNum)
+ * @brief 파일의 라인을 정렬해서 지정한 파일에 저장하고 그 파일의 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 메모리 크기에 맞춰 라인 경계에서 구간(런)을 나누고, 구간마다 병렬로 정렬해서 임시 파일에 쓴 후 패자 트리로 병합한다.
+ * 한 번에 병합하는 런 개수는 런마다 읽기 버퍼 하나를 둘 수 있는 개수(최대 SORT_MAX_MERGE_NUM)로 제한하고,
+ * 더 많으면 두 임시 파일을 번갈아 쓰면서 묶음별로 병합하기를 반복한다.
+ * 구간이 하나면 임시 파일 없이 바로 결과 파일에 쓴다. 결과 파일의 라인 수, 문자 개수, 라인 위치 색인은 쓰면서 만든다.
+ * @param file 파일 정보 관리 구조체의 주소(입력, 압축 파일은 사용할 수 없음)
+ * @param destPath 결과 파일 경로(입력, 읽기 전용)
+ * @param flags 정렬 방식(입력, JFMSortFlag 값의 비트 조합)
+ * @param memoryLimit 정렬에 사용할 메모리 크기(입력, 최소 버퍼 크기보다 작으면 최소 버퍼 크기만큼 사용)
+ * @param threadNum 작업 스레드 개수(입력, 0 이하이면 CPU 개수 사용)
+ * @return 성공 시 생성된 파일 정보 관리 구조체 객체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileSort(JFilePtr file, const char *destPath, int flags, size_t memoryLimit, int threadNum)
+{
+	// 압축 파일은 파일 크기와 내용 길이가 다르다.
+	if(file->compress != NULL) return NULL;
+	if(JFileReloadIfChanged(file) == NULL) return NULL;
+
+	// 동시에 정렬하는 구간마다 구간 내용, 구간 내용의 약 2 배인 라인 정보 배열, 쓰기 버퍼 하나가 필요하다.
+	// 구간이 최소 크기보다 작아지면 메모리 크기를 넘지 않도록 동시에 정렬하는 구간 개수(스레드 개수)를 줄인다.
+	threadNum = _GetThreadNum(threadNum);
+	size_t runMemory = memoryLimit / (size_t)threadNum;
+	if(runMemory < SORT_MIN_RUN_SIZE * 3 + SORT_MIN_BUF_SIZE)
+	{
+		threadNum = (int)(memoryLimit / (SORT_MIN_RUN_SIZE * 3 + SORT_MIN_BUF_SIZE));
+		if(threadNum < 1) threadNum = 1;
+		runMemory = memoryLimit / (size_t)threadNum;
+	}
+	off_t size = file->stat.st_size;
+	off_t runSize = (runMemory > SORT_MIN_BUF_SIZE) ? (off_t)((runMemory - SORT_MIN_BUF_SIZE) / 3) : 0;
+	if(runSize < SORT_MIN_RUN_SIZE) runSize = SORT_MIN_RUN_SIZE;
+
+	SortContext sort;
+	sort.file = file;
+	sort.flags = flags;
+	sort.destPath = destPath;
+	sort.isFailed = False;
+	sort.tempFd[0] = -1;
+	sort.tempFd[1] = -1;
+	sort.runNum = ((long long)size + (long long)runSize - 1) / (long long)runSize;
+	if(sort.runNum == 0) sort.runNum = 1;
+
+	// 병합할 때는 런마다 읽기 버퍼 하나와 출력 쓰기 버퍼 하나를 쓰므로, 버퍼를 모두 합쳐도 메모리 크기를 넘지 않게 병합 개수를 정한다.
+	sort.mergeNum = (long long)(memoryLimit / SORT_MIN_BUF_SIZE) - 1;
+	if(sort.mergeNum > SORT_MAX_MERGE_NUM) sort.mergeNum = SORT_MAX_MERGE_NUM;
+	if(sort.mergeNum < 2) sort.mergeNum = 2;
+	sort.bufSize = memoryLimit / (size_t)(sort.mergeNum + 1);
+	if(sort.bufSize < SORT_MIN_BUF_SIZE) sort.bufSize = SORT_MIN_BUF_SIZE;
+
+	sort.runList = (SortRunPtr)malloc(sizeof(SortRun) * (size_t)sort.runNum);
+	sort.fd = (file->pack == NULL) ? open(file->path, O_RDONLY) : -1;
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	int destFd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+	SortOutput output;
+	if(_SortOutputInit(&output, destFd, sort.bufSize, flags, True) == False) sort.isFailed = True;
+	if((sort.runList == NULL) || (buf == NULL) || (destFd == -1) || ((file->pack == NULL) && (sort.fd == -1))) sort.isFailed = True;
+	sort.output = &output;
+
+	// 런이 여러 개면 결과 파일과 같은 디렉터리의 이름 없는 임시 파일에 정렬한 런을 모두 쓴다.
+	if((sort.isFailed == False) && (sort.runNum > 1))
+	{
+		sort.tempFd[0] = _OpenTempFile(destPath);
+		if(sort.tempFd[0] == -1) sort.isFailed = True;
+	}
+
+	// 구간 k 는 k 번째 자르는 위치부터 k + 1 번째 자르는 위치 앞까지이고, 자르는 위치는 라인 위치 색인으로 찾은 라인 경계이다.
+	off_t cutOffset = 0;
+	long long runIndex = 0;
+	for( ; (sort.isFailed == False) && (runIndex < sort.runNum); runIndex++)
+	{
+		SortRunPtr run = &(sort.runList[runIndex]);
+		run->offset = cutOffset;
+
+		if(runIndex == sort.runNum - 1) cutOffset = size;
+		else
+		{
+			long long cutLine = 0;
+			cutOffset = JFileFindLineAtOffset(file, sort.fd, buf, runSize * (off_t)(runIndex + 1), &cutLine);
+		}
+
+		if(cutOffset < run->offset) sort.isFailed = True;
+		run->length = cutOffset - run->offset;
+	}
+
+	if(sort.isFailed == False)
+	{
+		if(sort.fd != -1) _AdviseAccess(sort.fd, 0, size, file->accessPolicy);
+		if(_RunTasks(JFileSortRunTask, &sort, sort.runNum, threadNum) == -1) sort.isFailed = True;
+	}
+
+	// 병합 개수보다 런이 많으면 묶음별로 다른 임시 파일에 병합해서 런 개수를 줄이고, 마지막에 결과 파일로 병합한다.
+	int srcIndex = 0;
+	while((sort.isFailed == False) && (sort.runNum > sort.mergeNum))
+	{
+		if(sort.tempFd[1 - srcIndex] == -1) sort.tempFd[1 - srcIndex] = _OpenTempFile(destPath);
+		if((sort.tempFd[1 - srcIndex] == -1) || (_SortMergePass(&sort, sort.tempFd[srcIndex], sort.tempFd[1 - srcIndex]) == False)) sort.isFailed = True;
+		srcIndex = 1 - srcIndex;
+	}
+	if((sort.isFailed == False) && (sort.runNum > 1) && (_SortMerge(&sort, 0, sort.runNum, sort.tempFd[srcIndex], &output) == False)) sort.isFailed = True;
+	if((sort.isFailed == False) && (_SortOutputFlush(&output) == False)) sort.isFailed = True;
+
+	if(sort.tempFd[0] != -1) close(sort.tempFd[0]);
+	if(sort.tempFd[1] != -1) close(sort.tempFd[1]);
+	if(sort.runList != NULL) free(sort.runList);
+	if(buf != NULL) free(buf);
+	if(sort.fd != -1) close(sort.fd);
+	if((destFd != -1) && (close(destFd) == -1)) sort.isFailed = True;
+
+	// 결과 파일의 라인은 모두 개행 문자로 끝나므로 라인 수는 개행 문자 개수와 같다.
+	JFilePtr newFile = NULL;
+	if(sort.isFailed == False) newFile = JFileNewFromCount(destPath, output.lineCount, output.charCount, output.markList, output.markCount);
+	_SortOutputFree(&output);
+	return newFile;
+}
+
+/*
+ * @fn static void JFileSortRunTask(void *arg, long long taskIndex)
+ * @brief 구간(런) 하나를 읽어서 라인 단위로 정렬하고 임시 파일(런이 하나면 결과 파일)에 쓰는 작업 함수
+ * 구간 내용을 한 번에 읽은 버퍼를 라인 저장 공간으로 그대로 쓰고, 라인 정보 배열만 정렬한다.
+ * @param arg 정렬 작업 정보(SortContext)의 주소(입력)
+ * @param taskIndex 런 번호(입력)
+ * @return 반환값 없음
+ */
+static void JFileSortRunTask(void *arg, long long taskIndex)
+{
+	SortContextPtr sort = (SortContextPtr)arg;
+	SortRunPtr run = &(sort->runList[taskIndex]);
+	if(sort->isFailed == True) return;
+
+	char *arena = (char*)malloc((size_t)run->length + 1);
+	if(arena == NULL)
+	{
+		sort->isFailed = True;
+		return;
+	}
+	if(JFileReadAt(sort->file, sort->fd, arena, (size_t)run->length, run->offset) != (ssize_t)run->length)
+	{
+		free(arena);
+		sort->isFailed = True;
+		return;
+	}
+
+	// 마지막 구간만 개행 문자로 끝나지 않는 라인을 가질 수 있고, 그 라인은 버퍼 끝에 '\0' 을 넣어서 끝낸다.
+	char *end = arena + run->length;
+	char *s = arena;
+	char *newline = NULL;
+	long long lineNum = 0;
+	while((newline = (char*)memchr(s, '\n', (size_t)(end - s))) != NULL)
+	{
+		lineNum++;
+		s = newline + 1;
+	}
+	if(s < end) lineNum++;
+	*end = '\0';
+
+	SortLinePtr lineList = (SortLinePtr)malloc(sizeof(SortLine) * (size_t)((lineNum > 0) ? lineNum : 1));
+	if(lineList == NULL)
+	{
+		free(arena);
+		sort->isFailed = True;
+		return;
+	}
+
+	long long lineIndex = 0;
+	for(s = arena; s < end; lineIndex++)
+	{
+		newline = (char*)memchr(s, '\n', (size_t)(end - s));
+		if(newline == NULL) newline = end;
+		*newline = '\0';
+		_SortLineInit(&(lineList[lineIndex]), s, (size_t)(newline - s), sort->flags);
+		s = newline + 1;
+	}
+	qsort_r(lineList, (size_t)lineNum, sizeof(SortLine), _CompareSortLineQsort, &(sort->flags));
+
+	// 런이 여러 개면 병합할 수 있도록 임시 파일의 원본 구간과 같은 위치에 쓴다.
+	// 정렬한 런은 원본 구간보다 길지 않으므로(마지막 런만 개행 문자 하나가 늘 수 있음) 다른 런과 겹치지 않는다.
+	SortOutput runOutput;
+	SortOutputPtr output = sort->output;
+	Bool isWritten = True;
+	if(sort->runNum > 1)
+	{
+		output = &runOutput;
+		if(_SortOutputInit(output, sort->tempFd[0], SORT_MIN_BUF_SIZE, sort->flags, False) == False) isWritten = False;
+		output->offset = run->offset;
+	}
+
+	for(lineIndex = 0; (isWritten == True) && (lineIndex < lineNum); lineIndex++)
+	{
+		if(_SortOutputWrite(output, &(lineList[lineIndex])) == False) isWritten = False;
+	}
+	if((isWritten == True) && (_SortOutputFlush(output) == False)) isWritten = False;
+	if(sort->runNum > 1)
+	{
+		run->length = runOutput.offset - run->offset;
+		_SortOutputFree(&runOutput);
+	}
+
+	free(lineList);
+	free(arena);
+	if(isWritten == False) sort->isFailed = True;
+}
+
+/*
+ * @fn static Bool JFileIndexScan(JFilePtr file, IndexFilePtr entry)
+ * @brief 파일의 바뀐 위치를 포함하는 블록부터 끝까지 읽어서 트라이그램 색인을 다시 만드는 함수
+ * 블록은 라인 경계에서 시작하므로 바뀐 위치 앞의 블록 색인은 그대로 두고, 뒤의 블록 번호만 목록에서 지운다.
+ * 색인 파일에 매핑된 색인이면 먼저 메모리로 옮긴다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileIndexScan(JFilePtr file, IndexFilePtr entry)
+{
+	if(JFileReloadIfChanged(file) == NULL) return False;
+	if(_IndexFileToMemory(entry) == False) return False;
+
+	long long blockIndex = _IndexFindBlock(entry, entry->dirtyOffset);
+	off_t offset = (blockIndex < entry->blockNum) ? (off_t)entry->blockOffsetList[blockIndex] : 0;
+	_IndexFileTruncate(entry, blockIndex);
+	long long line = blockIndex * INDEX_BLOCK_LINES;
+
+	int fd = (file->pack == NULL) ? open(file->path, O_RDONLY) : -1;
+	size_t bufSize = READ_BUF_SIZE;
+	char *buf = (char*)malloc(bufSize);
+	if(((file->pack == NULL) && (fd == -1)) || (buf == NULL))
+	{
+		if(fd != -1) close(fd);
+		if(buf != NULL) free(buf);
+		return False;
+	}
+	if(fd != -1) _AdviseAccess(fd, offset, 0, JFMAccessSequential);
+
+	Bool result = True;
+	size_t length = 0;
+	while(result == True)
+	{
+		// 버퍼보다 긴 라인이면 버퍼를 늘린다.
+		if(length == bufSize)
+		{
+			char *newBuf = (char*)realloc(buf, bufSize * 2);
+			if(newBuf == NULL)
+			{
+				result = False;
+				break;
+			}
+			buf = newBuf;
+			bufSize *= 2;
+		}
+
+		ssize_t readSize = JFileReadAt(file, fd, buf + length, bufSize - length, offset + (off_t)length);
+		if(readSize < 0)
+		{
+			result = False;
+			break;
+		}
+		length += (size_t)readSize;
+		Bool isEnd = (readSize == 0) ? True : False;
+
+		char *s = buf;
+		char *end = buf + length;
+		while((result == True) && (s < end))
+		{
+			// 버퍼 끝에 걸친 라인은 다음에 이어서 읽는다. 파일 끝이면 개행 문자로 끝나지 않는 마지막 라인이다.
+			char *newline = (char*)memchr(s, '\n', (size_t)(end - s));
+			if((newline == NULL) && (isEnd == False)) break;
+			if(newline == NULL) newline = end;
+
+			if(((line % INDEX_BLOCK_LINES) == 0) && (_IndexAddBlock(entry, (long long)offset + (long long)(s - buf)) == False)) result = False;
+			else if(_IndexAddLine(entry, s, (size_t)(newline - s)) == False) result = False;
+			line++;
+			s = (newline < end) ? newline + 1 : end;
+		}
+
+		size_t consumed = (size_t)(s - buf);
+		memmove(buf, s, length - consumed);
+		length -= consumed;
+		offset += (off_t)consumed;
+		if(isEnd == True) break;
+	}
+
+	free(buf);
+	if(fd != -1) close(fd);
+	if(result == False) return False;
+
+	entry->contentSize = (long long)offset;
+	entry->stat = file->stat;
+	entry->dirtyOffset = -1;
+	return True;
+}
+
+/*
+ * @fn static Bool JFileQueryRange(JFilePtr file, int fd, QueryContextPtr query, off_t start, off_t end, long long firstLine)
+ * @brief 파일의 지정한 구간을 라인 단위로 읽으면서 찾을 문자열이 있는 라인을 콜백에 전달하는 함수
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 -1)
+ * @param query 검색 정보의 주소(출력)
+ * @param start 구간 시작 위치(입력, 라인 시작 위치)
+ * @param end 구간 끝 위치(입력, 음수이면 파일 끝까지)
+ * @param firstLine 구간 첫 라인의 번호(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileQueryRange(JFilePtr file, int fd, QueryContextPtr query, off_t start, off_t end, long long firstLine)
+{
+	off_t offset = start;
+	long long line = firstLine;
+	size_t length = 0;
+
+	while(query->isStopped == False)
+	{
+		if(length == query->bufSize)
+		{
+			char *newBuf = (char*)realloc(query->buf, query->bufSize * 2 + 1);
+			if(newBuf == NULL) return False;
+			query->buf = newBuf;
+			query->bufSize *= 2;
+		}
+
+		size_t readLength = query->bufSize - length;
+		if((end >= 0) && ((off_t)readLength > end - offset - (off_t)length)) readLength = (size_t)(end - offset - (off_t)length);
+		ssize_t readSize = (readLength > 0) ? JFileReadAt(file, fd, query->buf + length, readLength, offset + (off_t)length) : 0;
+		if(readSize < 0) return False;
+		length += (size_t)readSize;
+		Bool isEnd = (readSize == 0) ? True : False;
+
+		char *s = query->buf;
+		char *bufEnd = query->buf + length;
+		while((query->isStopped == False) && (s < bufEnd))
+		{
+			char *newline = (char*)memchr(s, '\n', (size_t)(bufEnd - s));
+			if((newline == NULL) && (isEnd == False)) break;
+			char *lineEnd = (newline != NULL) ? newline + 1 : bufEnd;
+			size_t lineLength = (size_t)(((newline != NULL) ? newline : bufEnd) - s);
+
+			if(memmem(s, lineLength, query->s, query->length) != NULL)
+			{
+				// 라인 뒤에 '\0' 을 잠시 넣어서 콜백에 문자열로 넘긴다.
+				char saved = *lineEnd;
+				*lineEnd = '\0';
+				query->matchNum++;
+				if((query->callback != NULL) && (query->callback(query->fm, query->index, s, line) != 0)) query->isStopped = True;
+				*lineEnd = saved;
+			}
+			line++;
+			s = lineEnd;
+		}
+
+		size_t consumed = (size_t)(s - query->buf);
+		memmove(query->buf, s, length - consumed);
+		length -= consumed;
+		offset += (off_t)consumed;
+		if(isEnd == True) break;
+	}
+
+	return True;
+}
+
+/*
+ * @fn static Bool JFileQuery(JFilePtr file, const IndexFilePtr entry, QueryContextPtr query)
+ * @brief 파일에서 찾을 문자열이 있는 라인을 모두 찾아서 콜백에 전달하는 함수
+ * 트라이그램 색인이 있으면 찾을 문자열의 트라이그램이 모두 나오는 블록만 읽고, 없거나 문자열이 3 바이트보다 짧으면 파일 전체를 읽는다.
+ * 이어지는 후보 블록은 한 번에 읽는다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param entry 파일 색인 정보의 주소(입력, 읽기 전용, 색인을 사용하지 않으면 NULL)
+ * @param query 검색 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileQuery(JFilePtr file, const IndexFilePtr entry, QueryContextPtr query)
+{
+	int fd = (file->pack == NULL) ? open(file->path, O_RDONLY) : -1;
+	if((file->pack == NULL) && (fd == -1)) return False;
+
+	Bool result = True;
+	if((entry == NULL) || (query->length < 3))
+	{
+		result = JFileQueryRange(file, fd, query, 0, -1, 0);
+		if(fd != -1) close(fd);
+		return result;
+	}
+
+	size_t listSize = sizeof(unsigned int) * (size_t)((entry->blockNum > 0) ? entry->blockNum : 1);
+	unsigned int *candidateList = (unsigned int*)malloc(listSize);
+	unsigned int *postingList = (unsigned int*)malloc(listSize);
+	if((candidateList == NULL) || (postingList == NULL)) result = False;
+
+	// 후보 블록은 찾을 문자열의 모든 트라이그램 블록 번호 목록의 교집합이다(-1 이면 아직 구하지 않음).
+	long long candidateNum = -1;
+	size_t position = 0;
+	for( ; (result == True) && (candidateNum != 0) && (position + 3 <= query->length); position++)
+	{
+		long long postingNum = _IndexGetPostings(entry, _GetTrigram(query->s + position), postingList);
+		if(postingNum < 0)
+		{
+			result = False;
+			break;
+		}
+		if(candidateNum < 0)
+		{
+			memcpy(candidateList, postingList, sizeof(unsigned int) * (size_t)postingNum);
+			candidateNum = postingNum;
+			continue;
+		}
+
+		long long candidateIndex = 0;
+		long long postingIndex = 0;
+		long long matchNum = 0;
+		while((candidateIndex < candidateNum) && (postingIndex < postingNum))
+		{
+			if(candidateList[candidateIndex] < postingList[postingIndex]) candidateIndex++;
+			else if(candidateList[candidateIndex] > postingList[postingIndex]) postingIndex++;
+			else
+			{
+				candidateList[matchNum++] = candidateList[candidateIndex];
+				candidateIndex++;
+				postingIndex++;
+			}
+		}
+		candidateNum = matchNum;
+	}
+
+	long long candidateIndex = 0;
+	while((result == True) && (query->isStopped == False) && (candidateIndex < candidateNum))
+	{
+		long long firstBlock = (long long)candidateList[candidateIndex];
+		long long lastBlock = firstBlock;
+		candidateIndex++;
+		while((candidateIndex < candidateNum) && ((long long)candidateList[candidateIndex] == lastBlock + 1))
+		{
+			lastBlock++;
+			candidateIndex++;
+		}
+
+		off_t start = (off_t)entry->blockOffsetList[firstBlock];
+		off_t end = (off_t)((lastBlock + 1 < entry->blockNum) ? entry->blockOffsetList[lastBlock + 1] : entry->contentSize);
+		result = JFileQueryRange(file, fd, query, start, end, firstBlock * INDEX_BLOCK_LINES);
+	}
+
+	if(candidateList != NULL) free(candidateList);
+	if(postingList != NULL) free(postingList);
+	if(fd != -1) close(fd);
+	return result;
+}
+
+/*
+ * @fn static void JFileDataListFree(JFilePtr file)
+ * @brief 파일 관리 구조체에 저장된 파일 내용과 문자열 배열을 모두 해제하는 함수
+ * 라인 수가 바뀌기 전에 호출해야 한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFileDataListFree(JFilePtr file)
+{
+	if(file->dataList == NULL) return;
+	JFileDataListClear(file);
+	free(file->dataList);
+	file->dataList = NULL;
+}
+
+/*
+ * @fn static void JFileClearLineIndex(JFilePtr file)
+ * @brief 라인 위치 색인을 모두 해제하는 함수
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFileClearLineIndex(JFilePtr file)
+{
+	if(file->lineIndex != NULL)
+	{
+		free(file->lineIndex);
+		file->lineIndex = NULL;
+	}
+	file->lineIndexSize = 0;
+}
+
+/*
+ * @fn static Bool JFileAddLineMark(JFilePtr file, long long line, long long offset)
+ * @brief 라인 위치 색인 끝에 라인 번호와 시작 위치를 추가하는 함수
+ * 색인은 라인 번호 순서로 추가해야 하며, 배열은 개수가 2 의 거듭제곱이 될 때마다 두 배로 늘린다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param line 라인 번호(입력)
+ * @param offset 라인이 시작하는 위치(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileAddLineMark(JFilePtr file, long long line, long long offset)
+{
+	long long size = file->lineIndexSize;
+	if((size == 0) || ((size & (size - 1)) == 0))
+	{
+		long long capacity = (size == 0) ? 16 : size * 2;
+		JFileLineMarkPtr newIndex = (JFileLineMarkPtr)realloc(file->lineIndex, sizeof(JFileLineMark) * (size_t)capacity);
+		if(newIndex == NULL) return False;
+		file->lineIndex = newIndex;
+	}
+
+	file->lineIndex[size].line = line;
+	file->lineIndex[size].offset = offset;
+	file->lineIndexSize = size + 1;
+	return True;
+}
+
+/*
+ * @fn static Bool JFileSetLineIndex(JFilePtr file, const JFileLineMarkPtr markList, long long markCount)
+ * @brief 라인 위치 색인을 전달받은 목록으로 바꾸는 함수
+ * JFileAddLineMark 로 이어서 추가할 수 있도록 배열 크기는 16 이상의 2 의 거듭제곱으로 맞춘다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param markList 라인 번호 순서로 정렬된 색인 목록(입력, 읽기 전용)
+ * @param markCount 색인 개수(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileSetLineIndex(JFilePtr file, const JFileLineMarkPtr markList, long long markCount)
+{
+	JFileClearLineIndex(file);
+	if(markCount <= 0) return True;
+
+	long long capacity = 16;
+	while(capacity < markCount) capacity *= 2;
+
+	file->lineIndex = (JFileLineMarkPtr)malloc(sizeof(JFileLineMark) * (size_t)capacity);
+	if(file->lineIndex == NULL) return False;
+	memcpy(file->lineIndex, markList, sizeof(JFileLineMark) * (size_t)markCount);
+	file->lineIndexSize = markCount;
+	return True;
+}
+
+/*
+ * @fn static JFileLineMarkPtr JFileFindLineMark(const JFilePtr file, long long line)
+ * @brief 지정한 라인 번호보다 작거나 같은 라인 번호 중 가장 큰 색인 항목을 찾는 함수
+ * @param file 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @param line 찾을 라인 번호(입력)
+ * @return 성공 시 색인 항목의 주소, 없으면 NULL 반환(첫 라인부터 찾아야 함)
+ */
+static JFileLineMarkPtr JFileFindLineMark(const JFilePtr file, long long line)
+{
+	long long low = 0;
+	long long high = file->lineIndexSize - 1;
+	JFileLineMarkPtr mark = NULL;
+
+	while(low <= high)
+	{
+		long long mid = low + (high - low) / 2;
+		if(file->lineIndex[mid].line <= line)
+		{
+			mark = &(file->lineIndex[mid]);
+			low = mid + 1;
+		}
+		else high = mid - 1;
+	}
+
+	return mark;
+}
+
+/*
+ * @fn static void JFileClearCompress(JFilePtr file)
+ * @brief 블록 압축 저장 정보를 해제하는 함수
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFileClearCompress(JFilePtr file)
+{
+	if(file->compress == NULL) return;
+	if(file->compress->blockList != NULL) free(file->compress->blockList);
+	if(file->compress->cacheBuf != NULL) free(file->compress->cacheBuf);
+	if(file->compress->physBuf != NULL) free(file->compress->physBuf);
+	free(file->compress);
+	file->compress = NULL;
+}
+
+/*
+ * @fn static Bool JFileLoadCompress(JFilePtr file)
+ * @brief 지정한 파일이 블록 압축 형식이면 헤더와 블록 색인을 읽어서 저장하는 함수
+ * 라인 수와 전체 문자 개수는 헤더에 저장된 값을 사용하고, 라인 처음에서 시작하는 블록마다 라인 위치 색인을 추가한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 블록 압축 파일이면 True, 아니면 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileLoadCompress(JFilePtr file)
+{
+	if(((file->stat.st_mode & S_IFMT) != S_IFREG) || (file->stat.st_size < (off_t)sizeof(CompressHeader))) return False;
+
+	int fd = open(file->path, O_RDONLY);
+	if(fd == -1) return False;
+
+	CompressHeader header;
+	if((_ReadFull(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+		|| (memcmp(header.magic, COMPRESS_MAGIC, sizeof(header.magic)) != 0)
+		|| (header.version != COMPRESS_VERSION)
+		|| (header.blockCount < 0)
+		|| (header.indexOffset < (long long)sizeof(header))
+		|| (header.indexOffset + header.blockCount * (long long)sizeof(JFileBlock) > (long long)file->stat.st_size))
+	{
+		close(fd);
+		return False;
+	}
+
+	struct _jfile_compress_t *compress = (struct _jfile_compress_t*)malloc(sizeof(struct _jfile_compress_t));
+	if(compress == NULL)
+	{
+		close(fd);
+		return False;
+	}
+	compress->header = header;
+	compress->cacheBlock = -1;
+	compress->cacheBuf = NULL;
+	compress->physBuf = NULL;
+	compress->blockList = (JFileBlockPtr)malloc(sizeof(JFileBlock) * (size_t)(header.blockCount + 1));
+
+	size_t indexSize = sizeof(JFileBlock) * (size_t)header.blockCount;
+	if((compress->blockList == NULL) || (_ReadFull(fd, compress->blockList, indexSize, (off_t)header.indexOffset) != (ssize_t)indexSize))
+	{
+		if(compress->blockList != NULL) free(compress->blockList);
+		free(compress);
+		close(fd);
+		return False;
+	}
+	close(fd);
+
+	file->compress = compress;
+	file->line = header.line;
+	file->totalCharCount = header.totalCharCount;
+
+	long long blockIndex = 1;
+	for( ; blockIndex < header.blockCount; blockIndex++)
+	{
+		JFileBlockPtr block = &(compress->blockList[blockIndex]);
+		if(block->flags & COMPRESS_BLOCK_LINE_START) JFileAddLineMark(file, block->firstLine, block->logicalOffset);
+	}
+
+	return True;
+}
+
+/*
+ * @fn static long long JFileFindBlock(const JFilePtr file, long long offset)
+ * @brief 지정한 논리 위치를 포함하는 압축 블록 번호를 찾는 함수
+ * @param file 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @param offset 찾을 논리 위치(입력)
+ * @return 성공 시 블록 번호, 실패 시 -1 반환
+ */
+static long long JFileFindBlock(const JFilePtr file, long long offset)
+{
+	long long low = 0;
+	long long high = file->compress->header.blockCount - 1;
+
+	while(low <= high)
+	{
+		long long mid = low + (high - low) / 2;
+		JFileBlockPtr block = &(file->compress->blockList[mid]);
+		if(offset < block->logicalOffset) high = mid - 1;
+		else if(offset >= block->logicalOffset + (long long)block->logicalLength) low = mid + 1;
+		else return mid;
+	}
+
+	return -1;
+}
+
+/*
+ * @fn static char* JFileReadBlock(JFilePtr file, int fd, long long blockIndex)
+ * @brief 지정한 압축 블록을 읽어서 압축 해제한 내용을 반환하는 함수
+ * 마지막으로 압축 해제한 블록은 저장해 두므로 같은 블록을 연속으로 읽으면 다시 압축 해제하지 않는다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param fd 압축 파일 디스크립터(입력)
+ * @param blockIndex 읽을 블록 번호(입력)
+ * @return 성공 시 압축 해제된 블록 내용, 실패 시 NULL 반환
+ */
+static char* JFileReadBlock(JFilePtr file, int fd, long long blockIndex)
+{
+	struct _jfile_compress_t *compress = file->compress;
+	if((blockIndex < 0) || (blockIndex >= compress->header.blockCount)) return NULL;
+	if(compress->cacheBlock == blockIndex) return compress->cacheBuf;
+
+	size_t blockSize = compress->header.blockSize;
+	if(compress->cacheBuf == NULL)
+	{
+		compress->cacheBuf = (char*)malloc(blockSize);
+		if(compress->cacheBuf == NULL) return NULL;
+	}
+	if(compress->physBuf == NULL)
+	{
+		compress->physBuf = (char*)malloc(_LZCompressBound(blockSize));
+		if(compress->physBuf == NULL) return NULL;
+	}
+
+	JFileBlockPtr block = &(compress->blockList[blockIndex]);
+	if((block->logicalLength > blockSize) || (block->physLength > _LZCompressBound(blockSize))) return NULL;
+
+	compress->cacheBlock = -1;
+	if(block->flags & COMPRESS_BLOCK_RAW)
+	{
+		if(_ReadFull(fd, compress->cacheBuf, block->physLength, (off_t)block->physOffset) != (ssize_t)block->physLength) return NULL;
+	}
+	else
+	{
+		if(_ReadFull(fd, compress->physBuf, block->physLength, (off_t)block->physOffset) != (ssize_t)block->physLength) return NULL;
+		if(_LZDecompress(compress->physBuf, block->physLength, compress->cacheBuf, blockSize) != (ssize_t)block->logicalLength) return NULL;
+	}
+
+	compress->cacheBlock = blockIndex;
+	return compress->cacheBuf;
+}
+
+/*
+ * @fn static ssize_t JFileReadAt(JFilePtr file, int fd, char *buf, size_t length, off_t offset)
+ * @brief 지정한 논리 위치에서 지정한 길이만큼 파일 내용을 읽는 함수
+ * 압축 파일이면 필요한 블록만 압축 해제해서 읽고, 묶음 파일의 항목이면 매핑된 묶음 파일에서 바로 복사한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 사용하지 않음)
+ * @param buf 읽은 내용을 저장할 버퍼(출력)
+ * @param length 읽을 길이(입력)
+ * @param offset 읽기 시작할 논리 위치(입력)
+ * @return 성공 시 읽은 길이(파일 끝이면 0), 실패 시 -1 반환
+ */
+static ssize_t JFileReadAt(JFilePtr file, int fd, char *buf, size_t length, off_t offset)
+{
+	if(file->pack != NULL)
+	{
+		PackEntryPtr entry = &(file->pack->entryList[file->packIndex]);
+		if((long long)offset >= entry->length) return 0;
+		if((long long)length > entry->length - (long long)offset) length = (size_t)(entry->length - (long long)offset);
+		memcpy(buf, file->pack->map + entry->offset + offset, length);
+		return (ssize_t)length;
+	}
+	if(file->compress == NULL) return _ReadFull(fd, buf, length, offset);
+
+	size_t readSize = 0;
+	while((readSize < length) && ((long long)offset < file->compress->header.logicalSize))
+	{
+		long long blockIndex = JFileFindBlock(file, (long long)offset);
+		char *data = JFileReadBlock(file, fd, blockIndex);
+		if(data == NULL) return -1;
+
+		JFileBlockPtr block = &(file->compress->blockList[blockIndex]);
+		size_t blockOffset = (size_t)((long long)offset - block->logicalOffset);
+		size_t copySize = block->logicalLength - blockOffset;
+		if(copySize > length - readSize) copySize = length - readSize;
+
+		memcpy(buf + readSize, data + blockOffset, copySize);
+		readSize += copySize;
+		offset += (off_t)copySize;
+	}
+
+	return (ssize_t)readSize;
+}
+
+/*
+ * @fn static off_t JFileFindLineOffset(JFilePtr file, int fd, char *buf, long long lineNumber)
+ * @brief 지정한 라인이 시작하는 위치를 찾는 함수
+ * 라인 위치 색인에서 가장 가까운 앞 라인의 위치를 찾고, 그 위치부터 개행 문자를 세면서 건너뛴다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 -1)
+ * @param buf 읽기에 사용할 버퍼(출력, READ_BUF_SIZE 크기)
+ * @param lineNumber 찾을 라인 번호(입력, 0 부터 시작)
+ * @return 성공 시 라인 시작 위치, 실패 시 -1 반환
+ */
+static off_t JFileFindLineOffset(JFilePtr file, int fd, char *buf, long long lineNumber)
+{
+	JFileLineMarkPtr mark = JFileFindLineMark(file, lineNumber);
+	off_t offset = (mark == NULL) ? 0 : (off_t)mark->offset;
+	long long skipCount = lineNumber - ((mark == NULL) ? 0 : mark->line);
+
+	while(skipCount > 0)
+	{
+		ssize_t readSize = JFileReadAt(file, fd, buf, READ_BUF_SIZE, offset);
+		if(readSize <= 0) return -1;
+
+		char *s = buf;
+		char *newline = NULL;
+		while((skipCount > 0) && ((newline = (char*)memchr(s, '\n', (size_t)(buf + readSize - s))) != NULL))
+		{
+			skipCount--;
+			s = newline + 1;
+		}
+		offset += (skipCount == 0) ? (off_t)(s - buf) : (off_t)readSize;
+	}
+
+	return offset;
+}
+
+/*
+ * @fn static char* JFileReadLine(JFilePtr file, long long lineNumber)
+ * @brief 지정한 라인 하나만 읽어서 반환하는 함수
+ * 라인 위치 색인에서 가장 가까운 앞 라인의 위치를 찾아서 그 위치부터 읽으므로 파일 전체를 읽지 않는다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param lineNumber 읽을 라인 번호(입력, 0 부터 시작)
+ * @return 성공 시 라인 문자열(개행 문자 포함, 호출자가 해제), 실패 시 NULL 반환
+ */
+static char* JFileReadLine(JFilePtr file, long long lineNumber)
+{
+	if((file == NULL) || (lineNumber < 0) || (lineNumber >= file->line)) return NULL;
+
+	// 묶음 파일의 항목은 매핑된 묶음 파일에서 읽으므로 파일을 열지 않는다.
+	int fd = -1;
+	if((file->pack == NULL) && ((fd = open(file->path, O_RDONLY)) == -1)) return NULL;
+	if(fd != -1) _AdviseAccess(fd, 0, 0, file->accessPolicy);
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL)
+	{
+		if(fd != -1) close(fd);
+		return NULL;
+	}
+
+	off_t offset = JFileFindLineOffset(file, fd, buf, lineNumber);
+
+	char *line = NULL;
+	size_t lineLength = 0;
+	while(offset >= 0)
+	{
+		ssize_t readSize = JFileReadAt(file, fd, buf, READ_BUF_SIZE, offset);
+		if(readSize <= 0) break;
+
+		char *newline = (char*)memchr(buf, '\n', (size_t)readSize);
+		size_t copySize = (newline == NULL) ? (size_t)readSize : (size_t)(newline - buf) + 1;
+
+		char *newLine = (char*)realloc(line, lineLength + copySize + 1);
+		if(newLine == NULL)
+		{
+			free(line);
+			line = NULL;
+			break;
+		}
+		line = newLine;
+		memcpy(line + lineLength, buf, copySize);
+		lineLength += copySize;
+		line[lineLength] = '\0';
+
+		if(newline != NULL) break;
+		offset += readSize;
+	}
+
+	free(buf);
+	if(fd != -1) close(fd);
+	return line;
+}
+
+/*
+ * @fn static char** JFileReadLines(JFilePtr file)
+ * @brief JFileReadAt 으로 파일 전체 내용을 읽어서 라인 단위로 나눠 파일 관리 구조체에 저장하는 함수
+ * 블록 압축 파일과 묶음 파일의 항목처럼 파일 경로를 그대로 읽을 수 없는 파일에 사용한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 성공 시 저장된 파일 내용, 실패 시 NULL 반환
+ */
+static char** JFileReadLines(JFilePtr file)
+{
+	if(JFileNewDataList(file) == NULL) return NULL;
+
+	int fd = -1;
+	if((file->pack == NULL) && ((fd = open(file->path, O_RDONLY)) == -1)) return NULL;
+	if(fd != -1) _AdviseAccess(fd, 0, 0, file->accessPolicy);
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL)
+	{
+		if(fd != -1) close(fd);
+		return NULL;
+	}
+
+	char *pending = NULL;
+	size_t pendingLength = 0;
+	long long lineIndex = 0;
+	off_t offset = 0;
+	Bool isFailed = False;
+
+	while(isFailed == False)
+	{
+		ssize_t readSize = JFileReadAt(file, fd, buf, READ_BUF_SIZE, offset);
+		if(readSize < 0) isFailed = True;
+		if(readSize <= 0) break;
+		offset += readSize;
+
+		char *s = buf;
+		char *end = buf + readSize;
+		while(s < end)
+		{
+			char *newline = (char*)memchr(s, '\n', (size_t)(end - s));
+			char *lineEnd = (newline == NULL) ? end : newline + 1;
+
+			// 읽기 단위 경계에 걸친 라인은 이어 붙인다.
+			char *newPending = (char*)realloc(pending, pendingLength + (size_t)(lineEnd - s) + 1);
+			if(newPending == NULL)
+			{
+				isFailed = True;
+				break;
+			}
+			pending = newPending;
+			memcpy(pending + pendingLength, s, (size_t)(lineEnd - s));
+			pendingLength += (size_t)(lineEnd - s);
+			pending[pendingLength] = '\0';
+			s = lineEnd;
+
+			if((newline != NULL) && (lineIndex < file->line))
+			{
+				file->dataList[lineIndex++] = pending;
+				pending = NULL;
+				pendingLength = 0;
+			}
+		}
+	}
+
+	if(pending != NULL)
+	{
+		if((isFailed == False) && (lineIndex < file->line)) file->dataList[lineIndex++] = pending;
+		else free(pending);
+	}
+
+	if((fd != -1) && (file->accessPolicy == JFMAccessOnce)) _DropCache(fd, 0, 0, False);
+	free(buf);
+	if(fd != -1) close(fd);
+	if(isFailed == True)
+	{
+		JFileDataListClear(file);
+		return NULL;
+	}
+	return file->dataList;
+}
+
+/*
+ * @fn static JFilePtr JFileCompress(JFilePtr file)
+ * @brief 지정한 파일을 블록 압축 형식으로 변환하는 함수
+ * 파일을 최대 COMPRESS_BLOCK_SIZE 크기의 블록으로 나누되 가능하면 라인 경계에서 자르고, 블록마다 따로 압축한다.
+ * 같은 디렉터리의 임시 파일에 [헤더][블록...][블록 색인] 순서로 저장한 후 원래 파일과 교체한다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileCompress(JFilePtr file)
+{
+	if(file->compress != NULL) return file;
+	if((file->pack != NULL) || ((file->stat.st_mode & S_IFMT) != S_IFREG)) return NULL;
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmz.%ld", file->path, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+
+	int srcFd = open(file->path, O_RDONLY);
+	if(srcFd == -1) return NULL;
+	int destFd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, file->stat.st_mode & 07777);
+	if(destFd == -1)
+	{
+		close(srcFd);
+		return NULL;
+	}
+
+	char *inBuf = (char*)malloc(COMPRESS_BLOCK_SIZE);
+	char *outBuf = (char*)malloc(_LZCompressBound(COMPRESS_BLOCK_SIZE));
+	JFileBlockPtr blockList = NULL;
+	long long blockCount = 0;
+	long long readOffset = 0;
+	long long physOffset = (long long)sizeof(CompressHeader);
+	long long logicalOffset = 0;
+	long long newlineCount = 0;
+	size_t carrySize = 0;
+	Bool isLineStart = True;
+	Bool isFailed = ((inBuf == NULL) || (outBuf == NULL)) ? True : False;
+
+	while(isFailed == False)
+	{
+		ssize_t readSize = _ReadFull(srcFd, inBuf + carrySize, COMPRESS_BLOCK_SIZE - carrySize, (off_t)readOffset);
+		if(readSize < 0)
+		{
+			isFailed = True;
+			break;
+		}
+		readOffset += readSize;
+
+		size_t filledSize = carrySize + (size_t)readSize;
+		if(filledSize == 0) break;
+		Bool isEnd = (filledSize < COMPRESS_BLOCK_SIZE) ? True : False;
+
+		// 파일 끝이 아니면 마지막 개행 문자 뒤에서 잘라서 블록이 라인 경계에서 끝나게 한다.
+		size_t blockLength = filledSize;
+		if(isEnd == False)
+		{
+			char *lastNewline = (char*)memrchr(inBuf, '\n', filledSize);
+			if(lastNewline != NULL) blockLength = (size_t)(lastNewline - inBuf) + 1;
+		}
+
+		long long blockNewlineCount = 0;
+		char *s = inBuf;
+		char *newline = NULL;
+		while((newline = (char*)memchr(s, '\n', (size_t)(inBuf + blockLength - s))) != NULL)
+		{
+			blockNewlineCount++;
+			s = newline + 1;
+		}
+
+		if((blockCount & (blockCount - 1)) == 0)
+		{
+			JFileBlockPtr newBlockList = (JFileBlockPtr)realloc(blockList, sizeof(JFileBlock) * (size_t)((blockCount == 0) ? 16 : blockCount * 2));
+			if(newBlockList == NULL)
+			{
+				isFailed = True;
+				break;
+			}
+			blockList = newBlockList;
+		}
+
+		JFileBlockPtr block = &(blockList[blockCount]);
+		size_t physLength = _LZCompress(inBuf, blockLength, outBuf, _LZCompressBound(COMPRESS_BLOCK_SIZE));
+		block->flags = (isLineStart == True) ? COMPRESS_BLOCK_LINE_START : 0;
+		// 압축해도 줄어들지 않으면 그대로 저장한다.
+		if((physLength == 0) || (physLength >= blockLength))
+		{
+			block->flags |= COMPRESS_BLOCK_RAW;
+			physLength = blockLength;
+		}
+		block->physOffset = physOffset;
+		block->physLength = (unsigned int)physLength;
+		block->logicalOffset = logicalOffset;
+		block->logicalLength = (unsigned int)blockLength;
+		block->firstLine = newlineCount;
+		block->reserved = 0;
+
+		const char *data = (block->flags & COMPRESS_BLOCK_RAW) ? inBuf : outBuf;
+		if(_WriteFull(destFd, data, physLength, (off_t)physOffset) != (ssize_t)physLength)
+		{
+			isFailed = True;
+			break;
+		}
+
+		blockCount++;
+		isLineStart = (inBuf[blockLength - 1] == '\n') ? True : False;
+		physOffset += (long long)physLength;
+		logicalOffset += (long long)blockLength;
+		newlineCount += blockNewlineCount;
+
+		carrySize = filledSize - blockLength;
+		memmove(inBuf, inBuf + blockLength, carrySize);
+		if((isEnd == True) && (carrySize == 0)) break;
+	}
+
+	if(isFailed == False)
+	{
+		CompressHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, COMPRESS_MAGIC, sizeof(header.magic));
+		header.version = COMPRESS_VERSION;
+		header.blockSize = COMPRESS_BLOCK_SIZE;
+		header.logicalSize = logicalOffset;
+		header.line = newlineCount + (((logicalOffset > 0) && (isLineStart == False)) ? 1 : 0);
+		header.totalCharCount = logicalOffset - newlineCount;
+		header.blockCount = blockCount;
+		header.indexOffset = physOffset;
+
+		size_t indexSize = sizeof(JFileBlock) * (size_t)blockCount;
+		if((blockCount > 0) && (_WriteFull(destFd, blockList, indexSize, (off_t)physOffset) != (ssize_t)indexSize)) isFailed = True;
+		if(_WriteFull(destFd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) isFailed = True;
+	}
+
+	if(inBuf != NULL) free(inBuf);
+	if(outBuf != NULL) free(outBuf);
+	if(blockList != NULL) free(blockList);
+	close(srcFd);
+	if(close(destFd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, file->path) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	return JFileLoad(file);
+}
+
+/*
+ * @fn static JFilePtr JFileDecompress(JFilePtr file)
+ * @brief 블록 압축 파일을 원래의 일반 파일로 복원하는 함수
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileDecompress(JFilePtr file)
+{
+	if(file->compress == NULL) return file;
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmz.%ld", file->path, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+
+	int srcFd = open(file->path, O_RDONLY);
+	if(srcFd == -1) return NULL;
+	int destFd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, file->stat.st_mode & 07777);
+	if(destFd == -1)
+	{
+		close(srcFd);
+		return NULL;
+	}
+
+	Bool isFailed = False;
+	long long blockIndex = 0;
+	for( ; blockIndex < file->compress->header.blockCount; blockIndex++)
+	{
+		JFileBlockPtr block = &(file->compress->blockList[blockIndex]);
+		char *data = JFileReadBlock(file, srcFd, blockIndex);
+		if((data == NULL) || (_WriteFull(destFd, data, block->logicalLength, (off_t)block->logicalOffset) != (ssize_t)block->logicalLength))
+		{
+			isFailed = True;
+			break;
+		}
+	}
+
+	close(srcFd);
+	if(close(destFd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, file->path) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	return JFileLoad(file);
+}
+
+/*
+ * @fn static struct _jfile_pack_t* JFilePackOpen(const char *packPath)
+ * @brief 묶음 파일을 열어서 전체를 mmap 으로 매핑하고 헤더와 목차를 검사하는 함수
+ * 반환된 묶음 파일 정보는 참조 개수가 0 이므로, 항목을 만들지 않으면 JFilePackRelease 로 직접 해제해야 한다.
+ * @param packPath 묶음 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 묶음 파일 정보의 주소, 실패 시 NULL 반환
+ */
+static struct _jfile_pack_t* JFilePackOpen(const char *packPath)
+{
+	if(packPath == NULL) return NULL;
+
+	int fd = open(packPath, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	FileStatus packStat;
+	if((fstat(fd, &packStat) == -1) || (packStat.st_size < (off_t)sizeof(PackHeader)))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	char *map = (char*)mmap(NULL, (size_t)packStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if(map == MAP_FAILED)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	long long packSize = (long long)packStat.st_size;
+	PackHeaderPtr header = (PackHeaderPtr)map;
+	Bool isValid = True;
+	if((memcmp(header->magic, PACK_MAGIC, sizeof(header->magic)) != 0)
+		|| (header->version != PACK_VERSION)
+		|| (header->entrySize != sizeof(PackEntry))
+		|| (header->entryCount < 0)
+		|| (header->tocOffset < (long long)sizeof(PackHeader))
+		|| ((header->tocOffset % PACK_ALIGN) != 0)
+		|| (header->entryCount > (packSize - header->tocOffset) / (long long)sizeof(PackEntry))
+		|| (header->stringOffset != header->tocOffset + header->entryCount * (long long)sizeof(PackEntry))
+		|| (header->stringSize < 0)
+		|| (header->stringSize > packSize - header->stringOffset))
+	{
+		isValid = False;
+	}
+
+	// 잘못된 목차로 매핑 밖을 읽지 않도록 모든 항목의 구간을 검사한다.
+	PackEntryPtr entryList = (PackEntryPtr)(map + header->tocOffset);
+	char *stringTable = map + header->stringOffset;
+	long long entryIndex = 0;
+	for( ; (isValid == True) && (entryIndex < header->entryCount); entryIndex++)
+	{
+		PackEntryPtr entry = &(entryList[entryIndex]);
+		if((entry->offset < (long long)sizeof(PackHeader)) || (entry->length < 0)
+			|| (entry->length > header->tocOffset - entry->offset)
+			|| (entry->pathOffset < 0) || ((long long)entry->pathLength >= header->stringSize - entry->pathOffset)
+			|| (stringTable[entry->pathOffset + entry->pathLength] != '\0'))
+		{
+			isValid = False;
+		}
+	}
+
+	struct _jfile_pack_t *pack = NULL;
+	if(isValid == True) pack = (struct _jfile_pack_t*)malloc(sizeof(struct _jfile_pack_t));
+	if(pack == NULL)
+	{
+		munmap(map, (size_t)packStat.st_size);
+		close(fd);
+		return NULL;
+	}
+
+	pack->refCount = 0;
+	pack->fd = fd;
+	pack->map = map;
+	pack->mapSize = (size_t)packStat.st_size;
+	pack->header = header;
+	pack->entryList = entryList;
+	pack->stringTable = stringTable;
+	return pack;
+}
+
+/*
+ * @fn static void JFilePackRelease(struct _jfile_pack_t *pack)
+ * @brief 묶음 파일 참조 개수를 줄이고, 더 이상 참조하는 항목이 없으면 매핑을 해제하고 닫는 함수
+ * @param pack 묶음 파일 정보의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFilePackRelease(struct _jfile_pack_t *pack)
+{
+	if(pack == NULL) return;
+	if(pack->refCount > 0) pack->refCount--;
+	if(pack->refCount > 0) return;
+
+	munmap(pack->map, pack->mapSize);
+	close(pack->fd);
+	free(pack);
+}
+
+/*
+ * @fn static JFilePtr JFileNewFromPack(struct _jfile_pack_t *pack, long long packIndex)
+ * @brief 묶음 파일의 항목을 내용으로 가지는 읽기 전용 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 파일을 열거나 stat 을 호출하지 않고 목차에 저장된 경로, 상태 정보, 라인 수를 그대로 사용한다.
+ * @param pack 묶음 파일 정보의 주소(입력)
+ * @param packIndex 목차 항목 번호(입력)
+ * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFileNewFromPack(struct _jfile_pack_t *pack, long long packIndex)
+{
+	if((pack == NULL) || (packIndex < 0) || (packIndex >= pack->header->entryCount)) return NULL;
+
+	JFilePtr file = (JFilePtr)malloc(sizeof(JFile));
+	if(file == NULL) return NULL;
+
+	PackEntryPtr entry = &(pack->entryList[packIndex]);
+
+	file->name = NULL;
+	file->path = NULL;
+	file->filePointer = NULL;
+	file->dataList = NULL;
+	file->mode = NULL;
+	file->dupleNum = 0;
+	file->line = entry->line;
+	file->totalCharCount = entry->totalCharCount;
+	file->lineIndex = NULL;
+	file->lineIndexSize = 0;
+	file->compress = NULL;
+	file->pack = NULL;
+	file->packIndex = packIndex;
+	file->followOffset = -1;
+	file->followLine = 0;
+	file->accessPolicy = JFMAccessDefault;
+
+	if(JFileSetPath(file, pack->stringTable + entry->pathOffset) == NULL)
+	{
+		JFileDelete(&file);
+		return NULL;
+	}
+
+	memset(&(file->stat), 0, sizeof(file->stat));
+	file->stat.st_mode = (mode_t)entry->mode;
+	file->stat.st_uid = (uid_t)entry->uid;
+	file->stat.st_gid = (gid_t)entry->gid;
+	file->stat.st_nlink = 1;
+	file->stat.st_size = (off_t)entry->length;
+	file->stat.st_blksize = 4096;
+	file->stat.st_atim.tv_sec = (time_t)entry->atime;
+	file->stat.st_atim.tv_nsec = (long)entry->atimeNsec;
+	file->stat.st_mtim.tv_sec = (time_t)entry->mtime;
+	file->stat.st_mtim.tv_nsec = (long)entry->mtimeNsec;
+	file->stat.st_ctim.tv_sec = (time_t)entry->ctime;
+	file->stat.st_ctim.tv_nsec = (long)entry->ctimeNsec;
+
+	if(JFileGetMode(file) == NULL)
+	{
+		JFileDelete(&file);
+		return NULL;
+	}
+
+	file->pack = pack;
+	pack->refCount++;
+	return file;
+}
+
+/*
+ * @fn static JFilePtr JFileNewFromManifest(const char *path, const ManifestEntryPtr entry, const JFileLineMarkPtr markList)
+ * @brief 파일 목록 저장 파일의 항목으로 파일 정보 관리 구조체 객체를 생성하는 함수
+ * 파일의 크기, 수정 시각, 아이노드, 장치 번호가 저장할 때와 같으면 저장된 라인 수, 문자 개수, 라인 위치 색인을 그대로 사용하고,
+ * 다르면 JFileLoad 로 파일 정보를 다시 수집한다.
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @param entry 파일 목록 항목(입력, 읽기 전용)
+ * @param markList 항목의 라인 위치 색인 배열(입력, 읽기 전용)
+ * @return 성공 시 생성된 객체의 주소, 파일이 없거나 실패 시 NULL 반환
+ */
+static JFilePtr JFileNewFromManifest(const char *path, const ManifestEntryPtr entry, const JFileLineMarkPtr markList)
+{
+	JFilePtr file = (JFilePtr)malloc(sizeof(JFile));
+	if(file == NULL) return NULL;
+
+	file->name = NULL;
+	file->path = NULL;
+	file->filePointer = NULL;
+	file->dataList = NULL;
+	file->mode = NULL;
+	file->dupleNum = entry->dupleNum;
+	file->line = 0;
+	file->totalCharCount = 0;
+	file->lineIndex = NULL;
+	file->lineIndexSize = 0;
+	file->compress = NULL;
+	file->pack = NULL;
+	file->packIndex = -1;
+	file->followOffset = -1;
+	file->followLine = 0;
+	file->accessPolicy = JFMAccessDefault;
+
+	// 저장한 후에 삭제된 파일은 다시 만들지 않는다.
+	if((JFileSetPath(file, path) == NULL) || (stat(file->path, &(file->stat)) < 0))
+	{
+		JFileDelete(&file);
+		return NULL;
+	}
+
+	Bool isChanged = ((entry->flags & MANIFEST_ENTRY_COMPRESSED)
+		|| ((file->stat.st_mode & S_IFMT) != S_IFREG)
+		|| ((long long)file->stat.st_size != entry->size)
+		|| ((long long)file->stat.st_mtim.tv_sec != entry->mtime)
+		|| ((long long)file->stat.st_mtim.tv_nsec != entry->mtimeNsec)
+		|| ((long long)file->stat.st_ino != entry->ino)
+		|| ((long long)file->stat.st_dev != entry->dev)) ? True : False;
+
+	if(isChanged == False)
+	{
+		file->line = entry->line;
+		file->totalCharCount = entry->totalCharCount;
+		if(JFileSetLineIndex(file, markList, entry->markCount) == False)
+		{
+			JFileDelete(&file);
+			return NULL;
+		}
+		if(JFileGetMode(file) == NULL)
+		{
+			JFileDelete(&file);
+			return NULL;
+		}
+	}
+	else if(JFileLoad(file) == NULL)
+	{
+		JFileDelete(&file);
+		return NULL;
+	}
+
+	return file;
+}
+
+/*
+ * @fn static void JFileFollowReset(JFilePtr file)
+ * @brief 따라 읽던 파일이 잘리거나 교체되었을 때 파일 정보를 빈 파일 기준으로 되돌리는 함수
+ * 이후 JFileFollowRead 가 파일 처음부터 다시 읽으면서 라인 수와 문자 개수를 센다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFileFollowReset(JFilePtr file)
+{
+	JFileDataListFree(file);
+	JFileClearLineIndex(file);
+	file->line = 0;
+	file->totalCharCount = 0;
+	file->stat.st_size = 0;
+	file->followOffset = 0;
+	file->followLine = 0;
+}
+
+/*
+ * @fn static int JFileFollowRead(JFilePtr file, int fd, JFMPtr fm, int index, JFMFollowFunc callback)
+ * @brief 마지막으로 전달한 위치부터 파일 끝까지 읽어서 완성된 라인만 콜백으로 전달하고 파일 정보를 갱신하는 함수
+ * 파일 정보(stat.st_size)에 기록된 크기 이후에 추가된 내용만 라인 수, 문자 개수, 라인 위치 색인에 더한다.
+ * 파일이 기록된 크기보다 작아졌으면 잘린 것으로 보고 처음부터 다시 읽는다.
+ * 콜백이 멈추기를 요청하면 더 이상 전달하지 않지만, 읽은 내용은 끝까지 센다.
+ * @param file 파일 정보 관리 구조체의 주소(출력)
+ * @param fd 따라 읽는 파일 디스크립터(입력)
+ * @param fm 콜백에 전달할 파일 관리 구조체의 주소(입력)
+ * @param index 콜백에 전달할 파일 인덱스 번호(입력)
+ * @param callback 라인을 전달받을 콜백 함수(입력)
+ * @return 성공 시 0, 콜백이 멈추기를 요청하면 1, 실패 시 -1 반환
+ */
+static int JFileFollowRead(JFilePtr file, int fd, JFMPtr fm, int index, JFMFollowFunc callback)
+{
+	FileStatus fileStat;
+	if(fstat(fd, &fileStat) == -1) return -1;
+
+	off_t size = fileStat.st_size;
+	off_t countedSize = file->stat.st_size;
+	if(size < countedSize)
+	{
+		JFileFollowReset(file);
+		countedSize = 0;
+	}
+
+	// 기록된 크기까지의 내용이 개행 문자로 끝나지 않으면 마지막 라인은 아직 완성되지 않았다.
+	char lastChar = '\n';
+	if((countedSize > 0) && (_ReadFull(fd, &lastChar, 1, countedSize - 1) != 1)) return -1;
+	long long countedNewline = file->line - ((lastChar != '\n') ? 1 : 0);
+
+	// 처음 따라 읽으면 완성되지 않은 마지막 라인의 처음부터 시작한다.
+	if(file->followOffset < 0)
+	{
+		off_t lineStart = _FindLineStart(fd, countedSize);
+		if(lineStart < 0) return -1;
+		file->followOffset = (long long)lineStart;
+		file->followLine = countedNewline;
+	}
+	if((size == countedSize) && ((off_t)file->followOffset >= size)) return 0;
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL) return -1;
+
+	// 기록된 크기 이후의 내용이 바뀌므로 저장된 파일 내용은 해제한다.
+	if(size > countedSize) JFileDataListFree(file);
+
+	char *pending = NULL;
+	size_t pendingLength = 0;
+	long long newNewline = 0;
+	long long newBytes = 0;
+	off_t offset = (off_t)file->followOffset;
+	int result = 0;
+
+	while(offset < size)
+	{
+		size_t readLength = READ_BUF_SIZE;
+		if(offset + (off_t)readLength > size) readLength = (size_t)(size - offset);
+
+		ssize_t readSize = _ReadFull(fd, buf, readLength, offset);
+		if(readSize < 0) result = -1;
+		if(readSize <= 0) break;
+
+		if(offset + readSize > countedSize) newBytes += (long long)(offset + readSize - ((offset > countedSize) ? offset : countedSize));
+		lastChar = buf[readSize - 1];
+
+		char *s = buf;
+		char *end = buf + readSize;
+		while(s < end)
+		{
+			char *newline = (char*)memchr(s, '\n', (size_t)(end - s));
+			char *lineEnd = (newline == NULL) ? end : newline + 1;
+			off_t lineEndOffset = offset + (off_t)(lineEnd - buf);
+
+			if((newline != NULL) && (lineEndOffset > countedSize))
+			{
+				newNewline++;
+				if(((countedNewline + newNewline) % LINE_INDEX_INTERVAL) == 0)
+				{
+					JFileAddLineMark(file, countedNewline + newNewline, (long long)lineEndOffset);
+				}
+			}
+
+			if(result == 0)
+			{
+				char *newPending = (char*)realloc(pending, pendingLength + (size_t)(lineEnd - s) + 1);
+				if(newPending == NULL)
+				{
+					result = -1;
+				}
+				else
+				{
+					pending = newPending;
+					memcpy(pending + pendingLength, s, (size_t)(lineEnd - s));
+					pendingLength += (size_t)(lineEnd - s);
+					pending[pendingLength] = '\0';
+				}
+			}
+
+			if((newline != NULL) && (result == 0))
+			{
+				if(callback(fm, index, pending, file->followLine) != 0) result = 1;
+				file->followOffset = (long long)lineEndOffset;
+				file->followLine++;
+				pendingLength = 0;
+			}
+			s = lineEnd;
+		}
+
+		offset += readSize;
+	}
+
+	if(pending != NULL) free(pending);
+	free(buf);
+
+	if(offset > countedSize)
+	{
+		file->line = countedNewline + newNewline + ((lastChar != '\n') ? 1 : 0);
+		file->totalCharCount += newBytes - newNewline;
+		file->stat = fileStat;
+		file->stat.st_size = offset;
+		if(JFileGetMode(file) == NULL) result = -1;
+	}
+
+	return result;
+}
+
+/*
+ * @fn static off_t JFileFindTailStart(JFilePtr file, int fd, off_t size, long long n)
+ * @brief 파일 끝에서 n 개 라인이 시작하는 위치를 찾는 함수
+ * 파일 끝에서부터 READ_BUF_SIZE 에 맞춘 구간 단위로 거꾸로 읽으면서 memrchr 로 개행 문자를 찾는다.
+ * 파일이 개행 문자로 끝나면 마지막 개행 문자는 마지막 라인의 끝으로 본다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 사용하지 않음)
+ * @param size 파일의 논리 크기(입력)
+ * @param n 찾을 라인 개수(입력)
+ * @return 성공 시 시작 위치(라인이 n 개보다 적으면 0), 실패 시 -1 반환
+ */
+static off_t JFileFindTailStart(JFilePtr file, int fd, off_t size, long long n)
+{
+	if((size <= 0) || (n <= 0)) return size;
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL) return -1;
+
+	char lastChar = '\0';
+	if(JFileReadAt(file, fd, &lastChar, 1, size - 1) != 1)
+	{
+		free(buf);
+		return -1;
+	}
+
+	off_t end = size - ((lastChar == '\n') ? 1 : 0);
+	off_t tailStart = 0;
+	long long remainNum = n;
+	while((end > 0) && (remainNum > 0))
+	{
+		// 첫 구간 이후에는 블록 경계에서 읽도록 시작 위치를 맞춘다.
+		off_t start = (end - 1) / READ_BUF_SIZE * READ_BUF_SIZE;
+		ssize_t readSize = JFileReadAt(file, fd, buf, (size_t)(end - start), start);
+		if(readSize != (ssize_t)(end - start))
+		{
+			tailStart = -1;
+			break;
+		}
+
+		size_t searchLength = (size_t)readSize;
+		char *newline = NULL;
+		while((remainNum > 0) && ((newline = (char*)memrchr(buf, '\n', searchLength)) != NULL))
+		{
+			remainNum--;
+			searchLength = (size_t)(newline - buf);
+			if(remainNum == 0) tailStart = start + (off_t)(newline - buf) + 1;
+		}
+		end = start;
+	}
+
+	free(buf);
+	return tailStart;
+}
+
+/*
+ * @fn static Bool JFileSplitLines(JFilePtr file, int fd, off_t start, off_t end, JFMLinesPtr out)
+ * @brief 지정한 구간의 내용을 읽어서 라인 단위로 나눠 저장하는 함수
+ * 구간 끝의 라인이 개행 문자로 끝나지 않아도 한 라인으로 저장한다. 첫 라인 번호는 설정하지 않는다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fd 파일 디스크립터(입력, 묶음 파일의 항목이면 사용하지 않음)
+ * @param start 구간 시작 위치(입력, 라인 시작 위치여야 함)
+ * @param end 구간 끝 위치(입력)
+ * @param out 나눈 라인을 저장할 구조체의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFileSplitLines(JFilePtr file, int fd, off_t start, off_t end, JFMLinesPtr out)
+{
+	out->lineList = NULL;
+	out->lineNum = 0;
+	if(end <= start) return True;
+
+	size_t length = (size_t)(end - start);
+	char *buf = (char*)malloc(length);
+	if(buf == NULL) return False;
+	if(JFileReadAt(file, fd, buf, length, start) != (ssize_t)length)
+	{
+		free(buf);
+		return False;
+	}
+
+	long long lineNum = 0;
+	char *s = buf;
+	char *bufEnd = buf + length;
+	char *newline = NULL;
+	while((newline = (char*)memchr(s, '\n', (size_t)(bufEnd - s))) != NULL)
+	{
+		lineNum++;
+		s = newline + 1;
+	}
+	if(s < bufEnd) lineNum++;
+
+	out->lineList = (char**)calloc((size_t)lineNum + 1, sizeof(char*));
+	if(out->lineList == NULL)
+	{
+		free(buf);
+		return False;
+	}
+
+	for(s = buf; s < bufEnd; )
+	{
+		newline = (char*)memchr(s, '\n', (size_t)(bufEnd - s));
+		char *lineEnd = (newline == NULL) ? bufEnd : newline + 1;
+
+		char *line = (char*)malloc((size_t)(lineEnd - s) + 1);
+		if(line == NULL)
+		{
+			free(buf);
+			JFMFreeLines(out);
+			return False;
+		}
+		memcpy(line, s, (size_t)(lineEnd - s));
+		line[lineEnd - s] = '\0';
+		out->lineList[(out->lineNum)++] = line;
+		s = lineEnd;
+	}
+
+	free(buf);
+	return True;
+}
+
+/*
+ * @fn static JFilePtr JFilePrefetch(JFilePtr file)
+ * @brief 지정한 파일의 내용을 페이지 캐시에 미리 읽어 두는 함수
+ * readahead 로 미리 읽기를 요청하고, 지원하지 않는 파일이면 posix_fadvise(POSIX_FADV_WILLNEED)로 요청한다.
+ * 묶음 파일의 항목은 묶음 파일에서 해당 구간만 미리 읽는다.
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @return 성공 시 파일 정보 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFilePtr JFilePrefetch(JFilePtr file)
+{
+	if((file == NULL) || (file->path == NULL)) return NULL;
+
+	if(file->pack != NULL)
+	{
+		PackEntryPtr entry = &(file->pack->entryList[file->packIndex]);
+		if(readahead(file->pack->fd, (off64_t)entry->offset, (size_t)entry->length) == -1)
+		{
+			_AdviseAccess(file->pack->fd, (off_t)entry->offset, (off_t)entry->length, JFMAccessWillNeed);
+		}
+		return file;
+	}
+
+	int fd = open(file->path, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	FileStatus fileStat;
+	if(fstat(fd, &fileStat) == -1)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	if(readahead(fd, 0, (size_t)fileStat.st_size) == -1) _AdviseAccess(fd, 0, 0, JFMAccessWillNeed);
+	close(fd);
+	return file;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Functions for JFileManager
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * @fn JFMPtr JFMNew()
+ * @brief 파일 관리 구조체 객체를 새로 생성하는 함수
+ * @return 성공 시 생성된 객체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMNew()
+{
+	JFMPtr fm = (JFMPtr)malloc(sizeof(JFM));
+	if(fm == NULL) return NULL;
+
+	// 맨 처음에 NULL 을 넣어서 데이터 없음을 체크
+	fm->fileContainer = (JFilePtrContainer)malloc(sizeof(JFilePtr) * 1);
+	if(fm->fileContainer == NULL)
+	{
+		free(fm);
+		return NULL;
+	}
+	fm->fileContainer[0] = NULL;
+
+	fm->size = 1;
+	fm->userData = NULL;
+	fm->writeBack = NULL;
+	fm->contentIndex = NULL;
+	fm->pathIndex = NULL;
+	fm->accessPolicy = JFMAccessDefault;
+
+	return fm;
+}
+
+/*
+ * @fn void JFMDelete(JFMPtrContainer fmContainer)
+ * @brief 파일 관리 구조체 객체를 삭제하는 함수
+ * @param fmContainer 파일 관리 구조체 객체 주소를 저장하는 포인터(입력, 이중 포인터)
+ * @return 반환값 없음
+ */
+void JFMDelete(JFMPtrContainer fmContainer)
+{
+	if((fmContainer == NULL) || (*fmContainer == NULL)) return;
+
+	// 쓰기 대기 내용을 저장한 후 저장 스레드를 멈춘다.
+	if((*fmContainer)->writeBack != NULL)
+	{
+		JFMFlushAll(*fmContainer);
+		JFMWriteBackStop(*fmContainer);
+	}
+
+	JFMIndexFree(*fmContainer);
+	JFMPathIndexFree(*fmContainer);
+
+	if((*fmContainer)->fileContainer != NULL)
+	{
+		int fileIndex = 0;
+		int fmSize = (*fmContainer)->size;
+		for( ; fileIndex < fmSize; fileIndex++)
+		{
+			JFileDelete(&(((*fmContainer)->fileContainer)[fileIndex]));
+		}
 		free((*fmContainer)->fileContainer);
 	}
 
-	free(*fmContainer);
-	*fmContainer = NULL;
+	free(*fmContainer);
+	*fmContainer = NULL;
+}
+
+/*
+ * @fn void* JFMSetUserData(JFMPtr fm, void *userData)
+ * @brief 파일 관리 구조체 객체에 사용자 데이터를 저장하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param userData 저장할 데이터의 주소(입력)
+ * @return 성공 시 저장된 사용자 데이터의 주소, 실패 시 NULL 반환
+ */
+void* JFMSetUserData(JFMPtr fm, void *userData)
+{
+	if((fm == NULL) || (userData == NULL)) return NULL;
+	return fm->userData = userData;
+}
+
+/*
+ * @fn void* JFMGetUserData(const JFMPtr fm)
+ * @brief 파일 관리 구조체 객체에 저장된 사용자 데이터를 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @return 성공 시 저장된 사용자 데이터의 주소, 실패 시 NULL 반환
+ */
+void* JFMGetUserData(const JFMPtr fm)
+{
+	if(fm == NULL) return NULL;
+	return fm->userData;
+}
+
+/*
+ * @fn JFMPtr JFMNewFile(JFMPtr fm, const char *path)
+ * @brief 파일 관리 구조체 객체에 새로운 파일을 추가하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param path 추가할 파일의 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMNewFile(JFMPtr fm, const char *path)
+{
+	if((fm == NULL) || (path == NULL)) return NULL;
+
+	int targetIndex = 0;
+
+	//TODO NULL 인 파일 인덱스 위치를 다 없애고 NULL 이 아닌 파일 정보만 정리해야 한다.
+	
+	if((targetIndex = JFMFindEmptyFileIndex(fm)) == -1)
+	{
+		targetIndex = fm->size;
+	}
+
+	if(fm->fileContainer[targetIndex] == NULL)
+	{
+		// 중복 불허, 같은 파일을 동시에 사용할 수 없음
+		if(fm->size > 1)
+		{
+			if(JFMFindFileByPath(fm, path) != NULL) return NULL;
+		}
+
+		JFilePtr newFile = JFileNew(path, fm->accessPolicy);
+		if(newFile == NULL) return NULL;
+
+		if(targetIndex == (fm->size - 1))
+		{
+			JFilePtrContainer newContainer = (JFilePtrContainer)realloc(fm->fileContainer, sizeof(JFilePtr) * (fm->size + 1));
+			if(newContainer == NULL)
+			{
+				JFileDelete(&newFile);
+				return NULL;
+			}
+			(fm->size)++;
+			newContainer[targetIndex] = newFile;
+			newContainer[targetIndex + 1] = NULL;
+			fm->fileContainer = newContainer;
+		}
+		else fm->fileContainer[targetIndex] = newFile;
+
+		JFMPathIndexAdd(fm, newFile, targetIndex);
+		return fm;
+	}
+
+	return NULL;
+}
+
+/*
+ * @fn JFMPtr JFMDeleteFile(JFMPtr fm, int index)
+ * @brief 파일 관리 구조체 객체에 저장된 파일을 삭제하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 삭제할 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMDeleteFile(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (fm->fileContainer == NULL) || (fm->size <= 1) || (JFMCheckIndex(fm, index) == False)) return NULL;
+
+	if((fm->fileContainer)[index] != NULL)
+	{
+		// 삭제할 파일의 쓰기 대기 내용은 저장하지 않고 버린다.
+		if(fm->writeBack != NULL) JFMWriteBackDiscard(fm->writeBack, JFMGetFile(fm, index));
+		if(fm->contentIndex != NULL) JFMIndexRemove(fm->contentIndex, JFMGetFile(fm, index));
+		JFMPathIndexRemove(fm, JFMGetFile(fm, index));
+		// 묶음 파일의 항목은 관리 목록에서만 제외한다.
+		if(JFMGetFile(fm, index)->pack == NULL) JFileRemove(JFMGetFile(fm, index));
+		JFileDelete(&(fm->fileContainer[index]));
+		fm->fileContainer[index] = NULL;
+	}
+	else return NULL;
+
+	// 관리 배열 크기는 맨 끝의 NULL 을 포함하므로, 뒤에 있는 파일의 인덱스가 바뀌지 않도록 끝에 남은 빈 자리만 줄인다.
+	while((fm->size > 1) && (fm->fileContainer[fm->size - 2] == NULL)) (fm->size)--;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMDeleteFile(JFMPtr fm, int index)
+ * @brief 파일 관리 구조체 객체에 저장된 파일을 모두 삭제하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+void JFMDeleteAllFiles(JFMPtr fm)
+{
+	if(fm == NULL) return;
+
+	if(fm->fileContainer != NULL)
+	{
+		int fileIndex = 0;
+		for( ; fileIndex <= fm->size; fileIndex++)
+		{
+			JFMDeleteFile(fm, fileIndex);
+		}
+
+		free(fm->fileContainer);
+	}
+	JFMPathIndexFree(fm);
+}
+
+/*
+ * @fn char* JFMGetFileName(const JFMPtr fm, int index)
+ * @brief 지정한 파일의 이름을 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 이름, 실패 시 NULL 반환
+ */
+char* JFMGetFileName(const JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	return JFileGetName(JFMGetFile(fm, index));
+}
+
+/*
+ * @fn char* JFMGetFilePath(const JFMPtr fm, int index)
+ * @brief 지정한 파일의 경로를 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 경로, 실패 시 NULL 반환
+ */
+char* JFMGetFilePath(const JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	return JFileGetPath(JFMGetFile(fm, index));
+}
+
+/*
+ * @fn long long JFMGetFileSize(const JFMPtr fm, int index)
+ * @brief 지정한 파일의 크기를 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 크기, 실패 시 -1 반환
+ */
+long long JFMGetFileSize(const JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return -1;
+	if(JFMFlush(fm, index) == NULL) return -1;
+	return JFileGetSize(JFMGetFile(fm, index));
+}
+
+/*
+ * @fn JFMPtr JFMEnableWriteBack(JFMPtr fm, const JFMWriteBackOptionPtr option)
+ * @brief 쓰기 지연(write-back)을 사용하도록 설정하는 함수
+ * 사용하는 동안 JFMWriteFile 의 "w", "a" 모드 쓰기는 파일별 버퍼에 복사만 하고 바로 반환한다.
+ * 백그라운드 저장 스레드가 파일별 대기 크기, 대기 시간, 전체 대기 크기 조건에 따라 버퍼 내용을 파일에 저장한다.
+ * 파일을 읽거나 바꾸는 다른 함수는 그 파일의 대기 내용을 먼저 저장하므로 항상 쓴 내용을 본다.
+ * JFMGetFile 로 파일 정보를 직접 볼 때는 JFMFlush 를 먼저 호출해야 한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param option 저장 조건(입력, 읽기 전용, NULL 이면 기본값 사용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환(이미 사용 중이면 실패)
+ */
+JFMPtr JFMEnableWriteBack(JFMPtr fm, const JFMWriteBackOptionPtr option)
+{
+	if((fm == NULL) || (fm->writeBack != NULL)) return NULL;
+
+	struct _jfm_write_back_t *writeBack = (struct _jfm_write_back_t*)malloc(sizeof(struct _jfm_write_back_t));
+	if(writeBack == NULL) return NULL;
+
+	writeBack->option.maxFileDirtySize = ((option != NULL) && (option->maxFileDirtySize > 0)) ? option->maxFileDirtySize : WRITE_BACK_FILE_SIZE;
+	writeBack->option.maxDirtyAge = ((option != NULL) && (option->maxDirtyAge > 0)) ? option->maxDirtyAge : WRITE_BACK_AGE;
+	writeBack->option.maxTotalDirtySize = ((option != NULL) && (option->maxTotalDirtySize > 0)) ? option->maxTotalDirtySize : WRITE_BACK_TOTAL_SIZE;
+	writeBack->dirtyList = NULL;
+	writeBack->dirtyNum = 0;
+	writeBack->dirtyCapacity = 0;
+	writeBack->totalDirtySize = 0;
+	writeBack->isStopping = False;
+
+	// 대기 시간은 시스템 시간 변경에 영향을 받지 않도록 CLOCK_MONOTONIC 으로 잰다.
+	pthread_condattr_t condAttr;
+	pthread_condattr_init(&condAttr);
+	pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+	pthread_mutex_init(&(writeBack->mutex), NULL);
+	pthread_cond_init(&(writeBack->wakeCond), &condAttr);
+	pthread_cond_init(&(writeBack->flushedCond), NULL);
+	pthread_condattr_destroy(&condAttr);
+
+	if(pthread_create(&(writeBack->thread), NULL, JFMWriteBackWorker, writeBack) != 0)
+	{
+		pthread_cond_destroy(&(writeBack->flushedCond));
+		pthread_cond_destroy(&(writeBack->wakeCond));
+		pthread_mutex_destroy(&(writeBack->mutex));
+		free(writeBack);
+		return NULL;
+	}
+
+	fm->writeBack = writeBack;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMDisableWriteBack(JFMPtr fm)
+ * @brief 쓰기 대기 내용을 모두 저장하고 쓰기 지연 사용을 해제하는 함수
+ * 저장하지 못한 내용이 있으면 잃지 않도록 해제하지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMDisableWriteBack(JFMPtr fm)
+{
+	if(fm == NULL) return NULL;
+	if(fm->writeBack == NULL) return fm;
+	if(JFMFlushAll(fm) == NULL) return NULL;
+
+	JFMWriteBackStop(fm);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMFlush(JFMPtr fm, int index)
+ * @brief 지정한 파일의 쓰기 대기 내용을 파일에 저장하는 함수
+ * 백그라운드 저장 스레드가 같은 파일을 저장하는 중이면 끝날 때까지 기다린 후 남은 내용을 저장한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMFlush(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(fm->writeBack == NULL) return fm;
+
+	pthread_mutex_lock(&(fm->writeBack->mutex));
+	Bool result = JFMWriteBackFlushFile(fm->writeBack, JFMGetFile(fm, index));
+	pthread_mutex_unlock(&(fm->writeBack->mutex));
+	return (result == True) ? fm : NULL;
+}
+
+/*
+ * @fn JFMPtr JFMFlushAll(JFMPtr fm)
+ * @brief 모든 파일의 쓰기 대기 내용을 파일에 저장하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 하나라도 저장하지 못하면 NULL 반환
+ */
+JFMPtr JFMFlushAll(JFMPtr fm)
+{
+	if(fm == NULL) return NULL;
+	if(fm->writeBack == NULL) return fm;
+
+	struct _jfm_write_back_t *writeBack = fm->writeBack;
+	Bool result = True;
+
+	pthread_mutex_lock(&(writeBack->mutex));
+	long long dirtyIndex = 0;
+	while(dirtyIndex < writeBack->dirtyNum)
+	{
+		JFilePtr file = writeBack->dirtyList[dirtyIndex].file;
+		if(JFMWriteBackFlushFile(writeBack, file) == False) result = False;
+		// 저장한 파일은 목록에서 빠지므로, 같은 위치에 남아 있을 때(실패했거나 그 사이에 다시 쓴 경우)만 다음으로 넘어간다.
+		if(JFMWriteBackFind(writeBack, file) == dirtyIndex) dirtyIndex++;
+	}
+	pthread_mutex_unlock(&(writeBack->mutex));
+
+	return (result == True) ? fm : NULL;
+}
+
+/*
+ * @fn JFMPtr JFMSetAccessPolicy(JFMPtr fm, JFMAccessPolicy policy)
+ * @brief 관리 중인 모든 파일과 이후 추가하는 파일의 접근 방식을 설정하는 함수
+ * 전체 읽기, 라인 읽기, 라인 수 세기, 복사할 때 posix_fadvise 로 커널의 미리 읽기 동작을 조정한다.
+ * JFMAccessOnce 는 전체 읽기와 복사가 끝나면 사용한 페이지 캐시를 비워서 자주 쓰는 파일의 캐시를 보존한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param policy 파일 접근 방식(입력, JFMAccessPolicy 열거형 참고)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSetAccessPolicy(JFMPtr fm, JFMAccessPolicy policy)
+{
+	if((fm == NULL) || (policy < JFMAccessDefault) || (policy > JFMAccessWillNeed)) return NULL;
+
+	fm->accessPolicy = policy;
+
+	int fileIndex = 0;
+	for( ; fileIndex < fm->size; fileIndex++)
+	{
+		if(fm->fileContainer[fileIndex] != NULL) fm->fileContainer[fileIndex]->accessPolicy = policy;
+	}
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMSetFileAccessPolicy(JFMPtr fm, int index, JFMAccessPolicy policy)
+ * @brief 지정한 파일의 접근 방식을 설정하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param policy 파일 접근 방식(입력, JFMAccessPolicy 열거형 참고)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSetFileAccessPolicy(JFMPtr fm, int index, JFMAccessPolicy policy)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if((policy < JFMAccessDefault) || (policy > JFMAccessWillNeed)) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+	file->accessPolicy = policy;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMPrefetch(JFMPtr fm, const int indices[], int n)
+ * @brief 지정한 파일들의 내용을 페이지 캐시에 미리 읽어 두는 함수
+ * 일괄 작업을 시작하기 전에 호출하면 처음 읽을 때 디스크를 기다리지 않는다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param indices 미리 읽을 파일의 인덱스 번호 배열(입력, 읽기 전용)
+ * @param n 파일 개수(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMPrefetch(JFMPtr fm, const int indices[], int n)
+{
+	if((fm == NULL) || (indices == NULL) || (n <= 0)) return NULL;
+
+	int targetIndex = 0;
+	for( ; targetIndex < n; targetIndex++)
+	{
+		if(JFMGetFile(fm, indices[targetIndex]) == NULL) return NULL;
+	}
+
+	for(targetIndex = 0; targetIndex < n; targetIndex++)
+	{
+		if(JFilePrefetch(JFMGetFile(fm, indices[targetIndex])) == NULL) return NULL;
+	}
+
+	return fm;
+}
+
+/*
+ * @fn long long JFMGetFileSize(const JFMPtr fm, int index)
+ * @brief 지정한 파일을 열어서 전달받은 문자열을 저장하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param s 저장할 문자열(입력, 읽기 전용)
+ * @param mode 파일 접근 방식(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMWriteFile(JFMPtr fm, int index, const char *s, const char *mode)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (s == NULL)) return NULL;
+	// 이어 쓰기는 색인한 내용 끝부터, 나머지 모드는 처음부터 다시 색인한다.
+	JFMIndexMarkDirty(fm, JFMGetFile(fm, index), ((mode != NULL) && (mode[0] == 'a')) ? -1 : 0);
+
+	// 쓰기 지연을 사용하면 "w", "a" 모드는 버퍼에만 저장하고, 나머지 모드는 대기 내용을 먼저 저장한다.
+	if((fm->writeBack != NULL) && (mode != NULL) && ((strcmp(mode, "w") == 0) || (strcmp(mode, "a") == 0)))
+	{
+		if(JFMWriteBackAppend(fm->writeBack, JFMGetFile(fm, index), s, mode) == False) return NULL;
+		return fm;
+	}
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	if(JFileWrite(JFMGetFile(fm, index), s, mode) == NULL) return NULL;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMWriteFileV(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, const char *mode)
+ * @brief 여러 버퍼의 내용을 지정한 모드로 한 번에 저장하는 함수
+ * 문자열이 아닌 버퍼 단위로 쓰므로 중간에 0 이 있는 바이너리 내용도 저장할 수 있다.
+ * 파일을 다시 읽지 않고 새로 쓴 내용만 세서 라인 수와 문자 개수를 갱신한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param iov 쓸 내용이 저장된 버퍼 배열(입력, 읽기 전용)
+ * @param iovcnt 버퍼 개수(입력)
+ * @param mode 파일 접근 방식(입력, 읽기 전용, "w" 는 새로 쓰기, "a" 는 끝에 추가)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMWriteFileV(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, const char *mode)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (mode == NULL)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if((mode[0] != 'w') && (mode[0] != 'a')) return NULL;
+	JFMIndexMarkDirty(fm, JFMGetFile(fm, index), (mode[0] == 'a') ? -1 : 0);
+	if(JFileWriteV(JFMGetFile(fm, index), iov, iovcnt, -1, (mode[0] == 'w') ? True : False) < 0) return NULL;
+	return fm;
+}
+
+/*
+ * @fn ssize_t JFMPWrite(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, off_t offset)
+ * @brief 여러 버퍼의 내용을 지정한 위치에 한 번에 덮어쓰는 함수
+ * 파일 끝보다 뒤에 쓰면 사이는 구멍(hole)으로 남는다. 덮어쓴 구간의 기존 내용만 다시 세서 라인 수와 문자 개수를 갱신한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param iov 쓸 내용이 저장된 버퍼 배열(입력, 읽기 전용)
+ * @param iovcnt 버퍼 개수(입력)
+ * @param offset 쓰기 시작할 위치(입력)
+ * @return 성공 시 쓴 길이, 실패 시 -1 반환
+ */
+ssize_t JFMPWrite(JFMPtr fm, int index, const struct iovec *iov, int iovcnt, off_t offset)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (offset < 0)) return -1;
+	if(JFMFlush(fm, index) == NULL) return -1;
+	JFMIndexMarkDirty(fm, JFMGetFile(fm, index), (long long)offset);
+	return JFileWriteV(JFMGetFile(fm, index), iov, iovcnt, offset, False);
+}
+
+/*
+ * @fn JFMPtr JFMReplaceFile(JFMPtr fm, int index, const void *data, size_t length, int flags)
+ * @brief 지정한 파일의 내용을 새 내용으로 원자적으로 교체하는 함수
+ * 제자리에서 잘라내고 쓰지 않으므로 읽는 쪽이 일부만 쓰인 내용을 보거나, 중간에 실패해서 빈 파일이 남지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param data 저장할 내용(입력, 읽기 전용)
+ * @param length 내용의 길이(입력)
+ * @param flags 교체 방식(입력, JFMReplaceFlag 값의 비트 조합)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMReplaceFile(JFMPtr fm, int index, const void *data, size_t length, int flags)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	JFMIndexMarkDirty(fm, JFMGetFile(fm, index), 0);
+	if(JFileReplace(JFMGetFile(fm, index), data, length, flags) == NULL) return NULL;
+	return fm;
+}
+
+/*
+ * @fn char** JFMReadFile(JFMPtr fm, int index)
+ * @brief 지정한 파일 내용을 읽어서 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 내용, 실패 시 NULL 반환
+ */
+char** JFMReadFile(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	return JFileRead(JFMGetFile(fm, index), LINE_LENGTH);
+}
+
+/*
+ * @fn char* JFMReadLine(JFMPtr fm, int index, long long lineNumber)
+ * @brief 지정한 파일에서 지정한 라인 하나만 읽어서 반환하는 함수
+ * 라인 위치 색인을 사용하므로 파일 전체를 읽지 않으며, 압축 파일이면 필요한 블록만 압축 해제한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param lineNumber 읽을 라인 번호(입력, 0 부터 시작)
+ * @return 성공 시 라인 문자열(개행 문자 포함, 호출자가 해제), 실패 시 NULL 반환
+ */
+char* JFMReadLine(JFMPtr fm, int index, long long lineNumber)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	return JFileReadLine(JFMGetFile(fm, index), lineNumber);
+}
+
+/*
+ * @fn ssize_t JFMReadRange(JFMPtr fm, int index, off_t offset, size_t length, void *buf)
+ * @brief 지정한 파일의 지정한 위치부터 지정한 길이만큼 바이트 단위로 읽어서 버퍼에 저장하는 함수
+ * 라인 단위로 나누지 않으므로 바이너리 내용도 그대로 읽을 수 있다. 일반 파일은 pread 로 바로 읽는다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param offset 읽기 시작할 위치(입력)
+ * @param length 읽을 길이(입력)
+ * @param buf 읽은 내용을 저장할 버퍼(출력, length 이상의 크기)
+ * @return 성공 시 읽은 길이(파일 끝이면 length 보다 작음), 실패 시 -1 반환
+ */
+ssize_t JFMReadRange(JFMPtr fm, int index, off_t offset, size_t length, void *buf)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (offset < 0) || (buf == NULL)) return -1;
+	if(JFMFlush(fm, index) == NULL) return -1;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return -1;
+
+	int fd = -1;
+	if((file->pack == NULL) && ((fd = open(file->path, O_RDONLY)) == -1)) return -1;
+
+	ssize_t readSize = JFileReadAt(file, fd, (char*)buf, length, offset);
+	if(fd != -1) close(fd);
+	return readSize;
+}
+
+/*
+ * @fn long long JFMReadInto(JFMPtr fm, int index, off_t offset, char *buf, size_t bufSize, size_t lineOffsets[], long long maxLines)
+ * @brief 지정한 위치부터 버퍼에 들어가는 완성된 라인들을 읽고 각 라인의 시작 위치를 배열에 저장하는 함수
+ * 라이브러리 안에서 힙 메모리를 할당하지 않는다(압축 파일은 블록 버퍼를 처음 한 번만 할당).
+ * lineOffsets[k] 에는 k 번째 라인의 버퍼 안 시작 위치를, lineOffsets[라인 개수] 에는 마지막 라인의 끝 위치를 저장하므로
+ * 다음 호출은 offset + lineOffsets[라인 개수] 부터 이어서 읽으면 된다.
+ * 파일 끝의 라인은 개행 문자로 끝나지 않아도 한 라인으로 본다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param offset 읽기 시작할 위치(입력, 라인 시작 위치여야 함)
+ * @param buf 읽은 내용을 저장할 버퍼(출력)
+ * @param bufSize 버퍼 크기(입력)
+ * @param lineOffsets 라인 시작 위치를 저장할 배열(출력, maxLines + 1 개 이상의 크기)
+ * @param maxLines 읽을 최대 라인 개수(입력)
+ * @return 성공 시 읽은 라인 개수(파일 끝이면 0), 한 라인도 버퍼에 들어가지 않거나 실패 시 -1 반환
+ */
+long long JFMReadInto(JFMPtr fm, int index, off_t offset, char *buf, size_t bufSize, size_t lineOffsets[], long long maxLines)
+{
+	if((buf == NULL) || (bufSize == 0) || (lineOffsets == NULL) || (maxLines <= 0)) return -1;
+
+	ssize_t readSize = JFMReadRange(fm, index, offset, bufSize, buf);
+	if(readSize < 0) return -1;
+
+	long long lineNum = 0;
+	size_t lineStart = 0;
+	char *newline = NULL;
+	while((lineNum < maxLines) && ((newline = (char*)memchr(buf + lineStart, '\n', (size_t)readSize - lineStart)) != NULL))
+	{
+		lineOffsets[lineNum++] = lineStart;
+		lineStart = (size_t)(newline - buf) + 1;
+	}
+
+	// 버퍼를 다 채우지 못했으면 파일 끝이므로 남은 내용도 한 라인이다.
+	if((lineNum < maxLines) && ((size_t)readSize < bufSize) && (lineStart < (size_t)readSize))
+	{
+		lineOffsets[lineNum++] = lineStart;
+		lineStart = (size_t)readSize;
+	}
+
+	if((lineNum == 0) && (readSize > 0)) return -1;
+
+	lineOffsets[lineNum] = lineStart;
+	return lineNum;
+}
+
+/*
+ * @fn JFMPtr JFMReadTail(JFMPtr fm, int index, long long n, JFMLinesPtr out)
+ * @brief 지정한 파일의 마지막 n 개 라인만 읽어서 반환하는 함수
+ * 파일 끝에서부터 블록 단위로 거꾸로 읽으므로 파일 크기와 상관없이 마지막 라인들이 있는 구간만 읽는다.
+ * 파일 크기가 저장된 정보와 같으면 저장된 전체 라인 수로 첫 라인 번호를 구하고, 다르면 -1 로 설정한다.
+ * 반환된 라인은 JFMFreeLines 로 해제해야 한다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param n 읽을 라인 개수(입력)
+ * @param out 읽은 라인을 저장할 구조체의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMReadTail(JFMPtr fm, int index, long long n, JFMLinesPtr out)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (n < 0) || (out == NULL)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	out->lineList = NULL;
+	out->lineNum = 0;
+	out->firstLine = -1;
+
+	int fd = -1;
+	if((file->pack == NULL) && ((fd = open(file->path, O_RDONLY)) == -1)) return NULL;
+
+	// 일반 파일은 지금 크기를 사용하고, 크기가 바뀌었으면 저장된 라인 수를 쓰지 않는다.
+	off_t size = (off_t)JFileGetSize(file);
+	Bool isCounted = True;
+	if((file->compress == NULL) && (file->pack == NULL))
+	{
+		FileStatus fileStat;
+		if(fstat(fd, &fileStat) == -1)
+		{
+			close(fd);
+			return NULL;
+		}
+		if(fileStat.st_size != size) isCounted = False;
+		size = fileStat.st_size;
+	}
+
+	off_t start = JFileFindTailStart(file, fd, size, n);
+	JFMPtr result = NULL;
+	if((start >= 0) && (JFileSplitLines(file, fd, start, size, out) == True)) result = fm;
+
+	if(fd != -1) close(fd);
+	if((result != NULL) && (isCounted == True)) out->firstLine = file->line - out->lineNum;
+	return result;
+}
+
+/*
+ * @fn void JFMFreeLines(JFMLinesPtr lines)
+ * @brief JFMReadTail 등으로 읽은 라인들을 모두 해제하는 함수
+ * @param lines 해제할 라인 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+void JFMFreeLines(JFMLinesPtr lines)
+{
+	if(lines == NULL) return;
+
+	if(lines->lineList != NULL)
+	{
+		long long lineIndex = 0;
+		for( ; lineIndex < lines->lineNum; lineIndex++)
+		{
+			if(lines->lineList[lineIndex] != NULL) free(lines->lineList[lineIndex]);
+		}
+		free(lines->lineList);
+	}
+
+	lines->lineList = NULL;
+	lines->lineNum = 0;
+	lines->firstLine = -1;
+}
+
+/*
+ * @fn JFMPtr JFMFollow(JFMPtr fm, int index, JFMFollowFunc callback)
+ * @brief 지정한 파일에 새로 추가되는 완성된 라인을 콜백으로 전달하는 함수(tail -F)
+ * 처음 호출하면 파일 끝(완성되지 않은 마지막 라인의 처음)부터 시작하고, 이후에는 마지막으로 전달한 위치부터 이어서 읽는다.
+ * inotify 로 변경 알림을 기다리며, FOLLOW_POLL_TIMEOUT 동안 변경이 없으면 콜백에 NULL 라인을 전달한다.
+ * 새 내용만 읽어서 라인 수와 문자 개수를 갱신하고, 파일이 잘리면 처음부터 다시 읽는다.
+ * 같은 경로의 파일이 다른 아이노드로 교체되면(로그 회전) 이전 파일에 남은 내용을 모두 전달한 후 새 파일을 처음부터 읽는다.
+ * 콜백이 0 이 아닌 값을 반환하면 멈추고 반환한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param callback 새 라인을 전달받을 콜백 함수(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMFollow(JFMPtr fm, int index, JFMFollowFunc callback)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (callback == NULL)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->compress != NULL) || (file->pack != NULL)) return NULL;
+	if((file->stat.st_mode & S_IFMT) != S_IFREG) return NULL;
+
+	int fd = open(file->path, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	// inotify 를 사용할 수 없으면 대기 시간마다 확인한다.
+	int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	uint32_t watchMask = IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF;
+	if(inotifyFd != -1) inotify_add_watch(inotifyFd, file->path, watchMask);
+
+	int result = JFileFollowRead(file, fd, fm, index, callback);
+	while(result == 0)
+	{
+		struct pollfd pollFd;
+		pollFd.fd = inotifyFd;
+		pollFd.events = POLLIN;
+		pollFd.revents = 0;
+
+		int eventNum = poll(&pollFd, (inotifyFd != -1) ? 1 : 0, FOLLOW_POLL_TIMEOUT);
+		if((eventNum < 0) && (errno != EINTR))
+		{
+			result = -1;
+			break;
+		}
+		if(eventNum > 0)
+		{
+			char eventBuf[4096];
+			while(read(inotifyFd, eventBuf, sizeof(eventBuf)) > 0);
+		}
+
+		// 같은 경로가 다른 파일로 바뀌었으면 이전 파일을 끝까지 읽은 후 새 파일로 바꾼다.
+		FileStatus pathStat;
+		FileStatus fdStat;
+		if((stat(file->path, &pathStat) == 0) && (fstat(fd, &fdStat) == 0)
+			&& ((pathStat.st_ino != fdStat.st_ino) || (pathStat.st_dev != fdStat.st_dev)))
+		{
+			result = JFileFollowRead(file, fd, fm, index, callback);
+			if(result != 0) break;
+
+			int newFd = open(file->path, O_RDONLY);
+			if(newFd != -1)
+			{
+				close(fd);
+				fd = newFd;
+				JFileFollowReset(file);
+				if(inotifyFd != -1)
+				{
+					close(inotifyFd);
+					inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+					if(inotifyFd != -1) inotify_add_watch(inotifyFd, file->path, watchMask);
+				}
+			}
+		}
+
+		long long followOffset = file->followOffset;
+		result = JFileFollowRead(file, fd, fm, index, callback);
+
+		// 대기 시간 동안 전달한 라인이 없으면 콜백에 알린다.
+		if((result == 0) && (eventNum == 0) && (followOffset == file->followOffset))
+		{
+			if(callback(fm, index, NULL, -1) != 0) result = 1;
+		}
+	}
+
+	if(inotifyFd != -1) close(inotifyFd);
+	close(fd);
+	return (result == -1) ? NULL : fm;
+}
+
+/*
+ * @fn JFilePtr JFMFindFileByPath(const JFMPtr fm, const char *path)
+ * @brief 파일 이름을 통해 파일 관리 구조체에서 파일을 검색해서 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param path 검색할 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 정보 구조체의 주소, 실패 시 NULL 반환
+ */
+JFilePtr JFMFindFileByPath(const JFMPtr fm, const char *path)
+{
+	if((fm == NULL) || (path == NULL)) return NULL;
+	if(_CheckIfPath(path) == False) return NULL;
+
+	// 경로 색인에서 찾고, 색인을 만들 수 없거나 색인의 파일이 관리 목록과 다를 때만 모두 비교한다.
+	PathNodePtr root = JFMPathIndexGet(fm);
+	if(root != NULL)
+	{
+		PathNodePtr node = _PathNodeFind(root, path, strlen(path), False);
+		if((node == NULL) || (node->file == NULL)) return NULL;
+		if(JFMGetFile(fm, node->fileIndex) == node->file) return node->file;
+	}
+
+	int fileIndex = 0;
+	JFilePtr file = NULL;
+
+	for( ; fileIndex < fm->size; fileIndex++)
+	{
+		file = JFMGetFile(fm, fileIndex);
+		if(file == NULL) continue;
+		// 앞부분만 같은 다른 경로("a.txt", "a.txt_1")와 구분하기 위해 전체 경로를 비교한다.
+		if(strcmp(path, file->path) == 0) return file;
+	}
+
+	return NULL;
+}
+
+/*
+ * @fn JFMPathIterPtr JFMFindByPrefix(JFMPtr fm, const char *prefix)
+ * @brief 경로가 지정한 접두사로 시작하는 파일을 모두 찾는 함수
+ * 파일 경로의 압축 기수 트라이(경로 색인)에서 찾으므로 전체 파일을 비교하지 않고, 찾은 파일 개수와 경로 깊이에 비례하는 시간이 걸린다.
+ * 문자열 접두사로 비교하므로 디렉터리 아래만 찾으려면 접두사를 '/' 로 끝내야 한다("/data/2024/").
+ * 반복자는 만들 때 찾은 결과를 저장하므로, 반복하는 중에 파일을 추가, 삭제, 이동해도 된다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param prefix 경로 접두사(입력, 읽기 전용, 관리 중인 파일 경로와 같은 형식)
+ * @return 성공 시 파일 인덱스 번호를 경로 순서로 반환하는 반복자의 주소(JFMPathIterClose 로 해제), 실패 시 NULL 반환
+ */
+JFMPathIterPtr JFMFindByPrefix(JFMPtr fm, const char *prefix)
+{
+	if((fm == NULL) || (prefix == NULL)) return NULL;
+	return JFMPathIterNew(fm, prefix, strlen(prefix), NULL);
+}
+
+/*
+ * @fn JFMPathIterPtr JFMFindByGlob(JFMPtr fm, const char *pattern)
+ * @brief 경로가 글롭 패턴과 맞는 파일을 모두 찾는 함수
+ * '*' 는 '/' 를 제외한 0 개 이상의 문자, '?' 는 '/' 를 제외한 문자 하나, '**' 는 하위 디렉터리를 포함한 0 개 이상의 문자와 맞는다.
+ * 패턴에서 처음 '*', '?' 앞까지를 접두사로 경로 색인에서 찾고, 그 아래 파일만 패턴과 비교한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param pattern 글롭 패턴(입력, 읽기 전용)
+ * @return 성공 시 파일 인덱스 번호를 경로 순서로 반환하는 반복자의 주소(JFMPathIterClose 로 해제), 실패 시 NULL 반환
+ */
+JFMPathIterPtr JFMFindByGlob(JFMPtr fm, const char *pattern)
+{
+	if((fm == NULL) || (pattern == NULL)) return NULL;
+	return JFMPathIterNew(fm, pattern, strcspn(pattern, "*?"), pattern);
+}
+
+/*
+ * @fn int JFMPathIterNext(JFMPathIterPtr iter)
+ * @brief 반복자에서 다음 파일의 인덱스 번호를 반환하는 함수
+ * @param iter 반복자의 주소(출력)
+ * @return 다음 파일의 인덱스 번호, 더 없으면 -1 반환
+ */
+int JFMPathIterNext(JFMPathIterPtr iter)
+{
+	if((iter == NULL) || (iter->position >= iter->indexNum)) return -1;
+	return iter->indexList[(iter->position)++];
+}
+
+/*
+ * @fn long long JFMPathIterGetCount(const JFMPathIterPtr iter)
+ * @brief 반복자에 저장된 전체 파일 개수를 반환하는 함수
+ * @param iter 반복자의 주소(입력, 읽기 전용)
+ * @return 성공 시 파일 개수, 실패 시 -1 반환
+ */
+long long JFMPathIterGetCount(const JFMPathIterPtr iter)
+{
+	if(iter == NULL) return -1;
+	return iter->indexNum;
+}
+
+/*
+ * @fn void JFMPathIterClose(JFMPathIterPtrContainer iterContainer)
+ * @brief 반복자를 해제하는 함수
+ * @param iterContainer 반복자의 주소를 저장하는 포인터(입력, 이중 포인터)
+ * @return 반환값 없음
+ */
+void JFMPathIterClose(JFMPathIterPtrContainer iterContainer)
+{
+	if((iterContainer == NULL) || (*iterContainer == NULL)) return;
+
+	if((*iterContainer)->indexList != NULL) free((*iterContainer)->indexList);
+	free(*iterContainer);
+	*iterContainer = NULL;
+}
+
+/*
+ * @fn long long JFMDeleteByPrefix(JFMPtr fm, const char *prefix)
+ * @brief 경로가 지정한 접두사로 시작하는 파일을 모두 삭제하는 함수(JFMDeleteFile 참고)
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param prefix 경로 접두사(입력, 읽기 전용, 빈 문자열 불가)
+ * @return 성공 시 삭제한 파일 개수, 하나라도 삭제하지 못하면 -1 반환
+ */
+long long JFMDeleteByPrefix(JFMPtr fm, const char *prefix)
+{
+	if((prefix == NULL) || (prefix[0] == '\0')) return -1;
+
+	JFMPathIterPtr iter = JFMFindByPrefix(fm, prefix);
+	if(iter == NULL) return -1;
+
+	long long deleteNum = 0;
+	int fileIndex = 0;
+	while((fileIndex = JFMPathIterNext(iter)) != -1)
+	{
+		if(JFMDeleteFile(fm, fileIndex) != NULL) deleteNum++;
+	}
+
+	Bool isFailed = (deleteNum < iter->indexNum) ? True : False;
+	JFMPathIterClose(&iter);
+	return (isFailed == True) ? -1 : deleteNum;
+}
+
+/*
+ * @fn long long JFMMoveByPrefix(JFMPtr fm, const char *prefix, const char *newPrefix)
+ * @brief 경로가 지정한 접두사로 시작하는 파일을 모두 접두사만 바꾼 경로로 이동하는 함수
+ * 없는 상위 디렉터리는 만든다. 같은 파일 시스템이면 이름만 바꾸고, 다르면 복사한 후 삭제한다(JFMMoveFile 참고).
+ * 실패하면 그 파일에서 멈추고, 이미 이동한 파일은 새 경로로 남는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param prefix 경로 접두사(입력, 읽기 전용, 빈 문자열 불가)
+ * @param newPrefix 접두사를 바꿀 새 접두사(입력, 읽기 전용)
+ * @return 성공 시 이동한 파일 개수, 하나라도 이동하지 못하면 -1 반환
+ */
+long long JFMMoveByPrefix(JFMPtr fm, const char *prefix, const char *newPrefix)
+{
+	if((prefix == NULL) || (prefix[0] == '\0') || (newPrefix == NULL)) return -1;
+
+	JFMPathIterPtr iter = JFMFindByPrefix(fm, prefix);
+	if(iter == NULL) return -1;
+
+	size_t prefixLength = strlen(prefix);
+	long long moveNum = 0;
+	int fileIndex = 0;
+	while((fileIndex = JFMPathIterNext(iter)) != -1)
+	{
+		char newPath[PATH_MAX];
+		JFilePtr file = JFMGetFile(fm, fileIndex);
+		if((file->pack != NULL) || (JFMFlush(fm, fileIndex) == NULL)) break;
+		if(snprintf(newPath, sizeof(newPath), "%s%s", newPrefix, file->path + prefixLength) >= (int)sizeof(newPath)) break;
+		if((JFMCheckNewPath(fm, newPath) == False) || (_MakeParentDirs(newPath) == False)) break;
+
+		if(rename(file->path, newPath) == 0)
+		{
+			if(JFMSetFilePath(fm, fileIndex, newPath) == False) break;
+		}
+		else if((errno != EXDEV) || (JFMMoveFile(fm, fileIndex, newPath) == NULL)) break;
+		moveNum++;
+	}
+
+	Bool isFailed = (moveNum < iter->indexNum) ? True : False;
+	JFMPathIterClose(&iter);
+	return (isFailed == True) ? -1 : moveNum;
+}
+
+/*
+ * @fn long long JFMQuery(JFMPtr fm, int index, const char *s, JFMQueryFunc callback)
+ * @brief 파일에서 지정한 문자열이 있는 라인을 모두 찾아서 콜백 함수에 전달하는 함수
+ * 내용 색인(JFMEnableIndex)을 사용하면 먼저 바뀐 파일의 색인을 맞춘 후, 문자열의 트라이그램이 모두 나오는 블록만 읽는다.
+ * 사용하지 않으면 파일 전체를 읽는다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 검색할 파일의 인덱스 번호(입력, 음수이면 관리 중인 모든 파일)
+ * @param s 찾을 문자열(입력, 읽기 전용, 빈 문자열 불가)
+ * @param callback 찾은 라인을 전달할 콜백 함수(입력, NULL 이면 개수만 셈)
+ * @return 성공 시 찾은 라인 개수, 실패 시 -1 반환
+ */
+long long JFMQuery(JFMPtr fm, int index, const char *s, JFMQueryFunc callback)
+{
+	if((fm == NULL) || (s == NULL) || (s[0] == '\0')) return -1;
+	if((index >= 0) && (JFMGetFile(fm, index) == NULL)) return -1;
+
+	if(((index < 0) ? JFMFlushAll(fm) : JFMFlush(fm, index)) == NULL) return -1;
+	if((fm->contentIndex != NULL) && (JFMIndexSync(fm, index) == False)) return -1;
+
+	QueryContext query;
+	query.fm = fm;
+	query.index = index;
+	query.s = s;
+	query.length = strlen(s);
+	query.callback = callback;
+	query.matchNum = 0;
+	query.isStopped = False;
+	query.bufSize = READ_BUF_SIZE;
+	query.buf = (char*)malloc(query.bufSize + 1);
+	if(query.buf == NULL) return -1;
+
+	Bool result = True;
+	int fileIndex = (index < 0) ? 0 : index;
+	int lastIndex = (index < 0) ? fm->size - 1 : index;
+	for( ; (result == True) && (query.isStopped == False) && (fileIndex <= lastIndex); fileIndex++)
+	{
+		JFilePtr file = JFMGetFile(fm, fileIndex);
+		if(file == NULL) continue;
+
+		query.index = fileIndex;
+		IndexFilePtr entry = (fm->contentIndex != NULL) ? JFMIndexFind(fm->contentIndex, file) : NULL;
+		result = JFileQuery(file, entry, &query);
+	}
+
+	free(query.buf);
+	return (result == True) ? query.matchNum : -1;
+}
+
+/*
+ * @fn JFMPtr JFMEnableIndex(JFMPtr fm)
+ * @brief 관리 중인 파일의 트라이그램 내용 색인을 만들고 JFMQuery 에서 사용하도록 설정하는 함수
+ * 파일을 INDEX_BLOCK_LINES 라인 단위 블록으로 나누고, 트라이그램(연속한 3 바이트)마다 나오는 블록 번호 목록을 기록한다.
+ * 이 라이브러리로 파일을 바꾸면 바뀐 위치부터, 다른 곳에서 바뀐 파일은 처음부터 다음 검색 전에 다시 색인한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환(이미 사용 중이면 그대로 성공)
+ */
+JFMPtr JFMEnableIndex(JFMPtr fm)
+{
+	if(fm == NULL) return NULL;
+	if(fm->contentIndex != NULL) return fm;
+	if(JFMFlushAll(fm) == NULL) return NULL;
+
+	fm->contentIndex = (struct _jfm_index_t*)calloc(1, sizeof(struct _jfm_index_t));
+	if(fm->contentIndex == NULL) return NULL;
+
+	if(JFMIndexSync(fm, -1) == False)
+	{
+		JFMIndexFree(fm);
+		return NULL;
+	}
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMDisableIndex(JFMPtr fm)
+ * @brief 내용 색인을 해제하고 JFMQuery 가 파일 전체를 읽도록 설정하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMDisableIndex(JFMPtr fm)
+{
+	if(fm == NULL) return NULL;
+	JFMIndexFree(fm);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMSaveIndex(JFMPtr fm, const char *indexPath)
+ * @brief 내용 색인을 색인 파일에 저장하는 함수
+ * 색인 파일은 [헤더][항목 배열][블록 시작 위치 배열][트라이그램 표][경로 문자열 테이블][블록 번호 목록] 순서로 저장하며, mmap 으로 바로 읽을 수 있다.
+ * 트라이그램 표는 파일마다 트라이그램 순서로 정렬하고, 블록 번호 목록은 앞 번호와의 차이를 가변 길이 정수로 압축한다.
+ * 묶음 파일의 항목은 저장하지 않는다. 같은 디렉터리의 임시 파일에 모두 쓴 후 색인 파일 경로로 교체한다.
+ * @param fm 파일 관리 구조체의 주소(입력, 내용 색인을 사용 중이어야 함)
+ * @param indexPath 색인 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSaveIndex(JFMPtr fm, const char *indexPath)
+{
+	if((fm == NULL) || (fm->contentIndex == NULL) || (indexPath == NULL)) return NULL;
+	if((JFMFlushAll(fm) == NULL) || (JFMIndexSync(fm, -1) == False)) return NULL;
+
+	struct _jfm_index_t *contentIndex = fm->contentIndex;
+	long long entryCount = 0;
+	long long blockCount = 0;
+	long long trigramCount = 0;
+	long long stringSize = 0;
+	long long maxBlockNum = 1;
+	long long maxTrigramNum = 1;
+	long long entryIndex = 0;
+	for( ; entryIndex < contentIndex->fileNum; entryIndex++)
+	{
+		IndexFilePtr entry = &(contentIndex->fileList[entryIndex]);
+		if(entry->file->pack != NULL) continue;
+
+		long long trigramNum = entry->mappedTrigramNum;
+		if(entry->isMapped == False)
+		{
+			trigramNum = 0;
+			long long slotIndex = 0;
+			for( ; slotIndex < entry->tableSize; slotIndex++)
+			{
+				if(entry->table[slotIndex].count > 0) trigramNum++;
+			}
+		}
+
+		entryCount++;
+		blockCount += entry->blockNum;
+		trigramCount += trigramNum;
+		stringSize += (long long)strlen(entry->file->path) + 1;
+		if(entry->blockNum > maxBlockNum) maxBlockNum = entry->blockNum;
+		if(trigramNum > maxTrigramNum) maxTrigramNum = trigramNum;
+	}
+
+	IndexHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+	header.version = INDEX_VERSION;
+	header.entrySize = sizeof(IndexEntry);
+	header.entryCount = entryCount;
+	header.entryOffset = (long long)sizeof(IndexHeader);
+	header.blockOffset = header.entryOffset + entryCount * (long long)sizeof(IndexEntry);
+	header.blockCount = blockCount;
+	header.trigramOffset = header.blockOffset + blockCount * (long long)sizeof(long long);
+	header.trigramCount = trigramCount;
+	header.stringOffset = header.trigramOffset + trigramCount * (long long)sizeof(IndexTrigram);
+	header.stringSize = stringSize;
+	header.postingOffset = header.stringOffset + stringSize;
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmidx.%ld", indexPath, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+
+	int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(fd == -1) return NULL;
+
+	IndexEntryPtr entryList = (IndexEntryPtr)calloc((size_t)entryCount + 1, sizeof(IndexEntry));
+	char *stringTable = (char*)malloc((size_t)stringSize + 1);
+	unsigned int *trigramList = (unsigned int*)malloc(sizeof(unsigned int) * (size_t)maxTrigramNum);
+	IndexTrigramPtr rowList = (IndexTrigramPtr)malloc(sizeof(IndexTrigram) * (size_t)maxTrigramNum);
+	unsigned int *postingList = (unsigned int*)malloc(sizeof(unsigned int) * (size_t)maxBlockNum);
+	// 블록 번호 하나는 가변 길이 정수로 최대 5 바이트이다.
+	size_t postingBufSize = (size_t)maxBlockNum * 5;
+	unsigned char *postingBuf = (unsigned char*)malloc(postingBufSize);
+	Bool isFailed = ((entryList == NULL) || (stringTable == NULL) || (trigramList == NULL) || (rowList == NULL) || (postingList == NULL) || (postingBuf == NULL)) ? True : False;
+
+	long long fileEntryIndex = 0;
+	long long blockIndex = 0;
+	long long trigramIndex = 0;
+	long long stringOffset = 0;
+	for(entryIndex = 0; (isFailed == False) && (entryIndex < contentIndex->fileNum); entryIndex++)
+	{
+		IndexFilePtr entry = &(contentIndex->fileList[entryIndex]);
+		if(entry->file->pack != NULL) continue;
+
+		long long trigramNum = 0;
+		if(entry->isMapped == True)
+		{
+			for( ; trigramNum < entry->mappedTrigramNum; trigramNum++) trigramList[trigramNum] = entry->mappedTrigramList[trigramNum].trigram;
+		}
+		else
+		{
+			long long slotIndex = 0;
+			for( ; slotIndex < entry->tableSize; slotIndex++)
+			{
+				if(entry->table[slotIndex].count > 0) trigramList[trigramNum++] = entry->table[slotIndex].key - 1;
+			}
+			qsort(trigramList, (size_t)trigramNum, sizeof(unsigned int), _CompareUnsignedInt);
+		}
+
+		// 트라이그램마다 블록 번호 목록을 압축해서 블록 번호 목록 영역 끝에 이어서 쓴다.
+		long long rowIndex = 0;
+		for( ; (isFailed == False) && (rowIndex < trigramNum); rowIndex++)
+		{
+			long long postingNum = _IndexGetPostings(entry, trigramList[rowIndex], postingList);
+			if(postingNum < 0)
+			{
+				isFailed = True;
+				break;
+			}
+			size_t encodedSize = _IndexEncodePostings(postingList, postingNum, postingBuf);
+			rowList[rowIndex].trigram = trigramList[rowIndex];
+			rowList[rowIndex].blockCount = (unsigned int)postingNum;
+			rowList[rowIndex].postingOffset = header.postingSize;
+			if(_WriteFull(fd, postingBuf, encodedSize, (off_t)(header.postingOffset + header.postingSize)) != (ssize_t)encodedSize) isFailed = True;
+			header.postingSize += (long long)encodedSize;
+		}
+		if(isFailed == True) break;
+
+		size_t rowSize = sizeof(IndexTrigram) * (size_t)trigramNum;
+		size_t blockSize = sizeof(long long) * (size_t)entry->blockNum;
+		if((_WriteFull(fd, rowList, rowSize, (off_t)(header.trigramOffset + trigramIndex * (long long)sizeof(IndexTrigram))) != (ssize_t)rowSize)
+			|| (_WriteFull(fd, entry->blockOffsetList, blockSize, (off_t)(header.blockOffset + blockIndex * (long long)sizeof(long long))) != (ssize_t)blockSize))
+		{
+			isFailed = True;
+			break;
+		}
+
+		IndexEntryPtr fileEntry = &(entryList[fileEntryIndex++]);
+		fileEntry->pathOffset = stringOffset;
+		fileEntry->pathLength = (unsigned int)strlen(entry->file->path);
+		fileEntry->size = (long long)entry->stat.st_size;
+		fileEntry->mtime = (long long)entry->stat.st_mtim.tv_sec;
+		fileEntry->mtimeNsec = (long long)entry->stat.st_mtim.tv_nsec;
+		fileEntry->ino = (long long)entry->stat.st_ino;
+		fileEntry->dev = (long long)entry->stat.st_dev;
+		fileEntry->contentSize = entry->contentSize;
+		fileEntry->blockIndex = blockIndex;
+		fileEntry->blockCount = entry->blockNum;
+		fileEntry->trigramIndex = trigramIndex;
+		fileEntry->trigramCount = trigramNum;
+
+		memcpy(stringTable + stringOffset, entry->file->path, (size_t)fileEntry->pathLength + 1);
+		stringOffset += (long long)fileEntry->pathLength + 1;
+		blockIndex += entry->blockNum;
+		trigramIndex += trigramNum;
+	}
+
+	if(isFailed == False)
+	{
+		size_t entrySize = sizeof(IndexEntry) * (size_t)entryCount;
+		if((_WriteFull(fd, entryList, entrySize, (off_t)header.entryOffset) != (ssize_t)entrySize)
+			|| (_WriteFull(fd, stringTable, (size_t)stringSize, (off_t)header.stringOffset) != (ssize_t)stringSize)
+			|| (_WriteFull(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)))
+		{
+			isFailed = True;
+		}
+	}
+
+	if(entryList != NULL) free(entryList);
+	if(stringTable != NULL) free(stringTable);
+	if(trigramList != NULL) free(trigramList);
+	if(rowList != NULL) free(rowList);
+	if(postingList != NULL) free(postingList);
+	if(postingBuf != NULL) free(postingBuf);
+	if(close(fd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, indexPath) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMLoadIndex(JFMPtr fm, const char *indexPath)
+ * @brief 색인 파일을 불러와서 내용 색인으로 사용하는 함수(내용 색인을 사용하지 않고 있었으면 사용하도록 설정)
+ * 색인 파일은 mmap 으로 읽고 색인을 풀지 않은 채로 검색에 사용한다. 관리 중인 파일과 경로가 같은 항목만 사용한다.
+ * 저장한 후에 바뀐 파일(크기, 수정 시각, 아이노드, 장치 번호가 다름)과 색인 파일에 없는 파일은 다시 색인한다.
+ * 매핑된 색인은 파일이 바뀌어서 다시 색인할 때 메모리로 옮긴다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param indexPath 색인 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMLoadIndex(JFMPtr fm, const char *indexPath)
+{
+	if((fm == NULL) || (indexPath == NULL)) return NULL;
+	if(JFMFlushAll(fm) == NULL) return NULL;
+
+	int fd = open(indexPath, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	FileStatus indexStat;
+	if((fstat(fd, &indexStat) == -1) || (indexStat.st_size < (off_t)sizeof(IndexHeader)))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	size_t mapSize = (size_t)indexStat.st_size;
+	char *map = (char*)mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED) return NULL;
+	// 검색할 때는 필요한 트라이그램의 목록만 읽는다.
+	madvise(map, mapSize, MADV_RANDOM);
+
+	long long indexSize = (long long)indexStat.st_size;
+	IndexHeaderPtr header = (IndexHeaderPtr)map;
+	if((memcmp(header->magic, INDEX_MAGIC, sizeof(header->magic)) != 0)
+		|| (header->version != INDEX_VERSION)
+		|| (header->entrySize != sizeof(IndexEntry))
+		|| (header->entryCount < 0) || (header->blockCount < 0) || (header->trigramCount < 0)
+		|| (header->stringSize < 0) || (header->postingSize < 0)
+		|| (header->entryOffset != (long long)sizeof(IndexHeader))
+		|| (header->entryCount > (indexSize - header->entryOffset) / (long long)sizeof(IndexEntry))
+		|| (header->blockOffset != header->entryOffset + header->entryCount * (long long)sizeof(IndexEntry))
+		|| (header->blockCount > (indexSize - header->blockOffset) / (long long)sizeof(long long))
+		|| (header->trigramOffset != header->blockOffset + header->blockCount * (long long)sizeof(long long))
+		|| (header->trigramCount > (indexSize - header->trigramOffset) / (long long)sizeof(IndexTrigram))
+		|| (header->stringOffset != header->trigramOffset + header->trigramCount * (long long)sizeof(IndexTrigram))
+		|| (header->stringSize > indexSize - header->stringOffset)
+		|| (header->postingOffset != header->stringOffset + header->stringSize)
+		|| (header->postingSize > indexSize - header->postingOffset))
+	{
+		munmap(map, mapSize);
+		return NULL;
+	}
+
+	if(fm->contentIndex == NULL)
+	{
+		fm->contentIndex = (struct _jfm_index_t*)calloc(1, sizeof(struct _jfm_index_t));
+		if(fm->contentIndex == NULL)
+		{
+			munmap(map, mapSize);
+			return NULL;
+		}
+	}
+	else JFMIndexUnmap(fm->contentIndex);
+
+	struct _jfm_index_t *contentIndex = fm->contentIndex;
+	contentIndex->map = map;
+	contentIndex->mapSize = mapSize;
+
+	IndexEntryPtr entryList = (IndexEntryPtr)(map + header->entryOffset);
+	long long *blockOffsetList = (long long*)(map + header->blockOffset);
+	IndexTrigramPtr trigramList = (IndexTrigramPtr)(map + header->trigramOffset);
+	char *stringTable = map + header->stringOffset;
+
+	long long entryIndex = 0;
+	for( ; entryIndex < header->entryCount; entryIndex++)
+	{
+		IndexEntryPtr fileEntry = &(entryList[entryIndex]);
+
+		// 잘못된 항목으로 매핑 밖을 읽지 않도록 구간을 검사한다.
+		if((fileEntry->pathOffset < 0) || ((long long)fileEntry->pathLength >= header->stringSize - fileEntry->pathOffset)
+			|| (stringTable[fileEntry->pathOffset + fileEntry->pathLength] != '\0')
+			|| (fileEntry->blockIndex < 0) || (fileEntry->blockCount < 0)
+			|| (fileEntry->blockCount > header->blockCount - fileEntry->blockIndex)
+			|| (fileEntry->trigramIndex < 0) || (fileEntry->trigramCount < 0)
+			|| (fileEntry->trigramCount > header->trigramCount - fileEntry->trigramIndex)
+			|| (fileEntry->contentSize < 0))
+		{
+			continue;
+		}
+
+		// 블록 시작 위치는 0 부터 오름차순이고 색인한 내용 끝을 넘지 않아야 한다.
+		long long *fileBlockList = blockOffsetList + fileEntry->blockIndex;
+		long long blockIndex = 0;
+		for( ; blockIndex < fileEntry->blockCount; blockIndex++)
+		{
+			long long previous = (blockIndex == 0) ? -1 : fileBlockList[blockIndex - 1];
+			if((fileBlockList[blockIndex] <= previous) || (fileBlockList[blockIndex] > fileEntry->contentSize)) break;
+		}
+		if((blockIndex < fileEntry->blockCount) || ((fileEntry->blockCount > 0) && (fileBlockList[0] != 0))) continue;
+
+		JFilePtr file = JFMFindFileByPath(fm, stringTable + fileEntry->pathOffset);
+		if((file == NULL) || (file->pack != NULL)) continue;
+
+		IndexFilePtr entry = JFMIndexFind(contentIndex, file);
+		if(entry != NULL) _IndexFileFree(entry);
+		else if((entry = JFMIndexAdd(contentIndex, file)) == NULL) break;
+
+		// 저장할 때의 파일 상태만 기록하고, 지금 파일과 다르면 JFMIndexSync 에서 다시 색인한다.
+		_IndexFileInit(entry, file);
+		entry->stat.st_size = (off_t)fileEntry->size;
+		entry->stat.st_mtim.tv_sec = (time_t)fileEntry->mtime;
+		entry->stat.st_mtim.tv_nsec = (long)fileEntry->mtimeNsec;
+		entry->stat.st_ino = (ino_t)fileEntry->ino;
+		entry->stat.st_dev = (dev_t)fileEntry->dev;
+		entry->contentSize = fileEntry->contentSize;
+		entry->dirtyOffset = -1;
+		entry->isMapped = True;
+		entry->blockOffsetList = fileBlockList;
+		entry->blockNum = fileEntry->blockCount;
+		entry->blockCapacity = fileEntry->blockCount;
+		entry->mappedTrigramList = trigramList + fileEntry->trigramIndex;
+		entry->mappedTrigramNum = fileEntry->trigramCount;
+		entry->mappedPosting = (const unsigned char*)(map + header->postingOffset);
+		entry->mappedPostingSize = header->postingSize;
+	}
+
+	if(JFMIndexSync(fm, -1) == False) return NULL;
+	return fm;
+}
+
+/*
+ * @fn JFilePtr JFMGetFile(const JFMPtr fm, int index)
+ * @brief 지정한 파일 정보 구조체의 주소를 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 정보 구조체의 주소, 실패 시 NULL 반환
+ */
+JFilePtr JFMGetFile(const JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	return fm->fileContainer[index];
+}
+
+/*
+ * @fn JFMPtr JFMMoveFile(JFMPtr fm, int index, const char *newFilePath)
+ * @brief 파일을 지정한 경로로 이동시키는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param newFilePath 파일을 이동시킬 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMMoveFile(JFMPtr fm, int index, const char *newFilePath)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (newFilePath == NULL)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if((JFMGetFile(fm, index) == NULL) || (JFMGetFile(fm, index)->pack != NULL)) return NULL;
+
+	// 목적지 경로에 복사 후 삭제
+	if(JFMCopyFile(fm, index, newFilePath) == NULL) return NULL;
+	JFileRemove(JFMGetFile(fm, index));
+	if(JFMSetFilePath(fm, index, newFilePath) == False) return NULL;
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMCopyFile(JFMPtr fm, int index, const char *newFilePath)
+ * @brief 파일을 지정한 경로로 복사하는 함수
+ * 경로가 NULL 이면 원본 경로 뒤에 중복 횟수를 붙인 경로(_N)로 복사한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param newFilePath 파일을 복사할 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMCopyFile(JFMPtr fm, int index, const char *newFilePath)
+{
+	return JFMCopyFileEx(fm, index, newFilePath, NULL);
+}
+
+/*
+ * @fn JFMPtr JFMCopyFileEx(JFMPtr fm, int index, const char *newFilePath, const JFMCopyOptionPtr option)
+ * @brief 복사 옵션을 지정해서 파일을 지정한 경로로 복사하는 함수
+ * JFMCopyDelta 옵션을 지정하면 대상 파일이 이미 있을 때 원본과 블록 단위로 병렬 비교해서 달라진 구간만 다시 쓴다.
+ * JFMCopyResume 옵션을 지정하면 체크포인트 파일(대상 경로 + ".jfmckpt")을 남기면서 복사하고, 같은 옵션으로 다시 호출하면 중단된 위치부터 이어서 복사한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param newFilePath 파일을 복사할 경로(입력, 읽기 전용)
+ * @param option 복사 옵션(입력, 읽기 전용, NULL 이면 기본 복사)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMCopyFileEx(JFMPtr fm, int index, const char *newFilePath, const JFMCopyOptionPtr option)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if((newFilePath != NULL) && (_CheckIfPath(newFilePath) == False)) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	if(newFilePath == NULL)
+	{
+		char dupleFilePath[PATH_MAX];
+		if(snprintf(dupleFilePath, sizeof(dupleFilePath), "%s_%d", file->path, file->dupleNum + 1) >= (int)sizeof(dupleFilePath)) return NULL;
+		if(JFileCopy(file, dupleFilePath, option) == NULL) return NULL;
+		JFileIncDupleNum(file);
+	}
+	else if(JFileCopy(file, newFilePath, option) == NULL) return NULL;
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMCopyFiles(JFMPtr fm, const int indices[], const char *destPaths[], int n, const JFMCopyOptionPtr option, JFMCopyResult results[], JFMCopySummaryPtr summary)
+ * @brief 지정한 파일들을 각각의 대상 경로에 병렬로 복사하는 함수
+ * 복사 옵션의 작업 스레드 개수만큼 동시에 복사하며, 전체 복사 시간을 줄이기 위해 큰 파일부터 복사한다.
+ * 파일 하나의 복사 방식(차등 복사, O_DIRECT 등)은 JFMCopyFileEx 와 같다.
+ * 일부 파일이 실패해도 나머지 파일은 모두 복사하며, 파일별 결과는 results 에 저장된다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param indices 복사할 파일의 인덱스 번호 배열(입력, 읽기 전용)
+ * @param destPaths 파일별 대상 경로 배열(입력, 읽기 전용)
+ * @param n 파일 개수(입력)
+ * @param option 복사 옵션(입력, 읽기 전용, NULL 이면 기본 복사와 CPU 개수만큼 동시 복사)
+ * @param results 파일별 복사 결과를 저장할 배열(출력, indices 와 같은 순서, NULL 이면 저장하지 않음)
+ * @param summary 전체 복사 결과를 저장할 구조체의 주소(출력, NULL 이면 저장하지 않음)
+ * @return 모든 파일을 복사하면 파일 관리 구조체의 주소, 하나라도 실패하거나 인자가 잘못되면 NULL 반환
+ */
+JFMPtr JFMCopyFiles(JFMPtr fm, const int indices[], const char *destPaths[], int n, const JFMCopyOptionPtr option, JFMCopyResult results[], JFMCopySummaryPtr summary)
+{
+	if((fm == NULL) || (indices == NULL) || (destPaths == NULL) || (n <= 0)) return NULL;
+
+	int targetIndex = 0;
+	for( ; targetIndex < n; targetIndex++)
+	{
+		if(JFMGetFile(fm, indices[targetIndex]) == NULL) return NULL;
+		if((destPaths[targetIndex] == NULL) || (_CheckIfPath(destPaths[targetIndex]) == False)) return NULL;
+		if(JFMFlush(fm, indices[targetIndex]) == NULL) return NULL;
+		// 크기순으로 정렬하기 전에 최신 크기로 맞춘다.
+		if(JFileUpdateStat(JFMGetFile(fm, indices[targetIndex])) == NULL) return NULL;
+	}
+
+	BatchCopy batch;
+	batch.option = option;
+	batch.taskList = (CopyTaskPtr)malloc(sizeof(CopyTask) * (size_t)n);
+	batch.resultList = (results != NULL) ? results : (JFMCopyResultPtr)malloc(sizeof(JFMCopyResult) * (size_t)n);
+	if((batch.taskList == NULL) || (batch.resultList == NULL))
+	{
+		if(batch.taskList != NULL) free(batch.taskList);
+		if((results == NULL) && (batch.resultList != NULL)) free(batch.resultList);
+		return NULL;
+	}
+
+	for(targetIndex = 0; targetIndex < n; targetIndex++)
+	{
+		CopyTaskPtr task = &(batch.taskList[targetIndex]);
+		task->file = JFMGetFile(fm, indices[targetIndex]);
+		task->destPath = destPaths[targetIndex];
+		task->size = (long long)task->file->stat.st_size;
+		task->position = targetIndex;
+	}
+
+	// 큰 파일을 나중에 시작하면 마지막에 그 파일 하나만 남아서 다른 스레드가 놀게 된다.
+	qsort(batch.taskList, (size_t)n, sizeof(CopyTask), _CompareCopyTaskSize);
+
+	long long startTime = _GetMonotonicTime();
+	_RunTasks(JFMCopyFilesTask, &batch, n, (option != NULL) ? option->threadNum : 0);
+	long long elapsedTime = _GetMonotonicTime() - startTime;
+
+	int failedNum = 0;
+	long long totalSize = 0;
+	for(targetIndex = 0; targetIndex < n; targetIndex++)
+	{
+		if(batch.resultList[targetIndex].error != 0) failedNum++;
+		else totalSize += batch.resultList[targetIndex].size;
+	}
+
+	if(summary != NULL)
+	{
+		summary->copiedNum = n - failedNum;
+		summary->failedNum = failedNum;
+		summary->totalSize = totalSize;
+		summary->elapsedTime = elapsedTime;
+		summary->throughput = (double)totalSize * 1000.0 / (double)((elapsedTime > 0) ? elapsedTime : 1);
+	}
+
+	free(batch.taskList);
+	if(results == NULL) free(batch.resultList);
+	return (failedNum == 0) ? fm : NULL;
+}
+
+/*
+ * @fn JFMPtr JFMCopyFileMulti(JFMPtr fm, int index, const char *destPaths[], int n)
+ * @brief 파일 하나를 여러 대상 경로에 복사하는 함수
+ * 원본은 블록 단위로 한 번만 읽고, 읽은 블록을 모든 대상 파일에 병렬로 쓴다.
+ * 원본과 같은 파일 시스템에 있는 대상 파일은 리플링크로 데이터 블록을 공유한다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param destPaths 대상 경로 배열(입력, 읽기 전용)
+ * @param n 대상 경로 개수(입력)
+ * @return 모든 대상에 복사하면 파일 관리 구조체의 주소, 하나라도 실패하거나 인자가 잘못되면 NULL 반환
+ */
+JFMPtr JFMCopyFileMulti(JFMPtr fm, int index, const char *destPaths[], int n)
+{
+	if((fm == NULL) || (destPaths == NULL) || (n <= 0)) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	int destIndex = 0;
+	for( ; destIndex < n; destIndex++)
+	{
+		if((destPaths[destIndex] == NULL) || (_CheckIfPath(destPaths[destIndex]) == False)) return NULL;
+	}
+
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if(JFileCopyMulti(file, destPaths, n) == NULL) return NULL;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMConcatFiles(JFMPtr fm, const int indices[], int n, const char *destPath)
+ * @brief 지정한 파일들의 내용을 순서대로 이어 붙인 새 파일을 만들고 파일 관리 구조체에 추가하는 함수
+ * 내용은 copy_file_range 와 리플링크로 커널 안에서 복사하고, 새 파일의 라인 수와 문자 개수는 입력 파일의 값으로 계산하므로 새 파일을 다시 읽지 않는다.
+ * 입력 파일이나 이미 관리 중인 파일을 대상 경로로 지정할 수 없다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param indices 이어 붙일 파일의 인덱스 번호 배열(입력, 읽기 전용, 같은 파일을 여러 번 지정 가능, 압축 파일 제외)
+ * @param n 파일 개수(입력)
+ * @param destPath 새 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMConcatFiles(JFMPtr fm, const int indices[], int n, const char *destPath)
+{
+	if((fm == NULL) || (indices == NULL) || (n <= 0)) return NULL;
+	if(JFMCheckNewPath(fm, destPath) == False) return NULL;
+
+	JFilePtr *files = (JFilePtr*)malloc(sizeof(JFilePtr) * (size_t)n);
+	if(files == NULL) return NULL;
+
+	int targetIndex = 0;
+	for( ; targetIndex < n; targetIndex++)
+	{
+		files[targetIndex] = JFMGetFile(fm, indices[targetIndex]);
+		if((files[targetIndex] == NULL) || (JFMFlush(fm, indices[targetIndex]) == NULL))
+		{
+			free(files);
+			return NULL;
+		}
+	}
+
+	JFilePtr newFile = JFileConcat(files, n, destPath);
+	free(files);
+	if(newFile == NULL) return NULL;
+
+	if(JFMAddFiles(fm, &newFile, 1) == NULL)
+	{
+		JFileDelete(&newFile);
+		return NULL;
+	}
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMSplitFile(JFMPtr fm, int index, JFMSplitMode mode, int n, const char *pattern)
+ * @brief 파일을 라인 경계에서 n 개의 조각 파일로 나누고 조각 파일들을 파일 관리 구조체에 추가하는 함수
+ * 라인 수나 크기가 비슷하도록 나누며, 자를 위치는 라인 위치 색인으로 찾고 조각은 copy_file_range 로 병렬 복사한다.
+ * 조각 파일의 라인 수와 문자 개수는 원본의 값으로 계산하므로 조각 파일을 다시 읽지 않는다.
+ * 조각 파일은 순서대로 파일 관리 구조체 끝에 추가된다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 나눌 파일의 인덱스 번호(입력, 압축 파일 제외)
+ * @param mode 나누는 기준(입력, JFMSplitMode 열거형 참고)
+ * @param n 조각 개수(입력)
+ * @param pattern 조각 파일 경로 형식 문자열(입력, 읽기 전용, 조각 번호(0 부터)를 넣을 %d 변환 하나 포함, 예: "./part_%03d.txt")
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSplitFile(JFMPtr fm, int index, JFMSplitMode mode, int n, const char *pattern)
+{
+	if((fm == NULL) || (n <= 0) || (pattern == NULL) || (_CheckSplitPattern(pattern) == False)) return NULL;
+	if((mode != JFMSplitByLine) && (mode != JFMSplitBySize)) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	char *pathBuf = (char*)malloc((size_t)n * PATH_MAX);
+	char **paths = (char**)malloc(sizeof(char*) * (size_t)n);
+	JFilePtr *pieces = (JFilePtr*)malloc(sizeof(JFilePtr) * (size_t)n);
+	if((pathBuf == NULL) || (paths == NULL) || (pieces == NULL))
+	{
+		if(pathBuf != NULL) free(pathBuf);
+		if(paths != NULL) free(paths);
+		if(pieces != NULL) free(pieces);
+		return NULL;
+	}
+
+	Bool isFailed = False;
+	int pieceIndex = 0;
+	for( ; (isFailed == False) && (pieceIndex < n); pieceIndex++)
+	{
+		paths[pieceIndex] = pathBuf + (size_t)pieceIndex * PATH_MAX;
+		if(snprintf(paths[pieceIndex], PATH_MAX, pattern, pieceIndex) >= PATH_MAX) isFailed = True;
+		else if(JFMCheckNewPath(fm, paths[pieceIndex]) == False) isFailed = True;
+	}
+
+	if((isFailed == False) && (JFMFlush(fm, index) == NULL)) isFailed = True;
+	if((isFailed == False) && (JFileSplit(file, mode, n, paths, pieces) == False)) isFailed = True;
+	if((isFailed == False) && (JFMAddFiles(fm, pieces, n) == NULL))
+	{
+		for(pieceIndex = 0; pieceIndex < n; pieceIndex++)
+		{
+			JFileDelete(&(pieces[pieceIndex]));
+		}
+		isFailed = True;
+	}
+
+	free(pieces);
+	free(paths);
+	free(pathBuf);
+	return (isFailed == True) ? NULL : fm;
+}
+
+/*
+ * @fn JFMPtr JFMSortFile(JFMPtr fm, int index, const char *destPath, const JFMSortOptionPtr option)
+ * @brief 파일의 라인을 정렬해서 새 파일에 저장하고 그 파일을 파일 관리 구조체에 추가하는 함수
+ * 메모리보다 큰 파일은 메모리 크기에 맞춰 라인 경계에서 구간(런)으로 나누고, 구간마다 병렬로 정렬해서 임시 파일에 쓴 후
+ * 패자 트리(loser tree)로 병합한다. 런이 많으면 메모리 크기 안에서 정한 개수씩 여러 단계로 나눠서 병합하므로
+ * 열린 파일 디스크립터 개수와 병합 버퍼 크기는 런 개수에 따라 늘지 않는다. 임시 파일은 결과 파일과 같은 디렉터리에 이름 없이 만든다.
+ * 라인은 바이트 순서로 비교하며, 라인 앞 8 바이트를 정수로 만들어 두고 먼저 비교한다.
+ * 결과 파일의 모든 라인은 개행 문자로 끝나고, 라인 수와 라인 위치 색인은 쓰면서 만들므로 결과 파일을 다시 읽지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 정렬할 파일의 인덱스 번호(입력, 압축 파일 제외)
+ * @param destPath 결과 파일 경로(입력, 읽기 전용, 이미 관리 중인 파일은 사용할 수 없음)
+ * @param option 정렬 방식(입력, 읽기 전용, NULL 이면 기본값 사용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSortFile(JFMPtr fm, int index, const char *destPath, const JFMSortOptionPtr option)
+{
+	if((fm == NULL) || (JFMCheckNewPath(fm, destPath) == False)) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (JFMFlush(fm, index) == NULL)) return NULL;
+
+	int flags = (option != NULL) ? option->flags : 0;
+	size_t memoryLimit = ((option != NULL) && (option->memoryLimit > 0)) ? option->memoryLimit : SORT_MEMORY_SIZE;
+	int threadNum = (option != NULL) ? option->threadNum : 0;
+
+	JFilePtr newFile = JFileSort(file, destPath, flags, memoryLimit, threadNum);
+	if(newFile == NULL) return NULL;
+
+	if(JFMAddFiles(fm, &newFile, 1) == NULL)
+	{
+		JFileDelete(&newFile);
+		return NULL;
+	}
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMRenameFilePath(JFMPtr fm, int index, const char *newFilePath)
+ * @brief 지정한 파일의 이름을 새로 설정하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param newFilePath 새로 설정할 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMRenameFilePath(JFMPtr fm, int index, const char *newFilePath)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (newFilePath == NULL)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->pack != NULL)) return NULL;
+
+	JFMPathIndexRemove(fm, file);
+	Bool isFailed = (rename(file->path, newFilePath) == -1) ? True : False;
+	if(JFileSetName(file, newFilePath) == NULL) isFailed = True;
+	JFMPathIndexAdd(fm, file, index);
+
+	return (isFailed == True) ? NULL : fm;
+}
+
+/*
+ * @fn void JFMPrintFile(const JFMPtr fm, int index)
+ * @brief 지정한 파일의 상태 및 정보를 출력하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 반환값 없음
+ */
+void JFMPrintFile(const JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return;
+	if(JFMFlush(fm, index) == NULL) return;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return;
+
+	printf("\n----------------------------------\n");
+	printf("File Name : %s\n", file->name);
+	printf("File Path : %s\n", file->path);
+	printf("File Line Count : %lld\n", file->line);
+	printf("File Char Count : %lld\n", file->totalCharCount);
+	printf("I-Node Number : %ld\n", (long)(file->stat.st_ino));
+	printf("Mode : %lo (octal)\n", (unsigned long)(file->stat.st_mode));
+	printf("Link Count : %ld\n", (long)(file->stat.st_nlink));
+	printf("Ownership : UID=%ld / GID=%ld\n", (long)(file->stat.st_uid), (long)(file->stat.st_gid));
+	printf("Preferred I/O Block Size : %ld bytes\n", (long)(file->stat.st_blksize));
+	if(file->compress != NULL)
+	{
+		printf("Logical Size : %lld bytes\n", file->compress->header.logicalSize);
+		printf("Physical Size : %lld bytes (compressed)\n", (long long)(file->stat.st_size));
+	}
+	else printf("File Size : %lld bytes\n", (long long)(file->stat.st_size));
+	if(file->pack != NULL) printf("Packed Entry : %lld (read-only)\n", file->packIndex);
+	printf("Blocks allocated %lld\n", (long long)(file->stat.st_blocks));
+	printf("Last Status Change : %s", ctime(&(file->stat.st_ctime)));
+	printf("Last File Access : %s", ctime(&(file->stat.st_atime)));
+	printf("Last File Modification : %s", ctime(&(file->stat.st_mtime)));
+	printf("----------------------------------\n");
+}
+
+/*
+ * @fn JFMPtr JFMTruncateFile(JFMPtr fm, int index, off_t length)
+ * @brief 지정한 파일의 크기를 새로 설정하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param length 새로 설정할 파일의 크기(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMTruncateFile(JFMPtr fm, int index, off_t length)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (length < 0)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->compress != NULL) || (file->pack != NULL)) return NULL;
+
+	// 늘리면 원래 파일 끝부터, 줄이면 자른 위치부터 다시 색인한다.
+	JFMIndexMarkDirty(fm, file, ((long long)length < (long long)file->stat.st_size) ? (long long)length : -1);
+	if(truncate(file->path, length) == -1)
+	{
+//		perror("truncate");
+		return NULL;
+	}
+
+	if(JFileLoad(file) == NULL) return NULL;
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMResizeFile(JFMPtr fm, int index, off_t length, int flags)
+ * @brief 지정한 파일의 크기 또는 블록 할당을 변경하는 함수
+ * JFMResizePreallocate 를 지정하면 늘어나는 구간을 fallocate 로 미리 할당해서 이후 쓰기에서 블록을 조금씩 할당하지 않게 한다.
+ * JFMResizeKeepSize 를 지정하면 파일 크기는 유지하고, 늘릴 때는 지정한 크기까지 공간을 예약하며
+ * 줄일 때는 지정한 크기 이후의 블록을 FALLOC_FL_PUNCH_HOLE 로 해제한다.
+ * 옵션이 없으면 JFMTruncateFile 과 같다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param length 새로 설정할 파일의 크기(입력)
+ * @param flags 크기 변경 방식(입력, JFMResizeFlag 값의 비트 조합)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMResizeFile(JFMPtr fm, int index, off_t length, int flags)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (length < 0)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if((flags & (JFMResizePreallocate | JFMResizeKeepSize)) == 0) return JFMTruncateFile(fm, index, length);
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->compress != NULL) || (file->pack != NULL) || (JFileUpdateStat(file) == NULL)) return NULL;
+
+	int fd = open(file->path, O_WRONLY);
+	if(fd == -1) return NULL;
+
+	off_t size = file->stat.st_size;
+	int result = 0;
+	if(((flags & JFMResizeKeepSize) == 0) || (length < size)) JFMIndexMarkDirty(fm, file, (length < size) ? (long long)length : -1);
+
+	if(flags & JFMResizeKeepSize)
+	{
+		// 같은 크기로 자르면 파일 끝 뒤에 예약된 블록이 모두 해제되므로 필요한 만큼만 다시 예약한다.
+		result = ftruncate(fd, size);
+		if((result == 0) && (length > size)) result = fallocate(fd, FALLOC_FL_KEEP_SIZE, size, length - size);
+		else if((result == 0) && (length < size)) result = fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, length, size - length);
+	}
+	else if(length > size)
+	{
+		result = fallocate(fd, 0, size, length - size);
+		// 미리 할당을 지원하지 않는 파일 시스템이면 크기만 늘린다.
+		if((result == -1) && (errno == EOPNOTSUPP)) result = ftruncate(fd, length);
+	}
+	else result = ftruncate(fd, length);
+
+	close(fd);
+	if(result == -1) return NULL;
+
+	// 크기를 유지하면서 파일 끝 뒤만 변경했으면 내용이 바뀌지 않으므로 상태 정보만 갱신한다.
+	if((flags & JFMResizeKeepSize) && (length >= size))
+	{
+		if(JFileUpdateStat(file) == NULL) return NULL;
+	}
+	else if(JFileLoad(file) == NULL) return NULL;
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMPunchHole(JFMPtr fm, int index, off_t offset, off_t length)
+ * @brief 지정한 파일의 구간을 구멍(hole)으로 만들어서 블록을 해제하는 함수
+ * 파일 크기는 유지되며, 해당 구간은 이후 0 으로 읽힌다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param offset 구멍을 만들 구간의 시작 위치(입력)
+ * @param length 구멍을 만들 구간의 길이(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMPunchHole(JFMPtr fm, int index, off_t offset, off_t length)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (offset < 0) || (length <= 0)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->compress != NULL) || (file->pack != NULL)) return NULL;
+
+	int fd = open(file->path, O_WRONLY);
+	if(fd == -1) return NULL;
+
+	int result = fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, length);
+	close(fd);
+	if(result == -1) return NULL;
+	JFMIndexMarkDirty(fm, file, (long long)offset);
+
+	if(JFileLoad(file) == NULL) return NULL;
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode)
+ * @brief 지정한 파일의 접근 방식을 새로 설정하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param mode 새로 설정할 파일 접근 방식(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (strlen(mode) != 4)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+	if(_CheckIfStringIsDigits(mode) == False) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if((file == NULL) || (file->pack != NULL)) return NULL;
+
+	long _mode = strtol(mode, 0, 8);
+	if((_mode == 0) || (_mode == LONG_MIN) || (_mode == LONG_MAX))
+	{
+//		perror("strtol");
+		return NULL;
+	}
+
+	if(chmod(file->path, _mode) == -1) return NULL;
+	if(JFileLoad(file) == NULL) return NULL;
+
+	return fm;
+}
+
+/*
+ * @fn char* JFMGetFileMode(JFMPtr fm, int index)
+ * @brief 지정한 파일의 접근 방식을 문자열로 변환해서 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 모드 문자열, 실패 시 NULL 반환
+ */
+char* JFMGetFileMode(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	// 저장 스레드가 파일 정보를 바꾸는 중일 수 있으므로 먼저 저장을 끝낸다.
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	return JFileGetMode(file);
+}
+
+/*
+ * @fn JFMPtr JFMCompressFile(JFMPtr fm, int index)
+ * @brief 지정한 파일을 블록 압축 형식으로 변환해서 저장하는 함수
+ * 변환된 파일은 JFMReadFile, JFMReadLine 으로 그대로 읽을 수 있으며, 쓰기 전에는 JFMDecompressFile 로 복원해야 한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMCompressFile(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	if(JFileCompress(file) == NULL) return NULL;
+	// 내용은 같으므로 마지막 블록만 다시 확인한다.
+	JFMIndexMarkDirty(fm, file, LLONG_MAX);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMDecompressFile(JFMPtr fm, int index)
+ * @brief 블록 압축 형식으로 저장된 파일을 일반 파일로 복원하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMDecompressFile(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+
+	if(JFileDecompress(file) == NULL) return NULL;
+	// 내용은 같으므로 마지막 블록만 다시 확인한다.
+	JFMIndexMarkDirty(fm, file, LLONG_MAX);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMSaveManifest(const JFMPtr fm, const char *manifestPath)
+ * @brief 관리 중인 파일의 경로, 상태 정보, 라인 수, 문자 개수, 라인 위치 색인을 파일 목록 저장 파일에 저장하는 함수
+ * 저장 파일은 [헤더][항목 배열][라인 위치 색인 배열][경로 문자열 테이블] 순서로 저장하며, mmap 으로 바로 읽을 수 있다.
+ * 묶음 파일의 항목은 저장하지 않는다(JFMOpenPack 으로 다시 불러온다).
+ * 같은 디렉터리의 임시 파일에 모두 쓴 후 저장 파일 경로로 교체한다.
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param manifestPath 저장 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMSaveManifest(const JFMPtr fm, const char *manifestPath)
+{
+	if((fm == NULL) || (manifestPath == NULL)) return NULL;
+	if(JFMFlushAll(fm) == NULL) return NULL;
+
+	long long entryCount = 0;
+	long long markCount = 0;
+	long long stringSize = 0;
+	int fileIndex = 0;
+	for( ; fileIndex < fm->size; fileIndex++)
+	{
+		JFilePtr file = JFMGetFile(fm, fileIndex);
+		if((file == NULL) || (file->pack != NULL)) continue;
+		entryCount++;
+		markCount += file->lineIndexSize;
+		stringSize += (long long)strlen(file->path) + 1;
+	}
+
+	ManifestHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MANIFEST_MAGIC, sizeof(header.magic));
+	header.version = MANIFEST_VERSION;
+	header.entrySize = sizeof(ManifestEntry);
+	header.entryCount = entryCount;
+	header.entryOffset = (long long)sizeof(ManifestHeader);
+	header.markOffset = header.entryOffset + entryCount * (long long)sizeof(ManifestEntry);
+	header.markCount = markCount;
+	header.stringOffset = header.markOffset + markCount * (long long)sizeof(JFileLineMark);
+	header.stringSize = stringSize;
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmmani.%ld", manifestPath, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+
+	int fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(fd == -1) return NULL;
+
+	ManifestEntryPtr entryList = (ManifestEntryPtr)calloc((size_t)entryCount + 1, sizeof(ManifestEntry));
+	char *stringTable = (char*)malloc((size_t)stringSize + 1);
+	Bool isFailed = ((entryList == NULL) || (stringTable == NULL)) ? True : False;
+
+	long long entryIndex = 0;
+	long long markIndex = 0;
+	long long stringOffset = 0;
+	for(fileIndex = 0; (isFailed == False) && (fileIndex < fm->size); fileIndex++)
+	{
+		JFilePtr file = JFMGetFile(fm, fileIndex);
+		if((file == NULL) || (file->pack != NULL)) continue;
+
+		ManifestEntryPtr entry = &(entryList[entryIndex++]);
+		entry->pathOffset = stringOffset;
+		entry->pathLength = (unsigned int)strlen(file->path);
+		entry->size = (long long)file->stat.st_size;
+		entry->mtime = (long long)file->stat.st_mtim.tv_sec;
+		entry->mtimeNsec = (long long)file->stat.st_mtim.tv_nsec;
+		entry->ino = (long long)file->stat.st_ino;
+		entry->dev = (long long)file->stat.st_dev;
+		entry->line = file->line;
+		entry->totalCharCount = file->totalCharCount;
+		entry->markIndex = markIndex;
+		entry->markCount = file->lineIndexSize;
+		entry->mode = (unsigned int)file->stat.st_mode;
+		entry->dupleNum = file->dupleNum;
+		entry->flags = (file->compress != NULL) ? MANIFEST_ENTRY_COMPRESSED : 0;
+
+		memcpy(stringTable + stringOffset, file->path, (size_t)entry->pathLength + 1);
+		stringOffset += (long long)entry->pathLength + 1;
+
+		if(file->lineIndexSize > 0)
+		{
+			size_t markSize = sizeof(JFileLineMark) * (size_t)file->lineIndexSize;
+			off_t markOffset = (off_t)(header.markOffset + markIndex * (long long)sizeof(JFileLineMark));
+			if(_WriteFull(fd, file->lineIndex, markSize, markOffset) != (ssize_t)markSize) isFailed = True;
+			markIndex += file->lineIndexSize;
+		}
+	}
+
+	if(isFailed == False)
+	{
+		size_t entrySize = sizeof(ManifestEntry) * (size_t)entryCount;
+		if((_WriteFull(fd, entryList, entrySize, (off_t)header.entryOffset) != (ssize_t)entrySize)
+			|| (_WriteFull(fd, stringTable, (size_t)stringSize, (off_t)header.stringOffset) != (ssize_t)stringSize)
+			|| (_WriteFull(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)))
+		{
+			isFailed = True;
+		}
+	}
+
+	if(entryList != NULL) free(entryList);
+	if(stringTable != NULL) free(stringTable);
+	if(close(fd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, manifestPath) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMLoadManifest(JFMPtr fm, const char *manifestPath)
+ * @brief 파일 목록 저장 파일을 읽어서 저장된 파일들을 파일 관리 구조체 객체에 추가하는 함수
+ * 저장 파일은 mmap 으로 읽고, 파일마다 stat 한 번으로 크기, 수정 시각, 아이노드, 장치 번호를 비교해서
+ * 바뀌지 않은 파일은 내용을 다시 읽지 않고 저장된 정보를 사용한다. 바뀐 파일만 다시 라인 수를 센다.
+ * 저장한 후에 삭제된 파일과 이미 관리 중인 경로의 파일은 추가하지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param manifestPath 저장 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMLoadManifest(JFMPtr fm, const char *manifestPath)
+{
+	if((fm == NULL) || (manifestPath == NULL)) return NULL;
+
+	int fd = open(manifestPath, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	FileStatus manifestStat;
+	if((fstat(fd, &manifestStat) == -1) || (manifestStat.st_size < (off_t)sizeof(ManifestHeader)))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	size_t mapSize = (size_t)manifestStat.st_size;
+	char *map = (char*)mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED) return NULL;
+	// 목차는 처음부터 한 번만 읽는다.
+	madvise(map, mapSize, MADV_SEQUENTIAL);
+
+	long long manifestSize = (long long)manifestStat.st_size;
+	ManifestHeaderPtr header = (ManifestHeaderPtr)map;
+	if((memcmp(header->magic, MANIFEST_MAGIC, sizeof(header->magic)) != 0)
+		|| (header->version != MANIFEST_VERSION)
+		|| (header->entrySize != sizeof(ManifestEntry))
+		|| (header->entryCount < 0) || (header->markCount < 0) || (header->stringSize < 0)
+		|| (header->entryOffset != (long long)sizeof(ManifestHeader))
+		|| (header->entryCount > (manifestSize - header->entryOffset) / (long long)sizeof(ManifestEntry))
+		|| (header->markOffset != header->entryOffset + header->entryCount * (long long)sizeof(ManifestEntry))
+		|| (header->markCount > (manifestSize - header->markOffset) / (long long)sizeof(JFileLineMark))
+		|| (header->stringOffset != header->markOffset + header->markCount * (long long)sizeof(JFileLineMark))
+		|| (header->stringSize > manifestSize - header->stringOffset))
+	{
+		munmap(map, mapSize);
+		return NULL;
+	}
+
+	ManifestEntryPtr entryList = (ManifestEntryPtr)(map + header->entryOffset);
+	JFileLineMarkPtr markList = (JFileLineMarkPtr)(map + header->markOffset);
+	char *stringTable = map + header->stringOffset;
+
+	JFilePtr *files = (JFilePtr*)malloc(sizeof(JFilePtr) * (size_t)(header->entryCount + 1));
+	if(files == NULL)
+	{
+		munmap(map, mapSize);
+		return NULL;
+	}
+
+	long long fileCount = 0;
+	long long entryIndex = 0;
+	for( ; entryIndex < header->entryCount; entryIndex++)
+	{
+		ManifestEntryPtr entry = &(entryList[entryIndex]);
+
+		// 잘못된 항목으로 매핑 밖을 읽지 않도록 구간을 검사한다.
+		if((entry->pathOffset < 0) || ((long long)entry->pathLength >= header->stringSize - entry->pathOffset)
+			|| (stringTable[entry->pathOffset + entry->pathLength] != '\0')
+			|| (entry->markIndex < 0) || (entry->markCount < 0)
+			|| (entry->markCount > header->markCount - entry->markIndex))
+		{
+			continue;
+		}
+
+		char *path = stringTable + entry->pathOffset;
+		if((fm->size > 1) && (JFMFindFileByPath(fm, path) != NULL)) continue;
+
+		JFilePtr file = JFileNewFromManifest(path, entry, markList + entry->markIndex);
+		if(file != NULL) files[fileCount++] = file;
+	}
+
+	munmap(map, mapSize);
+
+	if(JFMAddFiles(fm, files, fileCount) == NULL)
+	{
+		while(fileCount > 0)
+		{
+			fileCount--;
+			JFileDelete(&(files[fileCount]));
+		}
+		free(files);
+		return NULL;
+	}
+
+	free(files);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMPack(JFMPtr fm, const int indices[], int n, const char *packPath)
+ * @brief 지정한 파일들의 내용을 하나의 묶음 파일로 저장하는 함수
+ * 묶음 파일은 [헤더][파일 내용...][목차][경로 문자열 테이블] 순서로 저장하며, 목차에는 항목마다 경로, 위치, 크기, 상태 정보, 라인 수를 기록한다.
+ * 압축 파일은 압축 해제된 내용을 저장하고, 나머지 파일은 copy_file_range 로 복사한다.
+ * 같은 디렉터리의 임시 파일에 모두 쓴 후 묶음 파일 경로로 교체한다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param indices 저장할 파일의 인덱스 번호 배열(입력, 읽기 전용)
+ * @param n 인덱스 번호 배열의 크기(입력)
+ * @param packPath 생성할 묶음 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMPack(JFMPtr fm, const int indices[], int n, const char *packPath)
+{
+	if((fm == NULL) || (indices == NULL) || (n <= 0) || (packPath == NULL)) return NULL;
+
+	long long stringSize = 0;
+	int targetIndex = 0;
+	for( ; targetIndex < n; targetIndex++)
+	{
+		if(JFMFlush(fm, indices[targetIndex]) == NULL) return NULL;
+		JFilePtr file = JFMGetFile(fm, indices[targetIndex]);
+		if((file == NULL) || ((file->stat.st_mode & S_IFMT) != S_IFREG)) return NULL;
+		stringSize += (long long)strlen(file->path) + 1;
+	}
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmpack.%ld", packPath, (long)getpid()) >= (int)sizeof(tempPath)) return NULL;
+
+	int packFd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(packFd == -1) return NULL;
+
+	PackEntryPtr entryList = (PackEntryPtr)calloc((size_t)n, sizeof(PackEntry));
+	char *stringTable = (char*)malloc((size_t)stringSize);
+	char *buf = NULL;
+	long long offset = (long long)sizeof(PackHeader);
+	long long stringOffset = 0;
+	Bool isFailed = ((entryList == NULL) || (stringTable == NULL)) ? True : False;
+
+	for(targetIndex = 0; (isFailed == False) && (targetIndex < n); targetIndex++)
+	{
+		JFilePtr file = JFMGetFile(fm, indices[targetIndex]);
+		PackEntryPtr entry = &(entryList[targetIndex]);
+		long long length = JFileGetSize(file);
+
+		entry->offset = offset;
+		entry->length = length;
+		entry->pathOffset = stringOffset;
+		entry->pathLength = (unsigned int)strlen(file->path);
+		entry->line = file->line;
+		entry->totalCharCount = file->totalCharCount;
+		entry->atime = (long long)file->stat.st_atim.tv_sec;
+		entry->atimeNsec = (long long)file->stat.st_atim.tv_nsec;
+		entry->mtime = (long long)file->stat.st_mtim.tv_sec;
+		entry->mtimeNsec = (long long)file->stat.st_mtim.tv_nsec;
+		entry->ctime = (long long)file->stat.st_ctim.tv_sec;
+		entry->ctimeNsec = (long long)file->stat.st_ctim.tv_nsec;
+		entry->mode = (unsigned int)file->stat.st_mode;
+		entry->uid = (unsigned int)file->stat.st_uid;
+		entry->gid = (unsigned int)file->stat.st_gid;
+
+		memcpy(stringTable + stringOffset, file->path, (size_t)entry->pathLength + 1);
+		stringOffset += (long long)entry->pathLength + 1;
+
+		int fd = -1;
+		if((file->pack == NULL) && ((fd = open(file->path, O_RDONLY)) == -1))
+		{
+			isFailed = True;
+			break;
+		}
+
+		if((file->compress == NULL) && (file->pack == NULL))
+		{
+			if(_CopyRangeTo(fd, 0, packFd, (off_t)offset, (off_t)length) == -1) isFailed = True;
+		}
+		else
+		{
+			// 압축 파일과 다른 묶음 파일의 항목은 논리 내용을 읽어서 저장한다.
+			long long readOffset = 0;
+			if((buf == NULL) && ((buf = (char*)malloc(READ_BUF_SIZE)) == NULL)) isFailed = True;
+			while((isFailed == False) && (readOffset < length))
+			{
+				ssize_t readSize = JFileReadAt(file, fd, buf, READ_BUF_SIZE, (off_t)readOffset);
+				if((readSize <= 0) || (_WriteFull(packFd, buf, (size_t)readSize, (off_t)(offset + readOffset)) != readSize)) isFailed = True;
+				else readOffset += readSize;
+			}
+		}
+
+		if(fd != -1) close(fd);
+		offset += length;
+	}
+
+	PackHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, PACK_MAGIC, sizeof(header.magic));
+	header.version = PACK_VERSION;
+	header.entrySize = sizeof(PackEntry);
+	header.entryCount = n;
+	// 목차를 구조체 배열로 바로 읽을 수 있도록 정렬한다.
+	header.tocOffset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+	header.stringOffset = header.tocOffset + (long long)n * (long long)sizeof(PackEntry);
+	header.stringSize = stringSize;
+
+	if(isFailed == False)
+	{
+		size_t tocSize = sizeof(PackEntry) * (size_t)n;
+		if((_WriteFull(packFd, entryList, tocSize, (off_t)header.tocOffset) != (ssize_t)tocSize)
+			|| (_WriteFull(packFd, stringTable, (size_t)stringSize, (off_t)header.stringOffset) != (ssize_t)stringSize)
+			|| (_WriteFull(packFd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)))
+		{
+			isFailed = True;
+		}
+	}
+
+	if(entryList != NULL) free(entryList);
+	if(stringTable != NULL) free(stringTable);
+	if(buf != NULL) free(buf);
+	if(close(packFd) == -1) isFailed = True;
+
+	if((isFailed == True) || (rename(tempPath, packPath) == -1))
+	{
+		unlink(tempPath);
+		return NULL;
+	}
+
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMUnpack(JFMPtr fm, const char *packPath, const char *destDir)
+ * @brief 묶음 파일의 모든 항목을 파일로 풀어서 파일 관리 구조체 객체에 추가하는 함수
+ * 대상 디렉터리가 NULL 이면 목차에 저장된 원래 경로에 풀고, 아니면 대상 디렉터리 아래에 같은 이름으로 푼다.
+ * 풀 경로가 서로 겹치는 항목이 있으면(예: 다른 디렉터리의 같은 이름 파일을 대상 디렉터리에 풀 때) 아무것도 풀지 않고 실패한다.
+ * 풀린 파일에는 저장된 접근 권한과 접근, 수정 시각을 다시 설정한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param packPath 묶음 파일 경로(입력, 읽기 전용)
+ * @param destDir 파일을 풀 디렉터리 경로(입력, 읽기 전용, NULL 이면 원래 경로)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMUnpack(JFMPtr fm, const char *packPath, const char *destDir)
+{
+	if((fm == NULL) || (packPath == NULL)) return NULL;
+
+	struct _jfile_pack_t *pack = JFilePackOpen(packPath);
+	if(pack == NULL) return NULL;
+
+	long long entryCount = pack->header->entryCount;
+	JFilePtr *files = (JFilePtr*)calloc((size_t)entryCount + 1, sizeof(JFilePtr));
+	Bool isFailed = (files == NULL) ? True : False;
+
+	// 파일을 쓰기 전에 풀 경로끼리 겹치지 않는지 확인한다. 대상 디렉터리가 있으면 파일 이름만 비교하면 된다.
+	long long entryIndex = 0;
+	if((isFailed == False) && (entryCount > 1))
+	{
+		const char **nameList = (const char**)malloc(sizeof(const char*) * (size_t)entryCount);
+		if(nameList == NULL) isFailed = True;
+		for( ; (isFailed == False) && (entryIndex < entryCount); entryIndex++)
+		{
+			const char *path = pack->stringTable + pack->entryList[entryIndex].pathOffset;
+			const char *name = (destDir != NULL) ? strrchr(path, '/') : NULL;
+			nameList[entryIndex] = (name == NULL) ? path : name + 1;
+		}
+		if((isFailed == False) && (_CheckUniqueStrings(nameList, entryCount) == False)) isFailed = True;
+		free(nameList);
+	}
+
+	for(entryIndex = 0; (isFailed == False) && (entryIndex < entryCount); entryIndex++)
+	{
+		PackEntryPtr entry = &(pack->entryList[entryIndex]);
+		char *path = pack->stringTable + entry->pathOffset;
+		char destPath[PATH_MAX];
+
+		if(destDir != NULL)
+		{
+			char *name = strrchr(path, '/');
+			if(snprintf(destPath, sizeof(destPath), "%s/%s", destDir, (name == NULL) ? path : name + 1) >= (int)sizeof(destPath))
+			{
+				isFailed = True;
+				break;
+			}
+		}
+		else if(snprintf(destPath, sizeof(destPath), "%s", path) >= (int)sizeof(destPath))
+		{
+			isFailed = True;
+			break;
+		}
+
+		// 이미 관리 중인 경로에는 풀지 않는다.
+		if((fm->size > 1) && (JFMFindFileByPath(fm, destPath) != NULL))
+		{
+			isFailed = True;
+			break;
+		}
+
+		int fd = open(destPath, O_WRONLY | O_CREAT | O_TRUNC, entry->mode & 07777);
+		if(fd == -1)
+		{
+			isFailed = True;
+			break;
+		}
+
+		struct timespec times[2];
+		times[0].tv_sec = (time_t)entry->atime;
+		times[0].tv_nsec = (long)entry->atimeNsec;
+		times[1].tv_sec = (time_t)entry->mtime;
+		times[1].tv_nsec = (long)entry->mtimeNsec;
+
+		if((_CopyRangeTo(pack->fd, (off_t)entry->offset, fd, 0, (off_t)entry->length) == -1)
+			|| (ftruncate(fd, (off_t)entry->length) == -1)
+			|| (fchmod(fd, entry->mode & 07777) == -1)
+			|| (futimens(fd, times) == -1))
+		{
+			isFailed = True;
+		}
+		if(close(fd) == -1) isFailed = True;
+
+		if(isFailed == False)
+		{
+			files[entryIndex] = JFileNew(destPath, fm->accessPolicy);
+			if(files[entryIndex] == NULL) isFailed = True;
+		}
+	}
+
+	JFilePackRelease(pack);
+
+	if((isFailed == False) && (JFMAddFiles(fm, files, entryCount) == NULL)) isFailed = True;
+	if(isFailed == True)
+	{
+		if(files != NULL)
+		{
+			for(entryIndex = 0; entryIndex < entryCount; entryIndex++)
+			{
+				JFileDelete(&(files[entryIndex]));
+			}
+			free(files);
+		}
+		return NULL;
+	}
+
+	free(files);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMOpenPack(JFMPtr fm, const char *packPath)
+ * @brief 묶음 파일을 풀지 않고 모든 항목을 읽기 전용 파일로 파일 관리 구조체 객체에 추가하는 함수
+ * 묶음 파일은 한 번 열어서 전체를 mmap 으로 매핑하고, 항목마다 파일을 열거나 stat 을 호출하지 않는다.
+ * 추가된 파일은 JFMReadFile, JFMReadLine, JFMCopyFile 로 읽을 수 있으며, 내용이나 속성을 바꾸는 함수는 실패한다.
+ * 매핑은 마지막 항목이 삭제될 때 해제된다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param packPath 묶음 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMOpenPack(JFMPtr fm, const char *packPath)
+{
+	if((fm == NULL) || (packPath == NULL)) return NULL;
+
+	struct _jfile_pack_t *pack = JFilePackOpen(packPath);
+	if(pack == NULL) return NULL;
+
+	long long entryCount = pack->header->entryCount;
+	if(entryCount == 0)
+	{
+		JFilePackRelease(pack);
+		return fm;
+	}
+
+	JFilePtr *files = (JFilePtr*)malloc(sizeof(JFilePtr) * (size_t)entryCount);
+	if(files == NULL)
+	{
+		JFilePackRelease(pack);
+		return NULL;
+	}
+
+	// 항목이 하나라도 만들어지면 마지막 항목이 삭제될 때 매핑이 해제된다.
+	long long entryIndex = 0;
+	for( ; entryIndex < entryCount; entryIndex++)
+	{
+		files[entryIndex] = JFileNewFromPack(pack, entryIndex);
+		if(files[entryIndex] == NULL) break;
+	}
+
+	if((entryIndex < entryCount) || (JFMAddFiles(fm, files, entryCount) == NULL))
+	{
+		if(entryIndex == 0) JFilePackRelease(pack);
+		while(entryIndex > 0)
+		{
+			entryIndex--;
+			JFileDelete(&(files[entryIndex]));
+		}
+		free(files);
+		return NULL;
+	}
+
+	free(files);
+	return fm;
+}
+
+/*
+ * @fn JFMPtr JFMDedupe(JFMPtr fm, const int indices[], int n, JFMDedupePolicy policy)
+ * @brief 지정한 파일들 중 내용이 같은 파일을 찾아서 저장 공간을 공유하도록 교체하는 함수
+ * 먼저 나온 파일을 원본으로 유지하고, 뒤에 나온 중복 파일을 원본의 리플링크 또는 하드링크로 교체한다.
+ * 교체된 파일의 상태 정보는 다시 수집하고, 내용이 같으므로 라인 수와 문자 개수는 그대로 유지한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param indices 검사할 파일의 인덱스 번호 배열(입력, 읽기 전용)
+ * @param n 인덱스 번호 배열의 크기(입력)
+ * @param policy 중복 파일 교체 방식(입력, JFMDedupePolicy 열거형 참고)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMDedupe(JFMPtr fm, const int indices[], int n, JFMDedupePolicy policy)
+{
+	if((fm == NULL) || (indices == NULL) || (n <= 0)) return NULL;
+	if((policy != JFMDedupeReflink) && (policy != JFMDedupeHardlink) && (policy != JFMDedupeAuto)) return NULL;
+
+	int targetIndex = 0;
+	for( ; targetIndex < n; targetIndex++)
+	{
+		if(JFMGetFile(fm, indices[targetIndex]) == NULL) return NULL;
+		if(JFMFlush(fm, indices[targetIndex]) == NULL) return NULL;
+		// 묶음 파일의 항목은 경로에 실제 파일이 없으므로 교체할 수 없다.
+		if(JFMGetFile(fm, indices[targetIndex])->pack != NULL) return NULL;
+		// 비교 전에 크기와 아이노드 정보를 최신 상태로 맞춘다.
+		if(JFileUpdateStat(JFMGetFile(fm, indices[targetIndex])) == NULL) return NULL;
+	}
+
+	for(targetIndex = 1; targetIndex < n; targetIndex++)
+	{
+		JFilePtr target = JFMGetFile(fm, indices[targetIndex]);
+		if((target->stat.st_mode & S_IFMT) != S_IFREG) continue;
+
+		int originIndex = 0;
+		for( ; originIndex < targetIndex; originIndex++)
+		{
+			JFilePtr origin = JFMGetFile(fm, indices[originIndex]);
+			if(origin == target) break;
+			if((origin->stat.st_mode & S_IFMT) != S_IFREG) continue;
+			if(origin->stat.st_size != target->stat.st_size) continue;
+
+			// 이미 같은 아이노드를 가리키면 회수할 공간이 없다.
+			if((origin->stat.st_dev == target->stat.st_dev) && (origin->stat.st_ino == target->stat.st_ino)) break;
+			if(_CompareFileContents(origin->path, target->path) == False) continue;
+
+			int result = -1;
+			if((policy == JFMDedupeReflink) || (policy == JFMDedupeAuto))
+			{
+				result = _ReflinkFile(origin->path, target->path);
+			}
+			if((result == -1) && ((policy == JFMDedupeHardlink) || (policy == JFMDedupeAuto)))
+			{
+				result = _HardlinkFile(origin->path, target->path);
+			}
+			if(result == -1) return NULL;
+
+			if(JFileUpdateStat(origin) == NULL) return NULL;
+			if(JFileUpdateStat(target) == NULL) return NULL;
+			break;
+		}
+	}
+
+	return fm;
+}
+
+/*
+ * @fn JFMEditPtr JFMEditOpen(JFMPtr fm, int index)
+ * @brief 지정한 파일을 라인 단위로 편집하기 위한 편집 정보를 생성하는 함수
+ * 편집 내용은 원본 파일의 구간과 추가 버퍼의 구간을 가리키는 조각 목록(조각 테이블)으로 관리하므로,
+ * 라인을 추가, 변경, 삭제해도 JFMEditCommit 전까지는 파일을 다시 읽거나 쓰지 않는다.
+ * @param fm 파일 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 생성된 편집 정보의 주소(JFMEditClose 로 해제), 실패 시 NULL 반환
+ */
+JFMEditPtr JFMEditOpen(JFMPtr fm, int index)
+{
+	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	if(JFMFlush(fm, index) == NULL) return NULL;
+
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return NULL;
+	// 압축 파일은 복원한 후에 편집해야 하고, 묶음 파일의 항목은 읽기 전용이다.
+	if((file->compress != NULL) || (file->pack != NULL)) return NULL;
+
+	JFMEditPtr edit = (JFMEditPtr)malloc(sizeof(JFMEdit));
+	if(edit == NULL) return NULL;
+
+	edit->fm = fm;
+	edit->file = file;
+	edit->index = index;
+	edit->pieceList = NULL;
+	edit->pieceNum = 0;
+	edit->pieceCapacity = 0;
+	edit->addBuffer = NULL;
+	edit->addSize = 0;
+	edit->addCapacity = 0;
+	edit->lineNum = 0;
+	edit->isLastLineOpen = False;
+	edit->buf = (char*)malloc(READ_BUF_SIZE);
+	edit->fd = open(file->path, O_RDONLY);
+
+	if((edit->buf == NULL) || (edit->fd == -1) || (JFMEditReset(edit) == NULL))
+	{
+		JFMEditClose(&edit);
+		return NULL;
+	}
+
+	return edit;
+}
+
+/*
+ * @fn void JFMEditClose(JFMEditPtrContainer editContainer)
+ * @brief 편집 정보를 해제하는 함수(반영하지 않은 편집 내용은 버린다)
+ * @param editContainer 편집 정보의 주소를 저장한 변수의 주소(출력)
+ * @return 반환값 없음
+ */
+void JFMEditClose(JFMEditPtrContainer editContainer)
+{
+	if((editContainer == NULL) || (*editContainer == NULL)) return;
+
+	JFMEditPtr edit = *editContainer;
+	if(edit->fd != -1) close(edit->fd);
+	if(edit->pieceList != NULL) free(edit->pieceList);
+	if(edit->addBuffer != NULL) free(edit->addBuffer);
+	if(edit->buf != NULL) free(edit->buf);
+
+	free(edit);
+	*editContainer = NULL;
+}
+
+/*
+ * @fn long long JFMEditGetLineNum(const JFMEditPtr edit)
+ * @brief 편집한 내용의 전체 라인 개수를 반환하는 함수
+ * @param edit 편집 정보의 주소(입력, 읽기 전용)
+ * @return 성공 시 라인 개수, 실패 시 -1 반환
+ */
+long long JFMEditGetLineNum(const JFMEditPtr edit)
+{
+	if(edit == NULL) return -1;
+	return edit->lineNum;
+}
+
+/*
+ * @fn JFMEditPtr JFMEditInsertLine(JFMEditPtr edit, long long lineNumber, const char *line)
+ * @brief 지정한 라인 번호 위치에 라인을 추가하는 함수
+ * 추가한 라인은 항상 개행 문자로 끝나며, 개행 문자가 없으면 붙인다. 문자열 안에 개행 문자가 있으면 여러 라인으로 추가된다.
+ * @param edit 편집 정보의 주소(출력)
+ * @param lineNumber 추가할 위치의 라인 번호(입력, 0 부터 전체 라인 개수까지, 전체 라인 개수이면 끝에 추가)
+ * @param line 추가할 라인 문자열(입력, 읽기 전용)
+ * @return 성공 시 편집 정보의 주소, 실패 시 NULL 반환
+ */
+JFMEditPtr JFMEditInsertLine(JFMEditPtr edit, long long lineNumber, const char *line)
+{
+	if((edit == NULL) || (line == NULL) || (lineNumber < 0) || (lineNumber > edit->lineNum)) return NULL;
+
+	// 개행 문자로 끝나지 않은 마지막 라인 뒤에 추가하면 두 라인이 합쳐지므로 먼저 개행 문자를 붙인다.
+	if((lineNumber == edit->lineNum) && (edit->isLastLineOpen == True))
+	{
+		if(JFMEditCloseLastLine(edit) == False) return NULL;
+	}
+
+	long long pieceIndex = JFMEditSplit(edit, lineNumber);
+	if(pieceIndex < 0) return NULL;
+
+	EditPiece piece;
+	if(JFMEditAddText(edit, line, &piece) == False) return NULL;
+	if(JFMEditInsertPiece(edit, pieceIndex, &piece) == False) return NULL;
+
+	edit->lineNum += piece.lineNum;
+	return edit;
+}
+
+/*
+ * @fn JFMEditPtr JFMEditReplaceLine(JFMEditPtr edit, long long lineNumber, const char *line)
+ * @brief 지정한 라인을 새 라인으로 바꾸는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @param lineNumber 바꿀 라인 번호(입력, 0 부터 시작)
+ * @param line 새 라인 문자열(입력, 읽기 전용, 개행 문자가 없으면 붙임)
+ * @return 성공 시 편집 정보의 주소, 실패 시 NULL 반환
+ */
+JFMEditPtr JFMEditReplaceLine(JFMEditPtr edit, long long lineNumber, const char *line)
+{
+	if((edit == NULL) || (line == NULL) || (lineNumber < 0) || (lineNumber >= edit->lineNum)) return NULL;
+
+	long long startIndex = JFMEditSplit(edit, lineNumber);
+	if(startIndex < 0) return NULL;
+	long long endIndex = JFMEditSplit(edit, lineNumber + 1);
+	if(endIndex < 0) return NULL;
+
+	EditPiece piece;
+	if(JFMEditAddText(edit, line, &piece) == False) return NULL;
+
+	// 라인 하나는 조각 하나 이상이므로 첫 조각 자리에 새 조각을 넣고 나머지는 지운다.
+	edit->pieceList[startIndex] = piece;
+	JFMEditRemovePieces(edit, startIndex + 1, endIndex);
+
+	// 마지막 라인을 바꾸면 새 라인은 개행 문자로 끝난다.
+	if(lineNumber == edit->lineNum - 1) edit->isLastLineOpen = False;
+	edit->lineNum += piece.lineNum - 1;
+	return edit;
+}
+
+/*
+ * @fn JFMEditPtr JFMEditDeleteLine(JFMEditPtr edit, long long lineNumber)
+ * @brief 지정한 라인을 삭제하는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @param lineNumber 삭제할 라인 번호(입력, 0 부터 시작)
+ * @return 성공 시 편집 정보의 주소, 실패 시 NULL 반환
+ */
+JFMEditPtr JFMEditDeleteLine(JFMEditPtr edit, long long lineNumber)
+{
+	if((edit == NULL) || (lineNumber < 0) || (lineNumber >= edit->lineNum)) return NULL;
+
+	long long startIndex = JFMEditSplit(edit, lineNumber);
+	if(startIndex < 0) return NULL;
+	long long endIndex = JFMEditSplit(edit, lineNumber + 1);
+	if(endIndex < 0) return NULL;
+
+	JFMEditRemovePieces(edit, startIndex, endIndex);
+
+	edit->lineNum--;
+	// 마지막 라인을 지우면 남은 마지막 라인은 개행 문자로 끝난다.
+	if(lineNumber == edit->lineNum) edit->isLastLineOpen = False;
+	return edit;
+}
+
+/*
+ * @fn JFMPtr JFMEditCommit(JFMEditPtr edit)
+ * @brief 편집한 내용을 파일에 반영하는 함수
+ * 앞쪽과 뒤쪽에서 원래 위치 그대로인 원본 조각은 건너뛰고, 그 사이의 바뀐 구간만 임시 파일에 모은 후 제자리에 쓴다.
+ * 라인 수와 문자 개수는 조각 정보로 구하고, 라인 위치 색인은 원본 조각 안의 색인 위치를 옮겨서 만들므로 파일을 다시 읽지 않는다.
+ * 반영한 후에는 바뀐 파일을 원본으로 편집을 이어서 할 수 있다.
+ * 편집하는 동안 파일이 다른 곳에서 바뀌었거나(쓰기 지연으로 대기 중인 내용 포함) 다른 파일로 바뀌었으면 반영하지 않는다.
+ * @param edit 편집 정보의 주소(출력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+JFMPtr JFMEditCommit(JFMEditPtr edit)
+{
+	if(edit == NULL) return NULL;
+
+	// 쓰기 대기 내용을 먼저 저장해야 아래 검사에서 바뀐 것으로 보고 덮어쓰지 않는다.
+	JFilePtr file = edit->file;
+	if((JFMGetFile(edit->fm, edit->index) != file) || (JFMFlush(edit->fm, edit->index) == NULL)) return NULL;
+
+	// 경로가 다른 파일(inode)로 바뀌었을 수 있으므로, 실제로 쓸 파일 디스크립터로 편집을 시작할 때의 파일과 같은지 확인한다.
+	FileStatus fileStat;
+	int writeFd = open(file->path, O_WRONLY);
+	if(writeFd == -1) return NULL;
+	if((fstat(writeFd, &fileStat) == -1)
+		|| (fileStat.st_dev != edit->stat.st_dev)
+		|| (fileStat.st_ino != edit->stat.st_ino)
+		|| (fileStat.st_size != edit->stat.st_size)
+		|| (fileStat.st_mtim.tv_sec != edit->stat.st_mtim.tv_sec)
+		|| (fileStat.st_mtim.tv_nsec != edit->stat.st_mtim.tv_nsec))
+	{
+		close(writeFd);
+		return NULL;
+	}
+
+	long long oldSize = (long long)edit->stat.st_size;
+	long long newSize = 0;
+	long long pieceIndex = 0;
+	for( ; pieceIndex < edit->pieceNum; pieceIndex++)
+	{
+		newSize += edit->pieceList[pieceIndex].length;
+	}
+
+	// 앞쪽에서 원래 위치 그대로인 원본 조각
+	long long changeStart = 0;
+	long long startIndex = 0;
+	while((startIndex < edit->pieceNum) && (edit->pieceList[startIndex].isOriginal == True) && (edit->pieceList[startIndex].offset == changeStart))
+	{
+		changeStart += edit->pieceList[startIndex].length;
+		startIndex++;
+	}
+
+	// 뒤쪽에서 원래 위치 그대로인 원본 조각
+	long long changeEnd = newSize;
+	long long endIndex = edit->pieceNum;
+	while((endIndex > startIndex) && (edit->pieceList[endIndex - 1].isOriginal == True) && (edit->pieceList[endIndex - 1].offset == changeEnd - edit->pieceList[endIndex - 1].length))
+	{
+		changeEnd -= edit->pieceList[endIndex - 1].length;
+		endIndex--;
+	}
+
+	if((changeStart == changeEnd) && (newSize == oldSize))
+	{
+		close(writeFd);
+		return edit->fm;
+	}
+
+	// 원본 조각 안의 라인 위치 색인을 바뀐 위치로 옮긴다(원본 조각은 서로 겹치지 않으므로 개수는 늘지 않음).
+	JFileLineMarkPtr markList = NULL;
+	long long markCount = 0;
+	if(file->lineIndexSize > 0)
+	{
+		markList = (JFileLineMarkPtr)malloc(sizeof(JFileLineMark) * (size_t)file->lineIndexSize);
+		if(markList == NULL)
+		{
+			close(writeFd);
+			return NULL;
+		}
+	}
+
+	long long lineBefore = 0;
+	long long docOffset = 0;
+	for(pieceIndex = 0; pieceIndex < edit->pieceNum; pieceIndex++)
+	{
+		EditPiecePtr piece = &(edit->pieceList[pieceIndex]);
+		if((piece->isOriginal == True) && (markList != NULL))
+		{
+			JFileLineMarkPtr mark = JFileFindLineMark(file, piece->firstLine);
+			long long markIndex = (mark == NULL) ? 0 : (long long)(mark - file->lineIndex);
+			for( ; (markIndex < file->lineIndexSize) && (file->lineIndex[markIndex].offset < piece->offset + piece->length); markIndex++)
+			{
+				if(file->lineIndex[markIndex].offset < piece->offset) continue;
+				markList[markCount].line = file->lineIndex[markIndex].line - piece->firstLine + lineBefore;
+				markList[markCount].offset = file->lineIndex[markIndex].offset - piece->offset + docOffset;
+				markCount++;
+			}
+		}
+		lineBefore += piece->lineNum;
+		docOffset += piece->length;
+	}
+
+	// 바뀐 구간은 아직 읽지 않은 원본 내용을 덮어쓰지 않도록 임시 파일에 먼저 모은다.
+	Bool isFailed = False;
+	int tempFd = _OpenTempFile(file->path);
+	if(tempFd == -1) isFailed = True;
+
+	long long tempOffset = 0;
+	for(pieceIndex = startIndex; (isFailed == False) && (pieceIndex < endIndex); pieceIndex++)
+	{
+		EditPiecePtr piece = &(edit->pieceList[pieceIndex]);
+		if(piece->isOriginal == True)
+		{
+			if(_CopyRangeTo(edit->fd, (off_t)piece->offset, tempFd, (off_t)tempOffset, (off_t)piece->length) == -1) isFailed = True;
+		}
+		else if(_WriteFull(tempFd, edit->addBuffer + piece->offset, (size_t)piece->length, (off_t)tempOffset) != (ssize_t)piece->length) isFailed = True;
+		tempOffset += piece->length;
+	}
+
+	if((isFailed == False) && (_CopyRangeTo(tempFd, 0, writeFd, (off_t)changeStart, (off_t)(changeEnd - changeStart)) == -1)) isFailed = True;
+	if((isFailed == False) && (newSize != oldSize) && (ftruncate(writeFd, (off_t)newSize) == -1)) isFailed = True;
+	if((isFailed == False) && (fstat(writeFd, &fileStat) == -1)) isFailed = True;
+	if(tempFd != -1) close(tempFd);
+	if(close(writeFd) == -1) isFailed = True;
+
+	// 일부만 썼을 수 있으므로 실패해도 바뀐 위치부터 다시 색인한다.
+	JFMIndexMarkDirty(edit->fm, file, changeStart);
+	if(isFailed == True)
+	{
+		if(markList != NULL) free(markList);
+		// 일부만 썼을 수 있으므로 파일 정보를 다시 읽는다.
+		JFileLoad(file);
+		return NULL;
+	}
+
+	long long newlineCount = edit->lineNum - ((edit->isLastLineOpen == True) ? 1 : 0);
+	JFileDataListFree(file);
+	Bool isIndexSet = JFileSetLineIndex(file, markList, markCount);
+	if(markList != NULL) free(markList);
+	file->line = edit->lineNum;
+	file->totalCharCount = newSize - newlineCount;
+	file->stat = fileStat;
+	file->followOffset = -1;
+	file->followLine = 0;
+	if((isIndexSet == False) || (JFileGetMode(file) == NULL)) return NULL;
+
+	if(JFMEditReset(edit) == NULL) return NULL;
+	return edit->fm;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Static Functions for JFileManager
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * @fn static Bool JFMCheckIndex(const JFMPtr fm, int index)
+ * @brief 지정한 인덱스의 경계를 검사하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMCheckIndex(const JFMPtr fm, int index)
+{
+	if((index < 0) || (index >= fm->size)) return False;
+	return True;
+}
+
+/*
+ * @fn static FileType JFMCheckFileType(const JFMPtr fm, int index)
+ * @brief 지정한 파일 유형을 검사하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 성공 시 파일 유형, 실패 시 Unknown 반환(FileType 열거형 참고)
+ */
+static FileType JFMCheckFileType(const JFMPtr fm, int index)
+{
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return;
+
+	switch(file->stat.st_mode & S_IFMT)
+	{
+		case S_IFREG: return Regular;
+		case S_IFDIR: return Directory;
+		case S_IFCHR: return CharDevice;
+		case S_IFBLK: return BlockDevice;
+		case S_IFIFO: return Pipe;
+		case S_IFLNK: return SymbolicLink;
+		case S_IFSOCK: return Socket;
+	}
+	return Unknown;
+}
+
+/*
+ * @fn static int JFMFindEmptyFileIndex(const JFMPtr fm)
+ * @brief 비어있는 파일 인덱스를 반환하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 파일 인덱스, 실패 시 -1 반환
+ */
+static int JFMFindEmptyFileIndex(const JFMPtr fm)
+{
+	int fileIndex = 0;
+	for( ; fileIndex < fm->size; fileIndex++)
+	{
+		if(fm->fileContainer[fileIndex] == NULL) return fileIndex;
+	}
+	return -1;
+}
+
+/*
+ * @fn static JFMPtr JFMAddFiles(JFMPtr fm, JFilePtr files[], long long n)
+ * @brief 이미 생성된 파일 정보 관리 구조체 객체들을 파일 관리 구조체 객체 끝에 한 번에 추가하는 함수
+ * 파일 관리 배열은 한 번만 늘리며, 이미 관리 중인 경로와 겹치거나 추가할 파일끼리 경로가 겹치면 아무것도 추가하지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param files 추가할 파일 정보 관리 구조체 객체 배열(입력, 성공 시 소유권이 넘어감)
+ * @param n 추가할 파일 개수(입력)
+ * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ */
+static JFMPtr JFMAddFiles(JFMPtr fm, JFilePtr files[], long long n)
+{
+	if((files == NULL) || (n < 0) || ((long long)fm->size + n > INT_MAX)) return NULL;
+	if(n == 0) return fm;
+
+	// 중복 불허, 같은 파일을 동시에 사용할 수 없음
+	if(fm->size > 1)
+	{
+		long long fileIndex = 0;
+		for( ; fileIndex < n; fileIndex++)
+		{
+			if(JFMFindFileByPath(fm, files[fileIndex]->path) != NULL) return NULL;
+		}
+	}
+
+	// 한 번에 추가하는 파일끼리도 경로가 겹치면 안 된다.
+	if(n > 1)
+	{
+		const char **pathList = (const char**)malloc(sizeof(const char*) * (size_t)n);
+		if(pathList == NULL) return NULL;
+
+		long long pathIndex = 0;
+		for( ; pathIndex < n; pathIndex++)
+		{
+			pathList[pathIndex] = files[pathIndex]->path;
+		}
+
+		Bool isUnique = _CheckUniqueStrings(pathList, n);
+		free(pathList);
+		if(isUnique == False) return NULL;
+	}
+
+	JFilePtrContainer newContainer = (JFilePtrContainer)realloc(fm->fileContainer, sizeof(JFilePtr) * (size_t)(fm->size + n));
+	if(newContainer == NULL) return NULL;
+	fm->fileContainer = newContainer;
+
+	// 새로 추가하는 파일에는 관리 구조체에 설정한 접근 방식을 적용한다.
+	long long policyIndex = 0;
+	for( ; policyIndex < n; policyIndex++)
+	{
+		files[policyIndex]->accessPolicy = fm->accessPolicy;
+	}
+
+	// 마지막 NULL 위치부터 채우고, 맨 끝에 다시 NULL 을 넣는다.
+	memcpy(&(newContainer[fm->size - 1]), files, sizeof(JFilePtr) * (size_t)n);
+	fm->size += (int)n;
+	newContainer[fm->size - 1] = NULL;
+
+	for(policyIndex = 0; policyIndex < n; policyIndex++)
+	{
+		JFMPathIndexAdd(fm, files[policyIndex], fm->size - 1 - (int)n + (int)policyIndex);
+	}
+
+	return fm;
+}
+
+/*
+ * @fn static Bool JFMCheckNewPath(const JFMPtr fm, const char *path)
+ * @brief 지정한 경로에 새 파일을 만들어서 추가할 수 있는지 검사하는 함수
+ * 이미 관리 중인 경로이거나, 경로 문자열이 달라도 관리 중인 파일과 같은 파일(장치, 아이노드 번호가 같음)이면 사용할 수 없다.
+ * 같은 파일인지 확인할 때 관리 중인 파일 정보를 읽으므로 쓰기 대기 내용을 먼저 모두 저장한다.
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param path 새 파일 경로(입력, 읽기 전용)
+ * @return 사용할 수 있으면 True, 없으면 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMCheckNewPath(const JFMPtr fm, const char *path)
+{
+	if((path == NULL) || (_CheckIfPath(path) == False)) return False;
+	if(JFMFindFileByPath(fm, path) != NULL) return False;
+
+	FileStatus pathStat;
+	if(stat(path, &pathStat) == 0)
+	{
+		// 저장 스레드가 파일 정보(stat)를 바꾸는 중일 수 있으므로 먼저 모두 저장한다.
+		if(JFMFlushAll(fm) == NULL) return False;
+
+		int fileIndex = 0;
+		for( ; fileIndex < fm->size; fileIndex++)
+		{
+			JFilePtr file = fm->fileContainer[fileIndex];
+			if((file != NULL) && (file->pack == NULL) && (file->stat.st_dev == pathStat.st_dev) && (file->stat.st_ino == pathStat.st_ino)) return False;
+		}
+	}
+
+	return True;
+}
+
+/*
+ * @fn static void JFMCopyFilesTask(void *arg, long long taskIndex)
+ * @brief 여러 파일 복사에서 파일 하나를 복사하고 결과를 저장하는 병렬 작업 함수
+ * @param arg 여러 파일 복사 정보의 주소(입력)
+ * @param taskIndex 작업 번호(입력, 크기순으로 정렬된 작업 목록의 위치)
+ * @return 반환값 없음
+ */
+static void JFMCopyFilesTask(void *arg, long long taskIndex)
+{
+	BatchCopyPtr batch = (BatchCopyPtr)arg;
+	CopyTaskPtr task = &(batch->taskList[taskIndex]);
+	JFMCopyResultPtr result = &(batch->resultList[task->position]);
+
+	long long startTime = _GetMonotonicTime();
+	errno = 0;
+	if(JFileCopy(task->file, task->destPath, batch->option) == NULL)
+	{
+		result->error = (errno != 0) ? errno : EIO;
+		result->size = 0;
+	}
+	else
+	{
+		result->error = 0;
+		result->size = task->size;
+	}
+	result->elapsedTime = _GetMonotonicTime() - startTime;
+}
+
+/*
+ * @fn static long long JFMWriteBackFind(const struct _jfm_write_back_t *writeBack, const JFilePtr file)
+ * @brief 쓰기 대기 목록에서 지정한 파일의 위치를 찾는 함수(뮤텍스를 잠근 상태에서 호출)
+ * @param writeBack 쓰기 지연 정보의 주소(입력, 읽기 전용)
+ * @param file 찾을 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @return 성공 시 목록 위치, 없으면 -1 반환
+ */
+static long long JFMWriteBackFind(const struct _jfm_write_back_t *writeBack, const JFilePtr file)
+{
+	long long dirtyIndex = 0;
+	for( ; dirtyIndex < writeBack->dirtyNum; dirtyIndex++)
+	{
+		if(writeBack->dirtyList[dirtyIndex].file == file) return dirtyIndex;
+	}
+	return -1;
+}
+
+/*
+ * @fn static void JFMWriteBackRemove(struct _jfm_write_back_t *writeBack, long long dirtyIndex)
+ * @brief 쓰기 대기 목록에서 지정한 항목을 버퍼와 함께 지우는 함수(뮤텍스를 잠근 상태에서 호출)
+ * 남은 항목의 순서는 유지한다.
+ * @param writeBack 쓰기 지연 정보의 주소(출력)
+ * @param dirtyIndex 지울 항목 위치(입력)
+ * @return 반환값 없음
+ */
+static void JFMWriteBackRemove(struct _jfm_write_back_t *writeBack, long long dirtyIndex)
+{
+	DirtyFilePtr dirty = &(writeBack->dirtyList[dirtyIndex]);
+	writeBack->totalDirtySize -= dirty->size;
+	if(dirty->buf != NULL) free(dirty->buf);
+
+	memmove(dirty, dirty + 1, sizeof(DirtyFile) * (size_t)(writeBack->dirtyNum - dirtyIndex - 1));
+	writeBack->dirtyNum--;
+}
+
+/*
+ * @fn static Bool JFMWriteBackAppend(struct _jfm_write_back_t *writeBack, JFilePtr file, const char *s, const char *mode)
+ * @brief 파일에 쓸 문자열을 파일의 쓰기 대기 버퍼에 복사하는 함수
+ * "w" 모드는 이전 대기 내용을 버리고 저장할 때 파일 내용을 지우도록 표시한다.
+ * 파일별 대기 크기나 전체 대기 크기를 넘으면 저장 스레드를 깨우고, 전체 대기 크기의 두 배를 넘으면 직접 저장한다.
+ * @param writeBack 쓰기 지연 정보의 주소(출력)
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param s 저장할 문자열(입력, 읽기 전용)
+ * @param mode 파일 접근 방식(입력, 읽기 전용, "w" 또는 "a")
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMWriteBackAppend(struct _jfm_write_back_t *writeBack, JFilePtr file, const char *s, const char *mode)
+{
+	// 파일에 바로 쓸 때와 같이 압축 파일과 묶음 파일의 항목은 거부한다.
+	if((file == NULL) || (file->compress != NULL) || (file->pack != NULL)) return False;
+
+	size_t length = strlen(s);
+	Bool result = True;
+
+	pthread_mutex_lock(&(writeBack->mutex));
+
+	long long dirtyIndex = JFMWriteBackFind(writeBack, file);
+	if(dirtyIndex < 0)
+	{
+		if(writeBack->dirtyNum == writeBack->dirtyCapacity)
+		{
+			long long capacity = (writeBack->dirtyCapacity == 0) ? 16 : writeBack->dirtyCapacity * 2;
+			DirtyFilePtr newList = (DirtyFilePtr)realloc(writeBack->dirtyList, sizeof(DirtyFile) * (size_t)capacity);
+			if(newList == NULL)
+			{
+				pthread_mutex_unlock(&(writeBack->mutex));
+				return False;
+			}
+			writeBack->dirtyList = newList;
+			writeBack->dirtyCapacity = capacity;
+		}
+
+		dirtyIndex = writeBack->dirtyNum++;
+		DirtyFilePtr newDirty = &(writeBack->dirtyList[dirtyIndex]);
+		newDirty->file = file;
+		newDirty->buf = NULL;
+		newDirty->size = 0;
+		newDirty->capacity = 0;
+		newDirty->isTruncate = False;
+		newDirty->dirtyTime = 0;
+		newDirty->isFlushing = False;
+		newDirty->isFailed = False;
+	}
+
+	DirtyFilePtr dirty = &(writeBack->dirtyList[dirtyIndex]);
+	Bool isClean = ((dirty->size == 0) && (dirty->isTruncate == False)) ? True : False;
+	Bool isTruncate = (mode[0] == 'w') ? True : False;
+	size_t keepSize = (isTruncate == True) ? 0 : dirty->size;
+
+	if(keepSize + length > dirty->capacity)
+	{
+		size_t capacity = (dirty->capacity == 0) ? 4096 : dirty->capacity;
+		while(capacity < keepSize + length) capacity *= 2;
+		char *newBuf = (char*)realloc(dirty->buf, capacity);
+		if(newBuf == NULL) result = False;
+		else
+		{
+			dirty->buf = newBuf;
+			dirty->capacity = capacity;
+		}
+	}
+
+	if(result == True)
+	{
+		// 지워질 내용이므로 이전 대기 내용은 버린다.
+		if(isTruncate == True)
+		{
+			writeBack->totalDirtySize -= dirty->size;
+			dirty->size = 0;
+			dirty->isTruncate = True;
+		}
+
+		// 빈 문자열로 내용만 지우는 경우에는 버퍼가 아직 없을 수 있다.
+		if(length > 0) memcpy(dirty->buf + dirty->size, s, length);
+		dirty->size += length;
+		writeBack->totalDirtySize += length;
+		if(isClean == True) dirty->dirtyTime = _GetMonotonicTime();
+
+		// 새로 대기하기 시작한 파일은 저장 스레드가 대기 시간이 끝나는 때를 모르므로 함께 깨운다.
+		if((isClean == True) || (dirty->size >= writeBack->option.maxFileDirtySize) || (writeBack->totalDirtySize >= writeBack->option.maxTotalDirtySize))
+		{
+			pthread_cond_signal(&(writeBack->wakeCond));
+		}
+		// 저장이 쓰기를 따라가지 못하면 쓰는 쪽에서 직접 저장해서 메모리 사용량을 제한한다.
+		if(writeBack->totalDirtySize >= writeBack->option.maxTotalDirtySize * 2) result = JFMWriteBackFlushFile(writeBack, file);
+	}
+
+	pthread_mutex_unlock(&(writeBack->mutex));
+	return result;
+}
+
+/*
+ * @fn static Bool JFMWriteBackFlushFile(struct _jfm_write_back_t *writeBack, JFilePtr file)
+ * @brief 지정한 파일의 쓰기 대기 내용을 파일에 저장하는 함수(뮤텍스를 잠근 상태에서 호출)
+ * 버퍼를 떼어낸 후 뮤텍스를 풀고 저장하므로, 저장하는 동안에도 다른 파일이나 같은 파일에 계속 쓸 수 있다.
+ * 같은 파일을 다른 곳에서 저장하는 중이면 끝날 때까지 기다린다.
+ * 저장하지 못하면 떼어낸 내용을 새로 쓴 내용 앞에 되돌리고 실패로 표시한다.
+ * @param writeBack 쓰기 지연 정보의 주소(출력)
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMWriteBackFlushFile(struct _jfm_write_back_t *writeBack, JFilePtr file)
+{
+	long long dirtyIndex = JFMWriteBackFind(writeBack, file);
+	while((dirtyIndex >= 0) && (writeBack->dirtyList[dirtyIndex].isFlushing == True))
+	{
+		pthread_cond_wait(&(writeBack->flushedCond), &(writeBack->mutex));
+		dirtyIndex = JFMWriteBackFind(writeBack, file);
+	}
+	if(dirtyIndex < 0) return True;
+
+	DirtyFile flushing = writeBack->dirtyList[dirtyIndex];
+	if((flushing.size == 0) && (flushing.isTruncate == False))
+	{
+		JFMWriteBackRemove(writeBack, dirtyIndex);
+		return True;
+	}
+
+	DirtyFilePtr dirty = &(writeBack->dirtyList[dirtyIndex]);
+	dirty->buf = NULL;
+	dirty->size = 0;
+	dirty->capacity = 0;
+	dirty->isTruncate = False;
+	dirty->isFlushing = True;
+	dirty->isFailed = False;
+	writeBack->totalDirtySize -= flushing.size;
+
+	pthread_mutex_unlock(&(writeBack->mutex));
+	struct iovec iov;
+	iov.iov_base = flushing.buf;
+	iov.iov_len = flushing.size;
+	Bool result = (JFileWriteV(file, &iov, 1, -1, flushing.isTruncate) >= 0) ? True : False;
+	pthread_mutex_lock(&(writeBack->mutex));
+
+	// 저장하는 동안에는 다른 곳에서 항목을 지우지 않으므로 다시 찾으면 항상 있다.
+	dirtyIndex = JFMWriteBackFind(writeBack, file);
+	dirty = &(writeBack->dirtyList[dirtyIndex]);
+	dirty->isFlushing = False;
+
+	if(result == True)
+	{
+		if(flushing.buf != NULL) free(flushing.buf);
+		if((dirty->size == 0) && (dirty->isTruncate == False)) JFMWriteBackRemove(writeBack, dirtyIndex);
+	}
+	else
+	{
+		// 새로 쓴 내용이 "w" 모드이면 저장하지 못한 내용은 어차피 지워질 내용이다.
+		if((dirty->isTruncate == False) && (flushing.buf != NULL))
+		{
+			char *newBuf = (char*)realloc(flushing.buf, flushing.size + dirty->size);
+			if(newBuf != NULL)
+			{
+				if(dirty->size > 0) memcpy(newBuf + flushing.size, dirty->buf, dirty->size);
+				if(dirty->buf != NULL) free(dirty->buf);
+				dirty->buf = newBuf;
+				dirty->capacity = flushing.size + dirty->size;
+				dirty->size += flushing.size;
+				dirty->isTruncate = flushing.isTruncate;
+				dirty->dirtyTime = flushing.dirtyTime;
+				writeBack->totalDirtySize += flushing.size;
+				flushing.buf = NULL;
+			}
+		}
+		else if(dirty->isTruncate == False) dirty->isTruncate = flushing.isTruncate;
+		if(flushing.buf != NULL) free(flushing.buf);
+		dirty->isFailed = True;
+	}
+
+	pthread_cond_broadcast(&(writeBack->flushedCond));
+	return result;
+}
+
+/*
+ * @fn static void JFMWriteBackDiscard(struct _jfm_write_back_t *writeBack, JFilePtr file)
+ * @brief 지정한 파일의 쓰기 대기 내용을 저장하지 않고 버리는 함수
+ * 저장하는 중이면 끝날 때까지 기다린다.
+ * @param writeBack 쓰기 지연 정보의 주소(출력)
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @return 반환값 없음
+ */
+static void JFMWriteBackDiscard(struct _jfm_write_back_t *writeBack, JFilePtr file)
+{
+	pthread_mutex_lock(&(writeBack->mutex));
+
+	long long dirtyIndex = JFMWriteBackFind(writeBack, file);
+	while((dirtyIndex >= 0) && (writeBack->dirtyList[dirtyIndex].isFlushing == True))
+	{
+		pthread_cond_wait(&(writeBack->flushedCond), &(writeBack->mutex));
+		dirtyIndex = JFMWriteBackFind(writeBack, file);
+	}
+	if(dirtyIndex >= 0) JFMWriteBackRemove(writeBack, dirtyIndex);
+
+	pthread_mutex_unlock(&(writeBack->mutex));
+}
+
+/*
+ * @fn static void JFMWriteBackStop(JFMPtr fm)
+ * @brief 저장 스레드를 멈추고 쓰기 지연 정보를 해제하는 함수
+ * 남아 있는 쓰기 대기 내용은 저장하지 않으므로 먼저 JFMFlushAll 을 호출해야 한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFMWriteBackStop(JFMPtr fm)
+{
+	struct _jfm_write_back_t *writeBack = fm->writeBack;
+
+	pthread_mutex_lock(&(writeBack->mutex));
+	writeBack->isStopping = True;
+	pthread_cond_signal(&(writeBack->wakeCond));
+	pthread_mutex_unlock(&(writeBack->mutex));
+	pthread_join(writeBack->thread, NULL);
+
+	while(writeBack->dirtyNum > 0)
+	{
+		JFMWriteBackRemove(writeBack, writeBack->dirtyNum - 1);
+	}
+	if(writeBack->dirtyList != NULL) free(writeBack->dirtyList);
+
+	pthread_cond_destroy(&(writeBack->flushedCond));
+	pthread_cond_destroy(&(writeBack->wakeCond));
+	pthread_mutex_destroy(&(writeBack->mutex));
+	free(writeBack);
+	fm->writeBack = NULL;
+}
+
+/*
+ * @fn static void* JFMWriteBackWorker(void *arg)
+ * @brief 쓰기 대기 내용을 조건에 따라 파일에 저장하는 백그라운드 저장 스레드 함수
+ * 파일별 대기 크기를 넘었거나, 대기 시간이 지났거나, 전체 대기 크기를 넘었으면 저장한다.
+ * 저장할 파일이 없으면 가장 먼저 대기 시간이 끝나는 때까지 기다리고, 쓰는 쪽이 깨우면 다시 확인한다.
+ * @param arg 쓰기 지연 정보의 주소(입력)
+ * @return 항상 NULL 반환
+ */
+static void* JFMWriteBackWorker(void *arg)
+{
+	struct _jfm_write_back_t *writeBack = (struct _jfm_write_back_t*)arg;
+
+	pthread_mutex_lock(&(writeBack->mutex));
+	while(writeBack->isStopping == False)
+	{
+		long long now = _GetMonotonicTime();
+		long long deadline = -1;
+		JFilePtr target = NULL;
+		Bool isPressure = (writeBack->totalDirtySize >= writeBack->option.maxTotalDirtySize) ? True : False;
+
+		long long dirtyIndex = 0;
+		for( ; dirtyIndex < writeBack->dirtyNum; dirtyIndex++)
+		{
+			DirtyFilePtr dirty = &(writeBack->dirtyList[dirtyIndex]);
+			if((dirty->isFlushing == True) || (dirty->isFailed == True)) continue;
+
+			long long dueTime = dirty->dirtyTime + writeBack->option.maxDirtyAge;
+			if((isPressure == True) || (dirty->size >= writeBack->option.maxFileDirtySize) || (now >= dueTime))
+			{
+				target = dirty->file;
+				break;
+			}
+			if((deadline < 0) || (dueTime < deadline)) deadline = dueTime;
+		}
+
+		if(target != NULL)
+		{
+			JFMWriteBackFlushFile(writeBack, target);
+			continue;
+		}
+
+		if(deadline < 0) pthread_cond_wait(&(writeBack->wakeCond), &(writeBack->mutex));
+		else
+		{
+			struct timespec wakeTime;
+			wakeTime.tv_sec = (time_t)(deadline / 1000);
+			wakeTime.tv_nsec = (long)((deadline % 1000) * 1000000);
+			pthread_cond_timedwait(&(writeBack->wakeCond), &(writeBack->mutex), &wakeTime);
+		}
+	}
+	pthread_mutex_unlock(&(writeBack->mutex));
+
+	return NULL;
+}
+
+/*
+ * @fn static JFMEditPtr JFMEditReset(JFMEditPtr edit)
+ * @brief 현재 파일 전체를 원본 조각 하나로 하는 처음 편집 상태로 되돌리는 함수
+ * 파일 정보가 실제 파일과 다르면 먼저 다시 읽는다.
+ * @param edit 편집 정보의 주소(출력)
+ * @return 성공 시 편집 정보의 주소, 실패 시 NULL 반환
+ */
+static JFMEditPtr JFMEditReset(JFMEditPtr edit)
+{
+	JFilePtr file = edit->file;
+	if(fstat(edit->fd, &(edit->stat)) == -1) return NULL;
+
+	if((edit->stat.st_size != file->stat.st_size)
+		|| (edit->stat.st_mtim.tv_sec != file->stat.st_mtim.tv_sec)
+		|| (edit->stat.st_mtim.tv_nsec != file->stat.st_mtim.tv_nsec))
+	{
+		if(JFileLoad(file) == NULL) return NULL;
+	}
+
+	long long size = (long long)edit->stat.st_size;
+	edit->pieceNum = 0;
+	edit->addSize = 0;
+	edit->lineNum = file->line;
+	edit->isLastLineOpen = (file->line > size - file->totalCharCount) ? True : False;
+
+	if(size > 0)
+	{
+		EditPiece piece;
+		piece.isOriginal = True;
+		piece.offset = 0;
+		piece.length = size;
+		piece.lineNum = file->line;
+		piece.firstLine = 0;
+		if(JFMEditInsertPiece(edit, 0, &piece) == False) return NULL;
+	}
+
+	return edit;
+}
+
+/*
+ * @fn static Bool JFMEditInsertPiece(JFMEditPtr edit, long long pieceIndex, const EditPiecePtr piece)
+ * @brief 조각 목록의 지정한 위치에 조각을 추가하는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @param pieceIndex 추가할 위치(입력)
+ * @param piece 추가할 조각(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMEditInsertPiece(JFMEditPtr edit, long long pieceIndex, const EditPiecePtr piece)
+{
+	if(edit->pieceNum == edit->pieceCapacity)
+	{
+		long long capacity = (edit->pieceCapacity == 0) ? 16 : edit->pieceCapacity * 2;
+		EditPiecePtr newList = (EditPiecePtr)realloc(edit->pieceList, sizeof(EditPiece) * (size_t)capacity);
+		if(newList == NULL) return False;
+		edit->pieceList = newList;
+		edit->pieceCapacity = capacity;
+	}
+
+	memmove(&(edit->pieceList[pieceIndex + 1]), &(edit->pieceList[pieceIndex]), sizeof(EditPiece) * (size_t)(edit->pieceNum - pieceIndex));
+	edit->pieceList[pieceIndex] = *piece;
+	edit->pieceNum++;
+	return True;
+}
+
+/*
+ * @fn static void JFMEditRemovePieces(JFMEditPtr edit, long long startIndex, long long endIndex)
+ * @brief 조각 목록에서 지정한 구간의 조각들을 지우는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @param startIndex 지울 첫 조각 위치(입력)
+ * @param endIndex 지울 마지막 조각 다음 위치(입력)
+ * @return 반환값 없음
+ */
+static void JFMEditRemovePieces(JFMEditPtr edit, long long startIndex, long long endIndex)
+{
+	if(endIndex <= startIndex) return;
+	memmove(&(edit->pieceList[startIndex]), &(edit->pieceList[endIndex]), sizeof(EditPiece) * (size_t)(edit->pieceNum - endIndex));
+	edit->pieceNum -= endIndex - startIndex;
+}
+
+/*
+ * @fn static long long JFMEditSplit(JFMEditPtr edit, long long lineNumber)
+ * @brief 지정한 라인이 조각의 처음이 되도록 조각을 나누는 함수
+ * 원본 조각은 파일의 라인 위치 색인으로 나눌 위치를 찾으므로 조각 전체를 읽지 않는다.
+ * @param edit 편집 정보의 주소(출력)
+ * @param lineNumber 라인 번호(입력, 0 부터 전체 라인 개수까지)
+ * @return 성공 시 지정한 라인으로 시작하는 조각의 위치(전체 라인 개수이면 조각 개수), 실패 시 -1 반환
+ */
+static long long JFMEditSplit(JFMEditPtr edit, long long lineNumber)
+{
+	long long lineBefore = 0;
+	long long pieceIndex = 0;
+	for( ; pieceIndex < edit->pieceNum; pieceIndex++)
+	{
+		if(lineBefore == lineNumber) return pieceIndex;
+		if(lineNumber < lineBefore + edit->pieceList[pieceIndex].lineNum) break;
+		lineBefore += edit->pieceList[pieceIndex].lineNum;
+	}
+	if(pieceIndex == edit->pieceNum) return (lineBefore == lineNumber) ? pieceIndex : -1;
+
+	EditPiece rest = edit->pieceList[pieceIndex];
+	long long skipCount = lineNumber - lineBefore;
+	long long splitOffset = 0;
+
+	if(rest.isOriginal == True)
+	{
+		off_t lineOffset = JFileFindLineOffset(edit->file, edit->fd, edit->buf, rest.firstLine + skipCount);
+		if(lineOffset < 0) return -1;
+		splitOffset = (long long)lineOffset - rest.offset;
+	}
+	else
+	{
+		const char *start = edit->addBuffer + rest.offset;
+		const char *s = start;
+		const char *end = start + rest.length;
+		for( ; skipCount > 0; skipCount--)
+		{
+			const char *newline = (const char*)memchr(s, '\n', (size_t)(end - s));
+			if(newline == NULL) return -1;
+			s = newline + 1;
+		}
+		splitOffset = (long long)(s - start);
+	}
+
+	rest.offset += splitOffset;
+	rest.length -= splitOffset;
+	rest.lineNum -= lineNumber - lineBefore;
+	rest.firstLine += lineNumber - lineBefore;
+	if(JFMEditInsertPiece(edit, pieceIndex + 1, &rest) == False) return -1;
+
+	edit->pieceList[pieceIndex].length = splitOffset;
+	edit->pieceList[pieceIndex].lineNum = lineNumber - lineBefore;
+	return pieceIndex + 1;
+}
+
+/*
+ * @fn static Bool JFMEditAddText(JFMEditPtr edit, const char *line, EditPiecePtr piece)
+ * @brief 라인 문자열을 추가 버퍼 끝에 저장하고 그 구간을 가리키는 조각을 만드는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @param line 저장할 라인 문자열(입력, 읽기 전용, 개행 문자가 없으면 붙임)
+ * @param piece 만든 조각을 저장할 구조체의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMEditAddText(JFMEditPtr edit, const char *line, EditPiecePtr piece)
+{
+	size_t length = strlen(line);
+	Bool isNewlineNeeded = ((length == 0) || (line[length - 1] != '\n')) ? True : False;
+	size_t needSize = edit->addSize + length + ((isNewlineNeeded == True) ? 1 : 0);
+
+	if(needSize > edit->addCapacity)
+	{
+		size_t capacity = (edit->addCapacity == 0) ? 4096 : edit->addCapacity;
+		while(capacity < needSize) capacity *= 2;
+		char *newBuffer = (char*)realloc(edit->addBuffer, capacity);
+		if(newBuffer == NULL) return False;
+		edit->addBuffer = newBuffer;
+		edit->addCapacity = capacity;
+	}
+
+	char *dest = edit->addBuffer + edit->addSize;
+	memcpy(dest, line, length);
+	if(isNewlineNeeded == True) dest[length] = '\n';
+
+	piece->isOriginal = False;
+	piece->offset = (long long)edit->addSize;
+	piece->length = (long long)(needSize - edit->addSize);
+	piece->lineNum = JFileCountData(edit->file, dest, (size_t)piece->length, 0, 0, False);
+	piece->firstLine = 0;
+
+	edit->addSize = needSize;
+	return True;
+}
+
+/*
+ * @fn static Bool JFMEditCloseLastLine(JFMEditPtr edit)
+ * @brief 개행 문자로 끝나지 않은 마지막 라인을 추가 버퍼로 옮기고 개행 문자를 붙이는 함수
+ * @param edit 편집 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMEditCloseLastLine(JFMEditPtr edit)
+{
+	long long pieceIndex = JFMEditSplit(edit, edit->lineNum - 1);
+	if((pieceIndex < 0) || (pieceIndex != edit->pieceNum - 1)) return False;
+
+	// 추가한 라인은 항상 개행 문자로 끝나므로 마지막 조각은 원본 조각이다.
+	EditPiecePtr piece = &(edit->pieceList[pieceIndex]);
+	char *line = (char*)malloc((size_t)piece->length + 1);
+	if(line == NULL) return False;
+
+	Bool result = False;
+	if(JFileReadAt(edit->file, edit->fd, line, (size_t)piece->length, (off_t)piece->offset) == (ssize_t)piece->length)
+	{
+		line[piece->length] = '\0';
+		EditPiece newPiece;
+		if(JFMEditAddText(edit, line, &newPiece) == True)
+		{
+			edit->pieceList[pieceIndex] = newPiece;
+			edit->isLastLineOpen = False;
+			result = True;
+		}
+	}
+
+	free(line);
+	return result;
+}
+
+/*
+ * @fn static IndexFilePtr JFMIndexFind(const struct _jfm_index_t *contentIndex, const JFilePtr file)
+ * @brief 내용 색인에서 지정한 파일의 색인 정보를 찾는 함수
+ * @param contentIndex 내용 색인 정보의 주소(입력, 읽기 전용)
+ * @param file 찾을 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @return 성공 시 파일 색인 정보의 주소, 없으면 NULL 반환
+ */
+static IndexFilePtr JFMIndexFind(const struct _jfm_index_t *contentIndex, const JFilePtr file)
+{
+	long long entryIndex = 0;
+	for( ; entryIndex < contentIndex->fileNum; entryIndex++)
+	{
+		if(contentIndex->fileList[entryIndex].file == file) return &(contentIndex->fileList[entryIndex]);
+	}
+	return NULL;
+}
+
+/*
+ * @fn static IndexFilePtr JFMIndexAdd(struct _jfm_index_t *contentIndex, JFilePtr file)
+ * @brief 내용 색인에 처음부터 색인해야 하는 파일 색인 정보를 추가하는 함수
+ * @param contentIndex 내용 색인 정보의 주소(출력)
+ * @param file 추가할 파일 정보 관리 구조체의 주소(입력)
+ * @return 성공 시 추가한 파일 색인 정보의 주소, 실패 시 NULL 반환
+ */
+static IndexFilePtr JFMIndexAdd(struct _jfm_index_t *contentIndex, JFilePtr file)
+{
+	if(contentIndex->fileNum == contentIndex->fileCapacity)
+	{
+		long long capacity = (contentIndex->fileCapacity == 0) ? 16 : contentIndex->fileCapacity * 2;
+		IndexFilePtr newList = (IndexFilePtr)realloc(contentIndex->fileList, sizeof(IndexFile) * (size_t)capacity);
+		if(newList == NULL) return NULL;
+		contentIndex->fileList = newList;
+		contentIndex->fileCapacity = capacity;
+	}
+
+	IndexFilePtr entry = &(contentIndex->fileList[contentIndex->fileNum++]);
+	_IndexFileInit(entry, file);
+	return entry;
+}
+
+/*
+ * @fn static void JFMIndexRemove(struct _jfm_index_t *contentIndex, const JFilePtr file)
+ * @brief 내용 색인에서 지정한 파일의 색인 정보를 지우는 함수
+ * @param contentIndex 내용 색인 정보의 주소(출력)
+ * @param file 지울 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @return 반환값 없음
+ */
+static void JFMIndexRemove(struct _jfm_index_t *contentIndex, const JFilePtr file)
+{
+	IndexFilePtr entry = JFMIndexFind(contentIndex, file);
+	if(entry == NULL) return;
+
+	_IndexFileFree(entry);
+	*entry = contentIndex->fileList[--(contentIndex->fileNum)];
+}
+
+/*
+ * @fn static void JFMIndexMarkDirty(JFMPtr fm, const JFilePtr file, long long offset)
+ * @brief 파일 내용이 바뀐 첫 위치를 기록해서 다음 검색 전에 그 위치를 포함하는 블록부터 다시 색인하게 하는 함수
+ * 내용 색인을 사용하지 않거나 아직 색인하지 않은 파일이면 아무것도 하지 않는다.
+ * 쓰기 지연 중에는 저장 스레드가 파일 정보를 바꿀 수 있으므로 파일 정보(stat)는 읽지 않는다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param file 바뀐 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @param offset 내용이 바뀐 첫 위치(입력, 음수이면 색인한 내용 끝)
+ * @return 반환값 없음
+ */
+static void JFMIndexMarkDirty(JFMPtr fm, const JFilePtr file, long long offset)
+{
+	if((fm->contentIndex == NULL) || (file == NULL)) return;
+
+	IndexFilePtr entry = JFMIndexFind(fm->contentIndex, file);
+	if(entry == NULL) return;
+	// 색인한 내용 끝 뒤는 아직 색인하지 않았으므로, 끝에 추가한 내용은 그 위치부터 다시 색인하면 된다.
+	if(offset < 0) offset = entry->contentSize;
+	if((entry->dirtyOffset < 0) || (offset < entry->dirtyOffset)) entry->dirtyOffset = offset;
+}
+
+/*
+ * @fn static Bool JFMIndexSync(JFMPtr fm, int index)
+ * @brief 내용 색인을 관리 중인 파일의 현재 내용에 맞추는 함수
+ * 관리 목록에서 빠진 파일의 색인은 지우고, 색인이 없는 파일은 추가한다.
+ * 바뀐 위치가 기록된 파일은 그 블록부터, 기록 없이 다른 곳에서 바뀐 파일은 처음부터 파일별로 병렬로 다시 색인한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 맞출 파일의 인덱스 번호(입력, 음수이면 모든 파일)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMIndexSync(JFMPtr fm, int index)
+{
+	struct _jfm_index_t *contentIndex = fm->contentIndex;
+
+	long long entryIndex = 0;
+	while((index < 0) && (entryIndex < contentIndex->fileNum))
+	{
+		JFilePtr file = contentIndex->fileList[entryIndex].file;
+		int fileIndex = 0;
+		for( ; (fileIndex < fm->size) && (fm->fileContainer[fileIndex] != file); fileIndex++);
+
+		if(fileIndex < fm->size) entryIndex++;
+		else JFMIndexRemove(contentIndex, file);
+	}
+
+	IndexUpdate update;
+	update.contentIndex = contentIndex;
+	update.isFailed = False;
+	update.targetList = (long long*)malloc(sizeof(long long) * (size_t)fm->size);
+	if(update.targetList == NULL) return False;
+
+	long long targetNum = 0;
+	int fileIndex = (index < 0) ? 0 : index;
+	int lastIndex = (index < 0) ? fm->size - 1 : index;
+	for( ; (update.isFailed == False) && (fileIndex <= lastIndex); fileIndex++)
+	{
+		JFilePtr file = JFMGetFile(fm, fileIndex);
+		if(file == NULL) continue;
+
+		IndexFilePtr entry = JFMIndexFind(contentIndex, file);
+		if(entry == NULL) entry = JFMIndexAdd(contentIndex, file);
+		if((entry == NULL) || (JFileReloadIfChanged(file) == NULL))
+		{
+			update.isFailed = True;
+			break;
+		}
+
+		if((entry->dirtyOffset < 0)
+			&& ((entry->stat.st_size != file->stat.st_size)
+				|| (entry->stat.st_mtim.tv_sec != file->stat.st_mtim.tv_sec)
+				|| (entry->stat.st_mtim.tv_nsec != file->stat.st_mtim.tv_nsec)
+				|| (entry->stat.st_ino != file->stat.st_ino)
+				|| (entry->stat.st_dev != file->stat.st_dev)))
+		{
+			entry->dirtyOffset = 0;
+		}
+		if(entry->dirtyOffset >= 0) update.targetList[targetNum++] = (long long)(entry - contentIndex->fileList);
+	}
+
+	if((update.isFailed == False) && (targetNum > 0) && (_RunTasks(JFMIndexUpdateTask, &update, targetNum, 0) == -1)) update.isFailed = True;
+
+	free(update.targetList);
+	return (update.isFailed == True) ? False : True;
+}
+
+/*
+ * @fn static void JFMIndexUpdateTask(void *arg, long long taskIndex)
+ * @brief 파일 하나를 다시 색인하는 작업 함수
+ * @param arg 다시 색인할 목록(IndexUpdate)의 주소(입력)
+ * @param taskIndex 목록 안의 번호(입력)
+ * @return 반환값 없음
+ */
+static void JFMIndexUpdateTask(void *arg, long long taskIndex)
+{
+	IndexUpdatePtr update = (IndexUpdatePtr)arg;
+	IndexFilePtr entry = &(update->contentIndex->fileList[update->targetList[taskIndex]]);
+	if(JFileIndexScan(entry->file, entry) == False) update->isFailed = True;
+}
+
+/*
+ * @fn static void JFMIndexUnmap(struct _jfm_index_t *contentIndex)
+ * @brief 불러온 색인 파일의 매핑을 해제하는 함수
+ * 매핑된 색인은 메모리로 옮기고, 옮기지 못한 색인은 처음부터 다시 색인하도록 비운다.
+ * @param contentIndex 내용 색인 정보의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFMIndexUnmap(struct _jfm_index_t *contentIndex)
+{
+	if(contentIndex->map == NULL) return;
+
+	long long entryIndex = 0;
+	for( ; entryIndex < contentIndex->fileNum; entryIndex++)
+	{
+		IndexFilePtr entry = &(contentIndex->fileList[entryIndex]);
+		if(_IndexFileToMemory(entry) == False) _IndexFileInit(entry, entry->file);
+	}
+
+	munmap(contentIndex->map, contentIndex->mapSize);
+	contentIndex->map = NULL;
+	contentIndex->mapSize = 0;
+}
+
+/*
+ * @fn static void JFMIndexFree(JFMPtr fm)
+ * @brief 내용 색인 정보를 모두 해제하고 사용을 멈추는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFMIndexFree(JFMPtr fm)
+{
+	struct _jfm_index_t *contentIndex = fm->contentIndex;
+	if(contentIndex == NULL) return;
+
+	long long entryIndex = 0;
+	for( ; entryIndex < contentIndex->fileNum; entryIndex++)
+	{
+		_IndexFileFree(&(contentIndex->fileList[entryIndex]));
+	}
+	if(contentIndex->fileList != NULL) free(contentIndex->fileList);
+	if(contentIndex->map != NULL) munmap(contentIndex->map, contentIndex->mapSize);
+
+	free(contentIndex);
+	fm->contentIndex = NULL;
+}
+
+/*
+ * @fn static PathNodePtr JFMPathIndexGet(JFMPtr fm)
+ * @brief 경로 색인(압축 기수 트라이)의 루트 노드를 반환하는 함수(아직 없으면 관리 중인 파일로 새로 만듦)
+ * 같은 경로의 파일이 여럿이면 JFMFindFileByPath 와 같게 앞쪽 파일을 남기도록 뒤에서부터 추가한다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 성공 시 루트 노드의 주소, 실패 시 NULL 반환
+ */
+static PathNodePtr JFMPathIndexGet(JFMPtr fm)
+{
+	if(fm->pathIndex != NULL) return fm->pathIndex;
+
+	PathNodePtr root = _PathNodeNew("", 0);
+	if(root == NULL) return NULL;
+
+	int fileIndex = fm->size - 1;
+	for( ; fileIndex >= 0; fileIndex--)
+	{
+		JFilePtr file = fm->fileContainer[fileIndex];
+		if((file == NULL) || (file->path == NULL)) continue;
+		if(_PathNodeInsert(root, file->path, file, fileIndex) == False)
+		{
+			_PathNodeFree(root);
+			return NULL;
+		}
+	}
+
+	fm->pathIndex = root;
+	return root;
+}
+
+/*
+ * @fn static void JFMPathIndexAdd(JFMPtr fm, JFilePtr file, int index)
+ * @brief 경로 색인에 파일을 추가하는 함수(경로 색인을 아직 만들지 않았으면 아무것도 하지 않음)
+ * 메모리가 부족해서 추가하지 못하면 경로 색인을 버리고 다음에 사용할 때 다시 만든다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param file 추가할 파일 정보 관리 구조체의 주소(입력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @return 반환값 없음
+ */
+static void JFMPathIndexAdd(JFMPtr fm, JFilePtr file, int index)
+{
+	if((fm->pathIndex == NULL) || (file == NULL) || (file->path == NULL)) return;
+	if(_PathNodeInsert(fm->pathIndex, file->path, file, index) == False) JFMPathIndexFree(fm);
+}
+
+/*
+ * @fn static void JFMPathIndexRemove(JFMPtr fm, const JFilePtr file)
+ * @brief 경로 색인에서 파일을 지우는 함수(경로 색인을 아직 만들지 않았으면 아무것도 하지 않음)
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param file 지울 파일 정보 관리 구조체의 주소(입력, 읽기 전용)
+ * @return 반환값 없음
+ */
+static void JFMPathIndexRemove(JFMPtr fm, const JFilePtr file)
+{
+	if((fm->pathIndex == NULL) || (file == NULL) || (file->path == NULL)) return;
+	_PathNodeRemove(fm->pathIndex, file->path, strlen(file->path), file);
+}
+
+/*
+ * @fn static void JFMPathIndexFree(JFMPtr fm)
+ * @brief 경로 색인을 모두 해제하는 함수
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @return 반환값 없음
+ */
+static void JFMPathIndexFree(JFMPtr fm)
+{
+	if(fm->pathIndex == NULL) return;
+	_PathNodeFree(fm->pathIndex);
+	fm->pathIndex = NULL;
+}
+
+/*
+ * @fn static Bool JFMSetFilePath(JFMPtr fm, int index, const char *path)
+ * @brief 관리 중인 파일의 경로를 바꾸고 경로 색인을 함께 갱신하는 함수(실제 파일은 옮기지 않음)
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param index 파일의 인덱스 번호(입력)
+ * @param path 새 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMSetFilePath(JFMPtr fm, int index, const char *path)
+{
+	JFilePtr file = JFMGetFile(fm, index);
+	if(file == NULL) return False;
+
+	JFMPathIndexRemove(fm, file);
+	Bool result = (JFileSetPath(file, path) != NULL) ? True : False;
+	JFMPathIndexAdd(fm, file, index);
+	return result;
+}
+
+/*
+ * @fn static JFMPathIterPtr JFMPathIterNew(JFMPtr fm, const char *prefix, size_t prefixLength, const char *pattern)
+ * @brief 경로가 지정한 접두사로 시작하는 파일을 경로 색인에서 찾아서 반복자를 만드는 함수
+ * 접두사가 끝나는 노드까지 내려간 후 그 아래 노드만 방문하므로, 찾은 파일 개수와 경로 깊이에 비례하는 시간이 걸린다.
+ * @param fm 파일 관리 구조체의 주소(출력)
+ * @param prefix 경로 접두사(입력, 읽기 전용)
+ * @param prefixLength 접두사 길이(입력)
+ * @param pattern 접두사 아래 파일 중 경로가 맞아야 하는 글롭 패턴(입력, 읽기 전용, NULL 이면 모두)
+ * @return 성공 시 반복자의 주소, 실패 시 NULL 반환
+ */
+static JFMPathIterPtr JFMPathIterNew(JFMPtr fm, const char *prefix, size_t prefixLength, const char *pattern)
+{
+	PathNodePtr root = JFMPathIndexGet(fm);
+	if(root == NULL) return NULL;
+
+	JFMPathIterPtr iter = (JFMPathIterPtr)calloc(1, sizeof(JFMPathIter));
+	if(iter == NULL) return NULL;
+
+	PathNodePtr node = _PathNodeFind(root, prefix, prefixLength, True);
+	if((node != NULL) && (JFMPathIterCollect(fm, iter, node, pattern) == False))
+	{
+		JFMPathIterClose(&iter);
+		return NULL;
+	}
+	return iter;
+}
+
+/*
+ * @fn static Bool JFMPathIterCollect(const JFMPtr fm, JFMPathIterPtr iter, const PathNodePtr node, const char *pattern)
+ * @brief 지정한 노드와 그 아래 노드의 파일 인덱스 번호를 경로 순서로 반복자에 추가하는 함수
+ * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
+ * @param iter 반복자의 주소(출력)
+ * @param node 방문할 노드의 주소(입력, 읽기 전용)
+ * @param pattern 경로가 맞아야 하는 글롭 패턴(입력, 읽기 전용, NULL 이면 모두)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool JFMPathIterCollect(const JFMPtr fm, JFMPathIterPtr iter, const PathNodePtr node, const char *pattern)
+{
+	if((node->file != NULL) && (JFMGetFile(fm, node->fileIndex) == node->file)
+		&& ((pattern == NULL) || (_MatchGlob(pattern, node->file->path) == True)))
+	{
+		if(iter->indexNum == iter->indexCapacity)
+		{
+			long long capacity = (iter->indexCapacity == 0) ? 16 : iter->indexCapacity * 2;
+			int *newList = (int*)realloc(iter->indexList, sizeof(int) * (size_t)capacity);
+			if(newList == NULL) return False;
+			iter->indexList = newList;
+			iter->indexCapacity = capacity;
+		}
+		iter->indexList[iter->indexNum++] = node->fileIndex;
+	}
+
+	int childIndex = 0;
+	for( ; childIndex < node->childNum; childIndex++)
+	{
+		if(JFMPathIterCollect(fm, iter, node->childList[childIndex], pattern) == False) return False;
+	}
+	return True;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Static Util Function
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * @fn static off_t _FindLineStart(int fd, off_t offset)
+ * @brief 지정한 위치 앞에서 가장 가까운 개행 문자 다음 위치(지정한 위치 직전 바이트가 속한 라인의 시작 위치)를 찾는 함수
+ * 블록 크기에 맞춘 구간 단위로 뒤에서부터 읽으면서 memrchr 로 찾는다.
+ * @param fd 파일 디스크립터(입력)
+ * @param offset 찾기 시작할 위치(입력, 이 위치 직전 바이트부터 앞으로 찾는다)
+ * @return 성공 시 라인 시작 위치(개행 문자가 없으면 0), 실패 시 -1 반환
+ */
+static off_t _FindLineStart(int fd, off_t offset)
+{
+	if(offset <= 0) return 0;
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL) return -1;
+
+	off_t end = offset;
+	off_t lineStart = 0;
+	while(end > 0)
+	{
+		// 첫 구간 이후에는 블록 경계에서 읽도록 시작 위치를 맞춘다.
+		off_t start = (end - 1) / READ_BUF_SIZE * READ_BUF_SIZE;
+		ssize_t readSize = _ReadFull(fd, buf, (size_t)(end - start), start);
+		if(readSize != (ssize_t)(end - start))
+		{
+			lineStart = -1;
+			break;
+		}
+
+		char *newline = (char*)memrchr(buf, '\n', (size_t)readSize);
+		if(newline != NULL)
+		{
+			lineStart = start + (off_t)(newline - buf) + 1;
+			break;
+		}
+		end = start;
+	}
+
+	free(buf);
+	return lineStart;
+}
+
+/*
+ * @fn static void _CountLineChunk(void *arg, long long taskIndex)
+ * @brief 지정한 구간의 개행 문자 개수를 세고 구간 안의 라인 위치 색인을 만드는 병렬 작업 함수
+ * @param arg 라인 수 계산 정보 구조체의 주소(입력)
+ * @param taskIndex 구간 번호(입력)
+ * @return 반환값 없음
+ */
+static void _CountLineChunk(void *arg, long long taskIndex)
+{
+	LineCountPtr count = (LineCountPtr)arg;
+	LineCountChunkPtr chunk = &(count->chunkList[taskIndex]);
+
+	off_t offset = (off_t)taskIndex * count->chunkSize;
+	off_t endOffset = offset + count->chunkSize;
+	if(endOffset > count->size) endOffset = count->size;
+
+	char *buf = (char*)malloc(READ_BUF_SIZE);
+	if(buf == NULL)
+	{
+		chunk->isFailed = True;
+		return;
+	}
+
+	while(offset < endOffset)
+	{
+		size_t readLength = READ_BUF_SIZE;
+		if(offset + (off_t)readLength > endOffset) readLength = (size_t)(endOffset - offset);
+
+		ssize_t readSize = _ReadFull(count->fd, buf, readLength, offset);
+		if(readSize <= 0)
+		{
+			// 세는 동안 파일이 줄어든 경우가 아니면 실패
+			if(readSize < 0) chunk->isFailed = True;
+			break;
+		}
+
+		char *s = buf;
+		char *end = buf + readSize;
+		char *newline = NULL;
+		while((newline = (char*)memchr(s, '\n', (size_t)(end - s))) != NULL)
+		{
+			chunk->newlineCount++;
+			if((chunk->newlineCount % LINE_INDEX_INTERVAL) == 0)
+			{
+				// 개수가 2 의 거듭제곱이 될 때마다 두 배로 늘린다.
+				long long markCount = chunk->markCount;
+				if((markCount == 0) || ((markCount & (markCount - 1)) == 0))
+				{
+					JFileLineMarkPtr newMarkList = (JFileLineMarkPtr)realloc(chunk->markList, sizeof(JFileLineMark) * (size_t)((markCount == 0) ? 16 : markCount * 2));
+					if(newMarkList == NULL)
+					{
+						chunk->isFailed = True;
+						free(buf);
+						return;
+					}
+					chunk->markList = newMarkList;
+				}
+				chunk->markList[markCount].line = chunk->newlineCount;
+				chunk->markList[markCount].offset = (long long)offset + (newline - buf) + 1;
+				chunk->markCount = markCount + 1;
+			}
+			s = newline + 1;
+		}
+
+		offset += readSize;
+	}
+
+	free(buf);
+}
+
+/*
+ * @fn static Bool _CheckIfPath(const char *s)
+ * @brief 지정한 문자열이 경로인지 검사하는 함수
+ * @param s 검사할 문자열(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _CheckIfPath(const char *s)
+{
+	if(s == NULL) return False;
+
+	while(*s != '\0')
+	{
+		if(*s++ == '/') return True;
+	}
+
+	return False;
+}
+
+/*
+ * @fn static void _ConvertModeToString(char *s, mode_t mode)
+ * @brief 지정한 파일 접근 방식을 문자열로 변환하는 함수
+ * @param s 저장할 문자열(출력)
+ * @param mode 변환할 파일 접근 방식(입력)
+ * @return 반환값 없음
+ */
+static void _ConvertModeToString(char *s, mode_t mode)
+{
+	const char basePermissions[MAX_MODE_NUM] = "rwxrwxrwx";
+	int modeIndex = 0;
+
+	for( ; modeIndex < MAX_MODE_NUM; modeIndex++)
+	{
+		s[modeIndex] = (mode & (1 << (MAX_MODE_NUM - modeIndex - 1))) ? basePermissions[modeIndex] : '-';
+	}
+
+	s[MAX_MODE_NUM] = '\0';
+}
+
+/*
+ * @fn static Bool _CheckIfStringIsDigits(const char *s)
+ * @brief 지정한 문자열이 숫자 문자들로 구성되어 있는지 검사하는 함수
+ * @param s 검사할 문자열(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _CheckIfStringIsDigits(const char *s)
+{
+	int sLength = strlen(s);
+	int sIndex = 0;
+
+	for( ; sIndex < sLength; sIndex++)
+	{
+		if(isdigit(s[sIndex]) == 0) return False;
+	}
+
+	return True;
+}
+
+/*
+ * @fn static Bool _CompareFileContents(const char *path1, const char *path2)
+ * @brief 지정한 두 파일의 내용이 바이트 단위로 같은지 검사하는 함수
+ * @param path1 비교할 첫 번째 파일 경로(입력, 읽기 전용)
+ * @param path2 비교할 두 번째 파일 경로(입력, 읽기 전용)
+ * @return 내용이 같으면 True, 다르거나 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _CompareFileContents(const char *path1, const char *path2)
+{
+	int fd1 = open(path1, O_RDONLY);
+	if(fd1 == -1) return False;
+	int fd2 = open(path2, O_RDONLY);
+	if(fd2 == -1)
+	{
+		close(fd1);
+		return False;
+	}
+
+	char *buf1 = (char*)malloc(COMPARE_BUF_SIZE);
+	char *buf2 = (char*)malloc(COMPARE_BUF_SIZE);
+	Bool result = False;
+
+	while((buf1 != NULL) && (buf2 != NULL))
+	{
+		ssize_t readSize1 = read(fd1, buf1, COMPARE_BUF_SIZE);
+		if(readSize1 < 0) break;
+
+		// 두 번째 파일은 첫 번째 파일에서 읽은 만큼 채워질 때까지 읽는다.
+		ssize_t readSize2 = 0;
+		while(readSize2 < readSize1)
+		{
+			ssize_t n = read(fd2, buf2 + readSize2, (size_t)(readSize1 - readSize2));
+			if(n <= 0) break;
+			readSize2 += n;
+		}
+		if(readSize2 != readSize1) break;
+
+		if(readSize1 == 0)
+		{
+			// 첫 번째 파일이 끝났으면 두 번째 파일도 끝나야 같은 파일이다.
+			if(read(fd2, buf2, 1) == 0) result = True;
+			break;
+		}
+
+		if(memcmp(buf1, buf2, (size_t)readSize1) != 0) break;
+	}
+
+	if(buf1 != NULL) free(buf1);
+	if(buf2 != NULL) free(buf2);
+	close(fd1);
+	close(fd2);
+	return result;
+}
+
+/*
+ * @fn static int _ReflinkFile(const char *srcPath, const char *destPath)
+ * @brief 대상 파일의 데이터 블록을 원본 파일의 블록과 공유하도록 리플링크하는 함수
+ * 대상 파일의 아이노드는 유지되며, 파일 시스템이 지원하지 않으면 실패한다.
+ * @param srcPath 원본 파일 경로(입력, 읽기 전용)
+ * @param destPath 대상 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 0, 실패 시 -1 반환
+ */
+static int _ReflinkFile(const char *srcPath, const char *destPath)
+{
+	int srcFd = open(srcPath, O_RDONLY);
+	if(srcFd == -1) return -1;
+
+	int destFd = open(destPath, O_WRONLY);
+	if(destFd == -1)
+	{
+		close(srcFd);
+		return -1;
+	}
+
+	struct file_clone_range range;
+	range.src_fd = srcFd;
+	range.src_offset = 0;
+	// 길이가 0 이면 원본 파일 끝까지 공유
+	range.src_length = 0;
+	range.dest_offset = 0;
+
+	int result = ioctl(destFd, FICLONERANGE, &range);
+
+	close(srcFd);
+	close(destFd);
+	return (result == -1) ? -1 : 0;
+}
+
+/*
+ * @fn static int _HardlinkFile(const char *srcPath, const char *destPath)
+ * @brief 대상 파일을 원본 파일의 하드링크로 원자적으로 교체하는 함수
+ * 같은 디렉터리에 임시 링크를 만든 후 rename 으로 대상 파일을 덮어쓴다.
+ * @param srcPath 원본 파일 경로(입력, 읽기 전용)
+ * @param destPath 대상 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 0, 실패 시 -1 반환
+ */
+static int _HardlinkFile(const char *srcPath, const char *destPath)
+{
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmlink.%ld", destPath, (long)getpid()) >= (int)sizeof(tempPath)) return -1;
+
+	unlink(tempPath);
+	if(link(srcPath, tempPath) == -1) return -1;
+	if(rename(tempPath, destPath) == -1)
+	{
+		unlink(tempPath);
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * @fn static Bool _GetDirPath(const char *path, char *dirPath, size_t size)
+ * @brief 파일 경로에서 파일이 있는 디렉터리 경로를 구하는 함수
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @param dirPath 디렉터리 경로를 저장할 버퍼(출력)
+ * @param size 버퍼 크기(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _GetDirPath(const char *path, char *dirPath, size_t size)
+{
+	if(snprintf(dirPath, size, "%s", path) >= (int)size) return False;
+
+	char *slash = strrchr(dirPath, '/');
+	if(slash == NULL) snprintf(dirPath, size, ".");
+	else if(slash == dirPath) dirPath[1] = '\0';
+	else *slash = '\0';
+	return True;
+}
+
+/*
+ * @fn static long long _GetMonotonicTime()
+ * @brief 시스템 시간 변경에 영향을 받지 않는 현재 시간을 밀리초 단위로 구하는 함수
+ * @return 현재 시간(밀리초)
+ */
+static long long _GetMonotonicTime()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000 + (long long)now.tv_nsec / 1000000;
+}
+
+/*
+ * @fn static int _OpenTempFile(const char *path)
+ * @brief 지정한 파일과 같은 디렉터리에 이름 없는 임시 파일을 여는 함수
+ * O_TMPFILE 을 지원하지 않으면 이름 있는 임시 파일을 만든 후 바로 삭제한다. 닫으면 공간이 회수된다.
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 읽기/쓰기용 파일 디스크립터, 실패 시 -1 반환
+ */
+static int _OpenTempFile(const char *path)
+{
+	char dirPath[PATH_MAX];
+	if(_GetDirPath(path, dirPath, sizeof(dirPath)) == False) return -1;
+
+	int fd = open(dirPath, O_TMPFILE | O_RDWR, 0600);
+	if(fd != -1) return fd;
+
+	char tempPath[PATH_MAX];
+	if(snprintf(tempPath, sizeof(tempPath), "%s.jfmtmp.%ld", path, (long)getpid()) >= (int)sizeof(tempPath)) return -1;
+	fd = open(tempPath, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if(fd != -1) unlink(tempPath);
+	return fd;
+}
+
+/*
+ * @fn static int _GetThreadNum(int threadNum)
+ * @brief 병렬 작업에 사용할 스레드 개수를 구하는 함수
+ * @param threadNum 사용자가 지정한 스레드 개수(입력, 0 이하이면 CPU 개수 사용)
+ * @return 항상 1 이상 MAX_THREAD_NUM 이하의 스레드 개수 반환
+ */
+static int _GetThreadNum(int threadNum)
+{
+	if(threadNum <= 0)
+	{
+		long cpuNum = sysconf(_SC_NPROCESSORS_ONLN);
+		threadNum = (cpuNum > 0) ? (int)cpuNum : 1;
+	}
+	if(threadNum > MAX_THREAD_NUM) threadNum = MAX_THREAD_NUM;
+	return threadNum;
+}
+
+/*
+ * @fn static void* _RunTaskWorker(void *arg)
+ * @brief 작업 그룹에서 작업 번호를 하나씩 가져와서 처리하는 스레드 함수
+ * @param arg 작업 그룹 구조체의 주소(입력)
+ * @return 항상 NULL 반환
+ */
+static void* _RunTaskWorker(void *arg)
+{
+	TaskGroupPtr group = (TaskGroupPtr)arg;
+
+	while(1)
+	{
+		long long taskIndex = __sync_fetch_and_add(&(group->nextTask), 1);
+		if(taskIndex >= group->taskNum) break;
+		group->func(group->arg, taskIndex);
+	}
+
+	return NULL;
+}
+
+/*
+ * @fn static int _RunTasks(TaskFunc func, void *arg, long long taskNum, int threadNum)
+ * @brief 지정한 개수의 작업을 스레드 풀에서 나눠서 처리하고 모두 끝날 때까지 기다리는 함수
+ * 호출한 스레드도 작업을 처리하며, 스레드 생성에 실패하면 남은 작업을 호출한 스레드가 처리한다.
+ * @param func 각 작업을 처리할 함수(입력)
+ * @param arg 작업 함수에 전달할 인자(입력)
+ * @param taskNum 전체 작업 개수(입력)
+ * @param threadNum 사용할 스레드 개수(입력, 0 이하이면 CPU 개수 사용)
+ * @return 성공 시 0, 실패 시 -1 반환
+ */
+static int _RunTasks(TaskFunc func, void *arg, long long taskNum, int threadNum)
+{
+	if((func == NULL) || (taskNum < 0)) return -1;
+	if(taskNum == 0) return 0;
+
+	TaskGroup group;
+	group.func = func;
+	group.arg = arg;
+	group.taskNum = taskNum;
+	group.nextTask = 0;
+
+	threadNum = _GetThreadNum(threadNum);
+	if(threadNum > taskNum) threadNum = (int)taskNum;
+
+	pthread_t threads[MAX_THREAD_NUM];
+	int createdNum = 0;
+	for( ; createdNum < threadNum - 1; createdNum++)
+	{
+		if(pthread_create(&threads[createdNum], NULL, _RunTaskWorker, &group) != 0) break;
+	}
+
+	_RunTaskWorker(&group);
+
+	int threadIndex = 0;
+	for( ; threadIndex < createdNum; threadIndex++)
+	{
+		pthread_join(threads[threadIndex], NULL);
+	}
+
+	return 0;
+}
+
+/*
+ * @fn static ssize_t _ReadFull(int fd, void *buf, size_t length, off_t offset)
+ * @brief 지정한 위치에서 지정한 길이만큼 읽거나 파일 끝까지 읽는 함수
+ * @param fd 파일 디스크립터(입력)
+ * @param buf 읽은 내용을 저장할 버퍼(출력)
+ * @param length 읽을 길이(입력)
+ * @param offset 읽기 시작할 위치(입력)
+ * @return 성공 시 읽은 길이, 실패 시 -1 반환
+ */
+static ssize_t _ReadFull(int fd, void *buf, size_t length, off_t offset)
+{
+	size_t readSize = 0;
+	while(readSize < length)
+	{
+		ssize_t n = pread(fd, (char*)buf + readSize, length - readSize, offset + (off_t)readSize);
+		if(n < 0)
+		{
+			if(errno == EINTR) continue;
+			return -1;
+		}
+		if(n == 0) break;
+		readSize += (size_t)n;
+	}
+	return (ssize_t)readSize;
+}
+
+/*
+ * @fn static void _AdviseAccess(int fd, off_t offset, off_t length, JFMAccessPolicy policy)
+ * @brief 파일 접근 방식을 posix_fadvise 로 커널에 알려서 미리 읽기 동작을 조정하는 함수
+ * 힌트일 뿐이므로 실패해도 무시한다.
+ * @param fd 파일 디스크립터(입력)
+ * @param offset 적용할 구간의 시작 위치(입력)
+ * @param length 적용할 구간의 길이(입력, 0 이면 파일 끝까지)
+ * @param policy 파일 접근 방식(입력)
+ * @return 반환값 없음
+ */
+static void _AdviseAccess(int fd, off_t offset, off_t length, JFMAccessPolicy policy)
+{
+	switch(policy)
+	{
+		case JFMAccessSequential:
+			posix_fadvise(fd, offset, length, POSIX_FADV_SEQUENTIAL);
+			break;
+		case JFMAccessRandom:
+			posix_fadvise(fd, offset, length, POSIX_FADV_RANDOM);
+			break;
+		case JFMAccessOnce:
+			posix_fadvise(fd, offset, length, POSIX_FADV_SEQUENTIAL);
+			posix_fadvise(fd, offset, length, POSIX_FADV_NOREUSE);
+			break;
+		case JFMAccessWillNeed:
+			posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED);
+			break;
+		default:
+			break;
+	}
+}
+
+/*
+ * @fn static void _DropCache(int fd, off_t offset, off_t length, Bool isWritten)
+ * @brief 지정한 구간의 페이지 캐시를 비우는 함수(POSIX_FADV_DONTNEED)
+ * 디스크에 반영되지 않은 페이지는 비워지지 않으므로, 새로 쓴 파일은 sync_file_range 로 먼저 내보낸다.
+ * @param fd 파일 디스크립터(입력)
+ * @param offset 비울 구간의 시작 위치(입력)
+ * @param length 비울 구간의 길이(입력, 0 이면 파일 끝까지)
+ * @param isWritten 구간에 새로 쓴 내용이 있는지 여부(입력, Bool 열거형 참고)
+ * @return 반환값 없음
+ */
+static void _DropCache(int fd, off_t offset, off_t length, Bool isWritten)
+{
+	if(isWritten == True)
+	{
+		sync_file_range(fd, (off64_t)offset, (off64_t)length, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+	}
+	posix_fadvise(fd, offset, length, POSIX_FADV_DONTNEED);
+}
+
+/*
+ * @fn static ssize_t _WriteFull(int fd, const void *buf, size_t length, off_t offset)
+ * @brief 지정한 위치에 지정한 길이만큼 모두 쓰는 함수
+ * @param fd 파일 디스크립터(입력)
+ * @param buf 쓸 내용이 저장된 버퍼(입력, 읽기 전용)
+ * @param length 쓸 길이(입력)
+ * @param offset 쓰기 시작할 위치(입력)
+ * @return 성공 시 쓴 길이, 실패 시 -1 반환
+ */
+static ssize_t _WriteFull(int fd, const void *buf, size_t length, off_t offset)
+{
+	size_t writtenSize = 0;
+	while(writtenSize < length)
+	{
+		ssize_t n = pwrite(fd, (const char*)buf + writtenSize, length - writtenSize, offset + (off_t)writtenSize);
+		if(n < 0)
+		{
+			if(errno == EINTR) continue;
+			return -1;
+		}
+		writtenSize += (size_t)n;
+	}
+	return (ssize_t)writtenSize;
+}
+
+/*
+ * @fn static ssize_t _WriteVFull(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+ * @brief 여러 버퍼의 내용을 지정한 위치부터 이어서 모두 쓰는 함수
+ * pwritev 로 한 번에 쓰고, 일부만 쓰였으면 남은 부분을 버퍼별로 이어서 쓴다.
+ * @param fd 파일 디스크립터(입력)
+ * @param iov 쓸 내용이 저장된 버퍼 배열(입력, 읽기 전용)
+ * @param iovcnt 버퍼 개수(입력)
+ * @param offset 쓰기 시작할 위치(입력)
+ * @return 성공 시 쓴 길이, 실패 시 -1 반환
+ */
+static ssize_t _WriteVFull(int fd, const struct iovec *iov, int iovcnt, off_t offset)
+{
+	size_t totalLength = 0;
+	int iovIndex = 0;
+	for( ; iovIndex < iovcnt; iovIndex++)
+	{
+		totalLength += iov[iovIndex].iov_len;
+	}
+
+	ssize_t n = -1;
+	do
+	{
+		n = pwritev(fd, iov, iovcnt, offset);
+	}
+	while((n < 0) && (errno == EINTR));
+	if(n < 0) return -1;
+
+	// 이미 쓴 버퍼는 건너뛰고 남은 부분만 쓴다.
+	size_t writtenSize = (size_t)n;
+	size_t iovStart = 0;
+	for(iovIndex = 0; (iovIndex < iovcnt) && (writtenSize < totalLength); iovIndex++)
+	{
+		size_t length = iov[iovIndex].iov_len;
+		if(iovStart + length > writtenSize)
+		{
+			size_t skip = writtenSize - iovStart;
+			if(_WriteFull(fd, (const char*)iov[iovIndex].iov_base + skip, length - skip, offset + (off_t)writtenSize) < 0) return -1;
+			writtenSize += length - skip;
+		}
+		iovStart += length;
+	}
+
+	return (ssize_t)writtenSize;
+}
+
+/*
+ * @fn static int _CopyFull(int srcFd, int destFd)
+ * @brief 원본 파일의 전체 내용을 대상 파일에 복사하는 함수
+ * SEEK_DATA/SEEK_HOLE 로 데이터가 있는 구간만 찾아서 복사하므로 원본의 구멍(hole)은 대상 파일에서도 구멍으로 유지된다.
+ * 파일 시스템이 SEEK_DATA 를 지원하지 않으면 전체를 하나의 데이터 구간으로 복사한다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destFd 대상 파일 디스크립터(입력, 비어 있는 파일)
+ * @return 성공 시 0, 실패 시 -1 반환
+ */
+static int _CopyFull(int srcFd, int destFd)
+{
+	FileStatus srcStat;
+	if(fstat(srcFd, &srcStat) == -1) return -1;
+
+	off_t srcSize = srcStat.st_size;
+	if(_CopyDataRange(srcFd, destFd, 0, srcSize) == -1) return -1;
+
+	// 끝부분이 구멍이면 크기를 맞춰서 구멍으로 남긴다.
+	if(ftruncate(destFd, srcSize) == -1) return -1;
+	return 0;
+}
+
+/*
+ * @fn static int _CopyDirect(const char *srcPath, int srcFd, const char *destPath, int destFd)
+ * @brief 페이지 캐시를 거치지 않고(O_DIRECT) 원본 파일의 전체 내용을 대상 파일에 복사하는 함수
+ * 정렬된 버퍼 DIRECT_BUF_NUM 개를 돌려 쓰면서 읽기 스레드가 다음 구간을 읽는 동안 호출한 스레드가 앞 구간을 쓴다.
+ * DIRECT_ALIGN 단위로 맞출 수 없는 끝부분은 일반 파일 디스크립터로 복사한다.
+ * 파일 시스템이 O_DIRECT 를 지원하지 않으면 _CopyFull 로 복사한다.
+ * 원본의 구멍(hole)은 대상 파일에서 0 으로 채워진다.
+ * @param srcPath 원본 파일 경로(입력, 읽기 전용)
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destPath 대상 파일 경로(입력, 읽기 전용)
+ * @param destFd 대상 파일 디스크립터(입력, 비어 있는 파일)
+ * @return 성공 시 0, 실패 시 -1 반환
+ */
+static int _CopyDirect(const char *srcPath, int srcFd, const char *destPath, int destFd)
+{
+	FileStatus srcStat;
+	if(fstat(srcFd, &srcStat) == -1) return -1;
+
+	off_t srcSize = srcStat.st_size;
+	off_t alignedSize = srcSize - (srcSize % DIRECT_ALIGN);
+
+	DirectCopy direct;
+	direct.srcFd = (alignedSize > 0) ? open(srcPath, O_RDONLY | O_DIRECT) : -1;
+	direct.destFd = (alignedSize > 0) ? open(destPath, O_WRONLY | O_DIRECT) : -1;
+	if((direct.srcFd == -1) || (direct.destFd == -1))
+	{
+		if(direct.srcFd != -1) close(direct.srcFd);
+		if(direct.destFd != -1) close(direct.destFd);
+		return _CopyFull(srcFd, destFd);
+	}
+
+	direct.length = alignedSize;
+	direct.readCount = 0;
+	direct.writeCount = 0;
+	direct.isFailed = False;
+
+	int bufIndex = 0;
+	for( ; bufIndex < DIRECT_BUF_NUM; bufIndex++)
+	{
+		void *buf = NULL;
+		if(posix_memalign(&buf, DIRECT_ALIGN, DIRECT_BUF_SIZE) != 0)
+		{
+			buf = NULL;
+			direct.isFailed = True;
+		}
+		direct.bufList[bufIndex] = (char*)buf;
+	}
+
+	pthread_mutex_init(&(direct.mutex), NULL);
+	pthread_cond_init(&(direct.cond), NULL);
+
+	pthread_t reader;
+	Bool isReaderRunning = False;
+	if(direct.isFailed == False)
+	{
+		if(pthread_create(&reader, NULL, _CopyDirectReader, &direct) == 0) isReaderRunning = True;
+		else direct.isFailed = True;
+	}
+
+	// 읽기 스레드가 채운 버퍼를 순서대로 쓴다.
+	long long chunkNum = (long long)((alignedSize + DIRECT_BUF_SIZE - 1) / DIRECT_BUF_SIZE);
+	long long chunkIndex = 0;
+	for( ; (chunkIndex < chunkNum) && (isReaderRunning == True); chunkIndex++)
+	{
+		pthread_mutex_lock(&(direct.mutex));
+		while((direct.readCount == chunkIndex) && (direct.isFailed == False))
+		{
+			pthread_cond_wait(&(direct.cond), &(direct.mutex));
+		}
+		Bool isFailed = direct.isFailed;
+		pthread_mutex_unlock(&(direct.mutex));
+		if(isFailed == True) break;
+
+		off_t offset = (off_t)chunkIndex * DIRECT_BUF_SIZE;
+		size_t length = ((alignedSize - offset) < DIRECT_BUF_SIZE) ? (size_t)(alignedSize - offset) : DIRECT_BUF_SIZE;
+		Bool isWritten = (_WriteFull(direct.destFd, direct.bufList[chunkIndex % DIRECT_BUF_NUM], length, offset) == (ssize_t)length) ? True : False;
+
+		pthread_mutex_lock(&(direct.mutex));
+		if(isWritten == True) direct.writeCount++;
+		else direct.isFailed = True;
+		pthread_cond_broadcast(&(direct.cond));
+		pthread_mutex_unlock(&(direct.mutex));
+	}
+
+	if(isReaderRunning == True) pthread_join(reader, NULL);
+	pthread_cond_destroy(&(direct.cond));
+	pthread_mutex_destroy(&(direct.mutex));
+	for(bufIndex = 0; bufIndex < DIRECT_BUF_NUM; bufIndex++)
+	{
+		if(direct.bufList[bufIndex] != NULL) free(direct.bufList[bufIndex]);
+	}
+
+	int result = (direct.isFailed == True) ? -1 : 0;
+	if(close(direct.destFd) == -1) result = -1;
+	close(direct.srcFd);
+
+	if((result == 0) && (srcSize > alignedSize)) result = _CopyRangeTo(srcFd, alignedSize, destFd, alignedSize, srcSize - alignedSize);
+	if((result == 0) && (ftruncate(destFd, srcSize) == -1)) result = -1;
+	return result;
+}
+
+/*
+ * @fn static void* _CopyDirectReader(void *arg)
+ * @brief O_DIRECT 복사에서 원본 파일을 구간 단위로 읽어서 비어 있는 버퍼를 채우는 스레드 함수
+ * 모든 버퍼가 아직 쓰이지 않았으면 하나가 빌 때까지 기다린다.
+ * @param arg O_DIRECT 복사 정보의 주소(입력)
+ * @return 항상 NULL 반환
+ */
+static void* _CopyDirectReader(void *arg)
+{
+	DirectCopyPtr direct = (DirectCopyPtr)arg;
+	long long chunkNum = (long long)((direct->length + DIRECT_BUF_SIZE - 1) / DIRECT_BUF_SIZE);
+
+	long long chunkIndex = 0;
+	for( ; chunkIndex < chunkNum; chunkIndex++)
+	{
+		pthread_mutex_lock(&(direct->mutex));
+		while((chunkIndex - direct->writeCount >= DIRECT_BUF_NUM) && (direct->isFailed == False))
+		{
+			pthread_cond_wait(&(direct->cond), &(direct->mutex));
+		}
+		Bool isFailed = direct->isFailed;
+		pthread_mutex_unlock(&(direct->mutex));
+		if(isFailed == True) break;
+
+		off_t offset = (off_t)chunkIndex * DIRECT_BUF_SIZE;
+		size_t length = ((direct->length - offset) < DIRECT_BUF_SIZE) ? (size_t)(direct->length - offset) : DIRECT_BUF_SIZE;
+		Bool isRead = (_ReadFull(direct->srcFd, direct->bufList[chunkIndex % DIRECT_BUF_NUM], length, offset) == (ssize_t)length) ? True : False;
+
+		pthread_mutex_lock(&(direct->mutex));
+		if(isRead == True) direct->readCount++;
+		else direct->isFailed = True;
+		pthread_cond_broadcast(&(direct->cond));
+		pthread_mutex_unlock(&(direct->mutex));
+	}
+
+	return NULL;
+}
+
+/*
+ * @fn static int _CopyResume(int srcFd, const char *destPath, int destFd, const JFMCopyOptionPtr option)
+ * @brief 체크포인트를 남기면서 원본 파일을 처음부터 순서대로 복사하고, 중단된 복사가 있으면 마지막 체크포인트부터 이어서 복사하는 함수
+ * 체크포인트 간격마다 대상 파일을 디스크에 기록(fdatasync)한 후 완료 위치, 원본 크기와 수정 시간, 마지막 구간의 체크섬을 체크포인트 파일(대상 경로 + RESUME_SUFFIX)에 남긴다.
+ * 다시 시작할 때 체크포인트가 원본과 대상 파일에 맞지 않으면 처음부터 복사하고, 복사를 마치면 체크포인트 파일을 지운다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destPath 대상 경로(입력, 읽기 전용, 체크포인트 파일 경로를 만들 때 사용)
+ * @param destFd 대상 파일 디스크립터(입력, 잘라내지 않고 읽기 쓰기로 연 파일)
+ * @param option 복사 옵션(입력, 읽기 전용, blockSize 를 체크포인트 간격으로 사용)
+ * @return 성공 시 0, 실패 시 -1 반환(체크포인트 파일은 남겨 둔다)
+ */
+static int _CopyResume(int srcFd, const char *destPath, int destFd, const JFMCopyOptionPtr option)
+{
+	FileStatus srcStat;
+	if(fstat(srcFd, &srcStat) == -1) return -1;
+
+	char checkpointPath[PATH_MAX];
+	if(snprintf(checkpointPath, sizeof(checkpointPath), "%s%s", destPath, RESUME_SUFFIX) >= (int)sizeof(checkpointPath)) return -1;
+
+	int checkpointFd = open(checkpointPath, O_RDWR | O_CREAT, 0666);
+	if(checkpointFd == -1) return -1;
+
+	char *buf = (char*)malloc(COPY_BUF_SIZE);
+	if(buf == NULL)
+	{
+		close(checkpointFd);
+		return -1;
+	}
+
+	// 체크포인트 이후에 쓴 내용은 믿을 수 없으므로 잘라내고 그 위치부터 다시 쓴다.
+	off_t offset = _CopyResumeValidate(&srcStat, destFd, checkpointFd, buf);
+	int result = (ftruncate(destFd, offset) == -1) ? -1 : 0;
+
+	off_t interval = ((option->blockSize > 0) ? (off_t)option->blockSize : RESUME_CHECKPOINT_SIZE);
+	off_t checkpointOffset = offset;
+	unsigned long long checksum = CHECKSUM_SEED;
+
+	while((result == 0) && (offset < srcStat.st_size))
+	{
+		off_t length = srcStat.st_size - offset;
+		if(length > COPY_BUF_SIZE) length = COPY_BUF_SIZE;
+		if(length > checkpointOffset + interval - offset) length = checkpointOffset + interval - offset;
+
+		if((_ReadFull(srcFd, buf, (size_t)length, offset) != (ssize_t)length)
+			|| (_WriteFull(destFd, buf, (size_t)length, offset) != (ssize_t)length))
+		{
+			result = -1;
+			break;
+		}
+
+		checksum = _Checksum(buf, (size_t)length, checksum);
+		offset += length;
+		if(offset - checkpointOffset < interval) continue;
+
+		// 대상 파일에 실제로 기록된 후에 체크포인트를 남겨야 다시 시작할 때 그 위치까지를 믿을 수 있다.
+		if(fdatasync(destFd) == -1)
+		{
+			result = -1;
+			break;
+		}
+
+		CopyCheckpoint checkpoint;
+		memcpy(checkpoint.magic, RESUME_MAGIC, sizeof(checkpoint.magic));
+		checkpoint.srcSize = (long long)srcStat.st_size;
+		checkpoint.srcDev = (long long)srcStat.st_dev;
+		checkpoint.srcIno = (long long)srcStat.st_ino;
+		checkpoint.srcMtimeSec = (long long)srcStat.st_mtim.tv_sec;
+		checkpoint.srcMtimeNsec = (long long)srcStat.st_mtim.tv_nsec;
+		checkpoint.offset = (long long)offset;
+		checkpoint.checksumLength = (long long)(offset - checkpointOffset);
+		checkpoint.checksum = checksum;
+		checkpoint.headerChecksum = _Checksum(&checkpoint, sizeof(CopyCheckpoint) - sizeof(unsigned long long), CHECKSUM_SEED);
+		// 체크포인트를 남기지 못해도 이전 체크포인트부터 이어서 복사할 수 있으므로 복사는 계속한다.
+		_WriteFull(checkpointFd, &checkpoint, sizeof(CopyCheckpoint), 0);
+
+		checkpointOffset = offset;
+		checksum = CHECKSUM_SEED;
+	}
+
+	free(buf);
+	close(checkpointFd);
+	if(result == -1) return -1;
+
+	unlink(checkpointPath);
+	return 0;
+}
+
+/*
+ * @fn static off_t _CopyResumeValidate(const FileStatus *srcStat, int destFd, int checkpointFd, char *buf)
+ * @brief 체크포인트 파일을 읽고 원본과 대상 파일에 맞는지 확인해서 이어서 복사할 위치를 구하는 함수
+ * 원본의 크기, 수정 시간, 장치와 inode 번호가 같고, 대상 파일의 마지막 체크포인트 구간 체크섬이 같아야 이어서 복사한다.
+ * @param srcStat 원본 파일 정보(입력, 읽기 전용)
+ * @param destFd 대상 파일 디스크립터(입력)
+ * @param checkpointFd 체크포인트 파일 디스크립터(입력)
+ * @param buf 대상 파일을 읽을 때 사용할 COPY_BUF_SIZE 크기의 버퍼(출력)
+ * @return 이어서 복사할 위치 반환(체크포인트가 없거나 맞지 않으면 0)
+ */
+static off_t _CopyResumeValidate(const FileStatus *srcStat, int destFd, int checkpointFd, char *buf)
+{
+	CopyCheckpoint checkpoint;
+	if(_ReadFull(checkpointFd, &checkpoint, sizeof(CopyCheckpoint), 0) != (ssize_t)sizeof(CopyCheckpoint)) return 0;
+	if(memcmp(checkpoint.magic, RESUME_MAGIC, sizeof(checkpoint.magic)) != 0) return 0;
+	// 체크포인트를 기록하는 중에 중단되면 내용이 섞일 수 있다.
+	if(_Checksum(&checkpoint, sizeof(CopyCheckpoint) - sizeof(unsigned long long), CHECKSUM_SEED) != checkpoint.headerChecksum) return 0;
+
+	if((checkpoint.srcSize != (long long)srcStat->st_size)
+		|| (checkpoint.srcDev != (long long)srcStat->st_dev)
+		|| (checkpoint.srcIno != (long long)srcStat->st_ino)
+		|| (checkpoint.srcMtimeSec != (long long)srcStat->st_mtim.tv_sec)
+		|| (checkpoint.srcMtimeNsec != (long long)srcStat->st_mtim.tv_nsec)) return 0;
+
+	FileStatus destStat;
+	if((fstat(destFd, &destStat) == -1) || ((long long)destStat.st_size < checkpoint.offset)) return 0;
+	if((checkpoint.checksumLength <= 0) || (checkpoint.checksumLength > checkpoint.offset)) return 0;
+
+	// 마지막 체크포인트 구간만 다시 읽어서 대상 파일이 그동안 바뀌지 않았는지 확인한다.
+	unsigned long long checksum = CHECKSUM_SEED;
+	off_t offset = (off_t)(checkpoint.offset - checkpoint.checksumLength);
+	while(offset < (off_t)checkpoint.offset)
+	{
+		off_t length = (off_t)checkpoint.offset - offset;
+		if(length > COPY_BUF_SIZE) length = COPY_BUF_SIZE;
+		if(_ReadFull(destFd, buf, (size_t)length, offset) != (ssize_t)length) return 0;
+		checksum = _Checksum(buf, (size_t)length, checksum);
+		offset += length;
+	}
+
+	return (checksum == checkpoint.checksum) ? (off_t)checkpoint.offset : 0;
+}
+
+/*
+ * @fn static unsigned long long _Checksum(const void *data, size_t length, unsigned long long checksum)
+ * @brief 데이터의 64 비트 FNV-1a 체크섬을 구하는 함수
+ * 앞 구간의 결과를 checksum 으로 넘기면 여러 구간에 걸쳐 이어서 구할 수 있다.
+ * @param data 데이터(입력, 읽기 전용)
+ * @param length 데이터 길이(입력)
+ * @param checksum 이어서 구할 체크섬(입력, 처음이면 CHECKSUM_SEED)
+ * @return 항상 체크섬 반환
+ */
+static unsigned long long _Checksum(const void *data, size_t length, unsigned long long checksum)
+{
+	const unsigned char *s = (const unsigned char*)data;
+	size_t position = 0;
+	for( ; position < length; position++)
+	{
+		checksum ^= (unsigned long long)s[position];
+		checksum *= 1099511628211ULL;
+	}
+	return checksum;
+}
+
+/*
+ * @fn static void _CopyMultiBlock(void *arg, long long taskIndex)
+ * @brief 여러 대상 복사에서 현재 블록을 대상 파일 하나에 쓰거나 다음 블록을 미리 읽는 작업 함수
+ * 작업 번호가 대상 파일 개수보다 작으면 해당 대상 파일에 쓰고, 같으면 다음 블록을 다른 버퍼에 읽는다.
+ * @param arg 여러 대상 복사 정보(MultiCopyPtr)(입력)
+ * @param taskIndex 작업 번호(입력)
+ * @return 반환값 없음
+ */
+static void _CopyMultiBlock(void *arg, long long taskIndex)
+{
+	MultiCopyPtr multi = (MultiCopyPtr)arg;
+	long long blockIndex = multi->blockIndex;
+
+	if(taskIndex == (long long)multi->destNum) blockIndex++;
+
+	off_t offset = (off_t)blockIndex * MULTI_COPY_BUF_SIZE;
+	off_t length = multi->length - offset;
+	if(length > MULTI_COPY_BUF_SIZE) length = MULTI_COPY_BUF_SIZE;
+	char *buf = multi->bufList[blockIndex % 2];
+
+	if(taskIndex == (long long)multi->destNum)
+	{
+		if(_ReadFull(multi->srcFd, buf, (size_t)length, multi->srcOffset + offset) != (ssize_t)length) multi->isFailed = True;
+	}
+	else
+	{
+		if(_WriteFull(multi->destFdList[taskIndex], buf, (size_t)length, offset) != (ssize_t)length) multi->isFailed = True;
+	}
+}
+
+/*
+ * @fn static void _ConcatFilesPiece(void *arg, long long taskIndex)
+ * @brief 파일 이어 붙이기에서 입력 파일 하나의 내용을 대상 파일의 정해진 위치에 복사하는 작업 함수
+ * 원본과 대상 위치가 모두 블록 경계에 맞으면 블록 단위 부분은 리플링크(FICLONERANGE)로 공유하고, 나머지는 _CopyRangeTo 로 복사한다.
+ * @param arg 파일 이어 붙이기 정보(ConcatCopyPtr)(입력)
+ * @param taskIndex 작업 번호(입력, 입력 파일 순서)
+ * @return 반환값 없음
+ */
+static void _ConcatFilesPiece(void *arg, long long taskIndex)
+{
+	ConcatCopyPtr concat = (ConcatCopyPtr)arg;
+	ConcatPiecePtr piece = &(concat->pieceList[taskIndex]);
+	off_t clonedLength = 0;
+
+	if((concat->blockSize > 0) && ((piece->srcOffset % concat->blockSize) == 0) && ((piece->destOffset % concat->blockSize) == 0))
+	{
+		struct file_clone_range range;
+		range.src_fd = piece->srcFd;
+		range.src_offset = (unsigned long long)piece->srcOffset;
+		range.src_length = (unsigned long long)(piece->length - (piece->length % concat->blockSize));
+		range.dest_offset = (unsigned long long)piece->destOffset;
+		if((range.src_length > 0) && (ioctl(concat->destFd, FICLONERANGE, &range) == 0)) clonedLength = (off_t)range.src_length;
+	}
+
+	if(_CopyRangeTo(piece->srcFd, piece->srcOffset + clonedLength, concat->destFd, piece->destOffset + clonedLength, piece->length - clonedLength) == -1) concat->isFailed = True;
+}
+
+/*
+ * @fn static void _SplitFilePiece(void *arg, long long taskIndex)
+ * @brief 파일 나누기에서 조각 하나의 내용을 원본에서 조각 파일로 복사하는 작업 함수
+ * @param arg 파일 나누기 정보(SplitCopyPtr)(입력)
+ * @param taskIndex 작업 번호(입력, 조각 순서)
+ * @return 반환값 없음
+ */
+static void _SplitFilePiece(void *arg, long long taskIndex)
+{
+	SplitCopyPtr split = (SplitCopyPtr)arg;
+	SplitPiecePtr piece = &(split->pieceList[taskIndex]);
+	if(_CopyRangeTo(split->srcFd, split->srcOffset + piece->offset, piece->destFd, 0, piece->length) == -1) split->isFailed = True;
+}
+
+/*
+ * @fn static Bool _CheckSplitPattern(const char *pattern)
+ * @brief 조각 파일 경로 형식 문자열이 정수 변환 하나만 가지는지 검사하는 함수
+ * "%%" 외에는 플래그와 폭을 지정할 수 있는 %d 변환 하나만 허용한다(예: "./part_%03d.txt").
+ * @param pattern 조각 파일 경로 형식 문자열(입력, 읽기 전용)
+ * @return 올바르면 True, 아니면 False 반환(Bool 열거형 참고)
+ */
+static Bool _CheckSplitPattern(const char *pattern)
+{
+	int conversionNum = 0;
+	const char *s = pattern;
+	for( ; *s != '\0'; s++)
+	{
+		if(*s != '%') continue;
+		s++;
+		if(*s == '%') continue;
+		while((*s == '0') || (*s == '-') || (*s == '+') || (*s == ' ')) s++;
+		while((*s >= '0') && (*s <= '9')) s++;
+		if(*s != 'd') return False;
+		conversionNum++;
+	}
+	return (conversionNum == 1) ? True : False;
+}
+
+/*
+ * @fn static double _ParseSortNumber(const char *s)
+ * @brief 라인 앞의 숫자 값을 로케일과 상관없이 읽는 함수
+ * 앞쪽 공백과 탭, 부호 하나 다음에 숫자나 ".숫자" 가 와야 하고, 소수점 뒤까지만 읽는다(지수, 16 진수, nan, inf 는 읽지 않음).
+ * @param s 라인 시작 주소(입력, 읽기 전용, '\0' 으로 끝나야 함)
+ * @return 읽은 숫자 값, 숫자로 시작하지 않으면 0 반환
+ */
+static double _ParseSortNumber(const char *s)
+{
+	while((*s == ' ') || (*s == '\t')) s++;
+
+	double sign = 1.0;
+	if((*s == '+') || (*s == '-'))
+	{
+		if(*s == '-') sign = -1.0;
+		s++;
+	}
+
+	Bool isDigit = ((*s >= '0') && (*s <= '9')) ? True : False;
+	Bool isFraction = ((*s == '.') && (s[1] >= '0') && (s[1] <= '9')) ? True : False;
+	if((isDigit == False) && (isFraction == False)) return 0.0;
+
+	double number = 0.0;
+	for( ; (*s >= '0') && (*s <= '9'); s++)
+	{
+		number = (number * 10.0) + (double)(*s - '0');
+	}
+
+	if(*s == '.')
+	{
+		double scale = 0.1;
+		for(s++; (*s >= '0') && (*s <= '9'); s++)
+		{
+			number += (double)(*s - '0') * scale;
+			scale /= 10.0;
+		}
+	}
+	return sign * number;
+}
+
+/*
+ * @fn static void _SortLineInit(SortLinePtr line, char *s, size_t length, int flags)
+ * @brief 라인 정보에 라인 위치, 길이, 비교용 앞 8 바이트 값, 숫자 값을 저장하는 함수
+ * @param line 라인 정보의 주소(출력)
+ * @param s 라인 시작 주소(입력, '\0' 으로 끝나야 함)
+ * @param length 라인 길이(입력, 개행 문자 제외)
+ * @param flags 정렬 방식(입력, JFMSortFlag 값의 비트 조합)
+ * @return 반환값 없음
+ */
+static void _SortLineInit(SortLinePtr line, char *s, size_t length, int flags)
+{
+	line->s = s;
+	line->length = length;
+	line->prefix = 0;
+
+	// 8 바이트보다 짧은 라인은 뒤를 0 으로 채운다.
+	size_t index = 0;
+	for( ; index < sizeof(line->prefix); index++)
+	{
+		line->prefix <<= 8;
+		if(index < length) line->prefix |= (unsigned long long)(unsigned char)s[index];
+	}
+
+	// 숫자로 시작하지 않는 라인은 0 으로 본다.
+	line->number = ((flags & JFMSortNumeric) != 0) ? _ParseSortNumber(s) : 0.0;
+}
+
+/*
+ * @fn static int _CompareSortLine(const SortLine *a, const SortLine *b, int flags)
+ * @brief 정렬 방식에 따라 두 라인을 비교하는 함수
+ * 숫자 기준이면 숫자 값을 먼저 비교하고, 같으면 라인 내용을 바이트 순서로 비교한다.
+ * @param a 비교할 라인 정보의 주소(입력, 읽기 전용)
+ * @param b 비교할 라인 정보의 주소(입력, 읽기 전용)
+ * @param flags 정렬 방식(입력, JFMSortFlag 값의 비트 조합)
+ * @return a 가 앞이면 음수, 같으면 0, a 가 뒤면 양수 반환
+ */
+static int _CompareSortLine(const SortLine *a, const SortLine *b, int flags)
+{
+	if((flags & JFMSortNumeric) != 0)
+	{
+		if(a->number < b->number) return -1;
+		if(a->number > b->number) return 1;
+	}
+	if(a->prefix != b->prefix) return (a->prefix < b->prefix) ? -1 : 1;
+
+	// 두 라인이 모두 8 바이트 이상이면 앞 8 바이트는 같으므로 그 뒤부터 비교한다.
+	size_t start = ((a->length >= sizeof(a->prefix)) && (b->length >= sizeof(b->prefix))) ? sizeof(a->prefix) : 0;
+	size_t length = (a->length < b->length) ? a->length : b->length;
+	if(length > start)
+	{
+		int result = memcmp(a->s + start, b->s + start, length - start);
+		if(result != 0) return result;
+	}
+
+	if(a->length == b->length) return 0;
+	return (a->length < b->length) ? -1 : 1;
+}
+
+/*
+ * @fn static int _CompareSortLineQsort(const void *a, const void *b, void *flags)
+ * @brief qsort_r 에서 라인 정보 배열을 정렬할 때 사용하는 비교 함수
+ * @param a 비교할 라인 정보의 주소(입력, 읽기 전용)
+ * @param b 비교할 라인 정보의 주소(입력, 읽기 전용)
+ * @param flags 정렬 방식을 저장한 int 의 주소(입력, 읽기 전용)
+ * @return a 가 앞이면 음수, 같으면 0, a 가 뒤면 양수 반환
+ */
+static int _CompareSortLineQsort(const void *a, const void *b, void *flags)
+{
+	return _CompareSortLine((const SortLine*)a, (const SortLine*)b, *(const int*)flags);
+}
+
+/*
+ * @fn static Bool _SortOutputInit(SortOutputPtr output, int fd, size_t bufSize, int flags, Bool isMarking)
+ * @brief 정렬한 라인을 파일에 쓰는 출력 정보를 초기화하고 쓰기 버퍼를 할당하는 함수
+ * 실패해도 _SortOutputFree 로 해제할 수 있는 상태로 만든다.
+ * @param output 출력 정보의 주소(출력)
+ * @param fd 쓸 파일 디스크립터(입력)
+ * @param bufSize 쓰기 버퍼 크기(입력)
+ * @param flags 정렬 방식(입력, JFMSortFlag 값의 비트 조합)
+ * @param isMarking 라인 위치 색인을 만들지 여부(입력, Bool 열거형 참고)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortOutputInit(SortOutputPtr output, int fd, size_t bufSize, int flags, Bool isMarking)
+{
+	output->fd = fd;
+	output->bufSize = bufSize;
+	output->bufLength = 0;
+	output->offset = 0;
+	output->flags = flags;
+	output->lastBuf = NULL;
+	output->lastCapacity = 0;
+	output->hasLastLine = False;
+	output->lineCount = 0;
+	output->charCount = 0;
+	output->isMarking = isMarking;
+	output->markList = NULL;
+	output->markCount = 0;
+	output->markCapacity = 0;
+	output->buf = (char*)malloc(bufSize);
+	return (output->buf != NULL) ? True : False;
+}
+
+/*
+ * @fn static Bool _SortOutputWrite(SortOutputPtr output, const SortLinePtr line)
+ * @brief 라인 하나에 개행 문자를 붙여서 쓰기 버퍼에 모으는 함수
+ * 중복 제거 시 바로 앞에 쓴 라인과 같으면 쓰지 않는다. 버퍼보다 긴 라인은 버퍼를 거치지 않고 쓴다.
+ * @param output 출력 정보의 주소(출력)
+ * @param line 쓸 라인 정보의 주소(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortOutputWrite(SortOutputPtr output, const SortLinePtr line)
+{
+	if((output->flags & JFMSortUnique) != 0)
+	{
+		if((output->hasLastLine == True) && (_CompareSortLine(&(output->lastLine), line, output->flags) == 0)) return True;
+
+		// 병합 중인 라인은 읽기 버퍼가 바뀌면 사라지므로 복사해 둔다.
+		if(line->length + 1 > output->lastCapacity)
+		{
+			size_t capacity = (output->lastCapacity == 0) ? 256 : output->lastCapacity;
+			while(capacity < line->length + 1) capacity *= 2;
+			char *newBuf = (char*)realloc(output->lastBuf, capacity);
+			if(newBuf == NULL) return False;
+			output->lastBuf = newBuf;
+			output->lastCapacity = capacity;
+		}
+		memcpy(output->lastBuf, line->s, line->length);
+		output->lastBuf[line->length] = '\0';
+		output->lastLine = *line;
+		output->lastLine.s = output->lastBuf;
+		output->hasLastLine = True;
+	}
+
+	if((output->bufLength + line->length + 1 > output->bufSize) && (_SortOutputFlush(output) == False)) return False;
+	if(line->length + 1 > output->bufSize)
+	{
+		if(_WriteFull(output->fd, line->s, line->length, output->offset) != (ssize_t)line->length) return False;
+		output->offset += (off_t)line->length;
+	}
+	else
+	{
+		memcpy(output->buf + output->bufLength, line->s, line->length);
+		output->bufLength += line->length;
+	}
+	output->buf[output->bufLength++] = '\n';
+
+	output->lineCount++;
+	output->charCount += (long long)line->length;
+	if((output->isMarking == True) && ((output->lineCount % LINE_INDEX_INTERVAL) == 0))
+	{
+		if(output->markCount == output->markCapacity)
+		{
+			long long capacity = (output->markCapacity == 0) ? 16 : output->markCapacity * 2;
+			JFileLineMarkPtr newList = (JFileLineMarkPtr)realloc(output->markList, sizeof(JFileLineMark) * (size_t)capacity);
+			if(newList == NULL) return False;
+			output->markList = newList;
+			output->markCapacity = capacity;
+		}
+		output->markList[output->markCount].line = output->lineCount;
+		output->markList[output->markCount].offset = (long long)output->offset + (long long)output->bufLength;
+		output->markCount++;
+	}
+	return True;
+}
+
+/*
+ * @fn static Bool _SortOutputFlush(SortOutputPtr output)
+ * @brief 쓰기 버퍼에 모인 내용을 파일에 쓰는 함수
+ * @param output 출력 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortOutputFlush(SortOutputPtr output)
+{
+	if(output->bufLength == 0) return True;
+	if(_WriteFull(output->fd, output->buf, output->bufLength, output->offset) != (ssize_t)output->bufLength) return False;
+
+	output->offset += (off_t)output->bufLength;
+	output->bufLength = 0;
+	return True;
+}
+
+/*
+ * @fn static void _SortOutputFree(SortOutputPtr output)
+ * @brief 출력 정보가 할당한 버퍼와 라인 위치 색인 목록을 해제하는 함수(파일 디스크립터는 닫지 않음)
+ * @param output 출력 정보의 주소(출력)
+ * @return 반환값 없음
+ */
+static void _SortOutputFree(SortOutputPtr output)
+{
+	if(output->buf != NULL) free(output->buf);
+	if(output->lastBuf != NULL) free(output->lastBuf);
+	if(output->markList != NULL) free(output->markList);
+	output->buf = NULL;
+	output->lastBuf = NULL;
+	output->markList = NULL;
+}
+
+/*
+ * @fn static Bool _SortReaderNext(SortReaderPtr reader, int flags)
+ * @brief 런 임시 파일의 런 구간에서 다음 라인을 읽어서 현재 라인으로 만드는 함수
+ * 버퍼 크기 단위로 크게 읽고, 버퍼 끝에 걸친 라인은 앞으로 옮겨서 이어 읽는다. 버퍼보다 긴 라인이면 버퍼를 늘린다.
+ * @param reader 런 읽기 정보의 주소(출력)
+ * @param flags 정렬 방식(입력, JFMSortFlag 값의 비트 조합)
+ * @return 성공 시 True(런을 다 읽으면 isDone 이 True), 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortReaderNext(SortReaderPtr reader, int flags)
+{
+	while(True)
+	{
+		char *s = reader->buf + reader->start;
+		char *newline = (char*)memchr(s, '\n', reader->end - reader->start);
+		if(newline != NULL)
+		{
+			*newline = '\0';
+			_SortLineInit(&(reader->line), s, (size_t)(newline - s), flags);
+			reader->start = (size_t)(newline - reader->buf) + 1;
+			return True;
+		}
+
+		size_t remain = reader->end - reader->start;
+		memmove(reader->buf, s, remain);
+		reader->start = 0;
+		reader->end = remain;
+		if(remain == reader->bufSize)
+		{
+			char *newBuf = (char*)realloc(reader->buf, reader->bufSize * 2);
+			if(newBuf == NULL) return False;
+			reader->buf = newBuf;
+			reader->bufSize *= 2;
+		}
+
+		size_t readLength = reader->bufSize - reader->end;
+		if((off_t)readLength > reader->endOffset - reader->offset) readLength = (size_t)(reader->endOffset - reader->offset);
+		ssize_t readSize = (readLength > 0) ? _ReadFull(reader->fd, reader->buf + reader->end, readLength, reader->offset) : 0;
+		if(readSize < 0) return False;
+		if(readSize == 0)
+		{
+			// 런 파일의 라인은 모두 개행 문자로 끝나므로 남은 내용이 있으면 잘못된 파일이다.
+			reader->isDone = True;
+			return (remain == 0) ? True : False;
+		}
+		reader->offset += (off_t)readSize;
+		reader->end += (size_t)readSize;
+	}
+}
+
+/*
+ * @fn static Bool _SortMergeLess(const SortMergePtr merge, long long a, long long b)
+ * @brief 패자 트리에서 두 런의 현재 라인 중 a 가 이기는지(앞인지) 확인하는 함수
+ * 런 개수와 같은 번호는 초기화에 쓰는 가상의 최소값이고, 다 읽은 런은 최대값으로 본다.
+ * 같은 라인이면 번호가 작은 런이 이기므로 원본 순서가 유지된다.
+ * @param merge 병합 정보의 주소(입력, 읽기 전용)
+ * @param a 런 번호(입력)
+ * @param b 런 번호(입력)
+ * @return a 가 이기면 True, 아니면 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortMergeLess(const SortMergePtr merge, long long a, long long b)
+{
+	if(a == merge->readerNum) return True;
+	if(b == merge->readerNum) return False;
+	if(merge->readerList[a].isDone == True) return False;
+	if(merge->readerList[b].isDone == True) return True;
+
+	int result = _CompareSortLine(&(merge->readerList[a].line), &(merge->readerList[b].line), merge->flags);
+	return ((result < 0) || ((result == 0) && (a < b))) ? True : False;
+}
+
+/*
+ * @fn static void _SortMergeAdjust(SortMergePtr merge, long long winner)
+ * @brief 지정한 런의 라인이 바뀐 후 잎에서 뿌리까지 경기를 다시 해서 패자 트리를 고치는 함수
+ * 런 개수가 k 이면 비교는 log2(k) 번만 한다.
+ * @param merge 병합 정보의 주소(출력)
+ * @param winner 라인이 바뀐 런 번호(입력)
+ * @return 반환값 없음
+ */
+static void _SortMergeAdjust(SortMergePtr merge, long long winner)
+{
+	long long node = (winner + merge->readerNum) / 2;
+	for( ; node > 0; node /= 2)
+	{
+		if(_SortMergeLess(merge, merge->tree[node], winner) == True)
+		{
+			long long loser = winner;
+			winner = merge->tree[node];
+			merge->tree[node] = loser;
+		}
+	}
+	merge->tree[0] = winner;
+}
+
+/*
+ * @fn static Bool _SortMerge(const SortContextPtr sort, long long startIndex, long long runNum, int fd, SortOutputPtr output)
+ * @brief 임시 파일에 정렬해서 저장한 연속된 런들을 패자 트리로 병합해서 출력 정보에 쓰는 함수
+ * 런마다 정렬 작업 정보의 버퍼 크기만큼 읽기 버퍼를 쓴다.
+ * @param sort 정렬 작업 정보의 주소(입력, 읽기 전용)
+ * @param startIndex 병합할 첫 런 번호(입력)
+ * @param runNum 병합할 런 개수(입력)
+ * @param fd 런을 저장한 임시 파일 디스크립터(입력)
+ * @param output 출력 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortMerge(const SortContextPtr sort, long long startIndex, long long runNum, int fd, SortOutputPtr output)
+{
+	SortMerge merge;
+	merge.readerNum = runNum;
+	merge.flags = sort->flags;
+	merge.readerList = (SortReaderPtr)calloc((size_t)merge.readerNum, sizeof(SortReader));
+	merge.tree = (long long*)malloc(sizeof(long long) * (size_t)merge.readerNum);
+	Bool result = ((merge.readerList != NULL) && (merge.tree != NULL)) ? True : False;
+
+	long long readerIndex = 0;
+	for( ; (result == True) && (readerIndex < merge.readerNum); readerIndex++)
+	{
+		SortReaderPtr reader = &(merge.readerList[readerIndex]);
+		SortRunPtr run = &(sort->runList[startIndex + readerIndex]);
+		reader->fd = fd;
+		reader->offset = run->offset;
+		reader->endOffset = run->offset + run->length;
+		reader->bufSize = sort->bufSize;
+		reader->start = 0;
+		reader->end = 0;
+		reader->isDone = False;
+		reader->buf = (char*)malloc(reader->bufSize);
+		if((reader->buf == NULL) || (_SortReaderNext(reader, merge.flags) == False)) result = False;
+	}
+
+	if(result == True)
+	{
+		for(readerIndex = 0; readerIndex < merge.readerNum; readerIndex++)
+		{
+			merge.tree[readerIndex] = merge.readerNum;
+		}
+		for(readerIndex = merge.readerNum - 1; readerIndex >= 0; readerIndex--)
+		{
+			_SortMergeAdjust(&merge, readerIndex);
+		}
+
+		// 승자 런이 다 읽은 런이면 모든 런을 다 읽은 것이다.
+		while((result == True) && (merge.readerList[merge.tree[0]].isDone == False))
+		{
+			SortReaderPtr reader = &(merge.readerList[merge.tree[0]]);
+			if(_SortOutputWrite(output, &(reader->line)) == False) result = False;
+			else if(_SortReaderNext(reader, merge.flags) == False) result = False;
+			else _SortMergeAdjust(&merge, merge.tree[0]);
+		}
+	}
+
+	for(readerIndex = 0; (merge.readerList != NULL) && (readerIndex < merge.readerNum); readerIndex++)
+	{
+		if(merge.readerList[readerIndex].buf != NULL) free(merge.readerList[readerIndex].buf);
+	}
+	if(merge.readerList != NULL) free(merge.readerList);
+	if(merge.tree != NULL) free(merge.tree);
+	return result;
+}
+
+/*
+ * @fn static Bool _SortMergePass(SortContextPtr sort, int srcFd, int destFd)
+ * @brief 런을 병합 개수씩 묶어서 묶음마다 런 하나로 병합하는 병합 단계 하나를 실행하는 함수
+ * 묶음은 첫 런의 위치에 쓰고, 병합한 런은 원래 런들보다 길지 않으므로 묶음끼리 겹치지 않는다.
+ * 끝나면 런 목록은 병합한 런 목록으로 바뀐다.
+ * @param sort 정렬 작업 정보의 주소(출력)
+ * @param srcFd 병합할 런을 저장한 임시 파일 디스크립터(입력)
+ * @param destFd 병합한 런을 쓸 임시 파일 디스크립터(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _SortMergePass(SortContextPtr sort, int srcFd, int destFd)
+{
+	long long newRunNum = 0;
+	long long runIndex = 0;
+	for( ; runIndex < sort->runNum; runIndex += sort->mergeNum)
+	{
+		long long groupNum = sort->runNum - runIndex;
+		if(groupNum > sort->mergeNum) groupNum = sort->mergeNum;
+
+		SortOutput output;
+		Bool result = _SortOutputInit(&output, destFd, sort->bufSize, sort->flags, False);
+		output.offset = sort->runList[runIndex].offset;
+		if(result == True) result = _SortMerge(sort, runIndex, groupNum, srcFd, &output);
+		if(result == True) result = _SortOutputFlush(&output);
+		_SortOutputFree(&output);
+		if(result == False) return False;
+
+		// 새 런 번호는 묶음의 첫 런 번호보다 크지 않으므로 아직 병합하지 않은 런을 덮어쓰지 않는다.
+		off_t offset = sort->runList[runIndex].offset;
+		sort->runList[newRunNum].offset = offset;
+		sort->runList[newRunNum].length = output.offset - offset;
+		newRunNum++;
+	}
+
+	sort->runNum = newRunNum;
+	return True;
+}
+
+/*
+ * @fn static unsigned int _GetTrigram(const char *s)
+ * @brief 연속한 3 바이트를 하나의 정수(트라이그램)로 만드는 함수
+ * @param s 문자열 시작 주소(입력, 읽기 전용, 3 바이트 이상)
+ * @return 트라이그램 값(24 비트) 반환
+ */
+static unsigned int _GetTrigram(const char *s)
+{
+	return ((unsigned int)(unsigned char)s[0] << 16) | ((unsigned int)(unsigned char)s[1] << 8) | (unsigned int)(unsigned char)s[2];
+}
+
+/*
+ * @fn static void _IndexFileInit(IndexFilePtr entry, JFilePtr file)
+ * @brief 파일 색인 정보를 처음부터 색인해야 하는 빈 상태로 초기화하는 함수
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @param file 색인할 파일 정보 관리 구조체의 주소(입력)
+ * @return 반환값 없음
+ */
+static void _IndexFileInit(IndexFilePtr entry, JFilePtr file)
+{
+	memset(entry, 0, sizeof(IndexFile));
+	entry->file = file;
+	entry->dirtyOffset = 0;
+	entry->isMapped = False;
+}
+
+/*
+ * @fn static void _IndexFileFree(IndexFilePtr entry)
+ * @brief 파일 색인 정보가 할당한 메모리를 해제하는 함수(매핑된 영역은 해제하지 않음)
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @return 반환값 없음
+ */
+static void _IndexFileFree(IndexFilePtr entry)
+{
+	long long slotIndex = 0;
+	for( ; slotIndex < entry->tableSize; slotIndex++)
+	{
+		if(entry->table[slotIndex].blockList != NULL) free(entry->table[slotIndex].blockList);
+	}
+	if(entry->table != NULL) free(entry->table);
+	if((entry->isMapped == False) && (entry->blockOffsetList != NULL)) free(entry->blockOffsetList);
+
+	entry->table = NULL;
+	entry->tableSize = 0;
+	entry->trigramNum = 0;
+	entry->blockOffsetList = NULL;
+	entry->blockNum = 0;
+	entry->blockCapacity = 0;
+	entry->isMapped = False;
+}
+
+/*
+ * @fn static Bool _IndexFileToMemory(IndexFilePtr entry)
+ * @brief 색인 파일에 매핑된 색인을 풀어서 메모리 해시 테이블로 옮기는 함수(이미 메모리에 있으면 그대로 둠)
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _IndexFileToMemory(IndexFilePtr entry)
+{
+	if(entry->isMapped == False) return True;
+
+	IndexFile mapped = *entry;
+	size_t listSize = (size_t)((mapped.blockNum > 0) ? mapped.blockNum : 1);
+	long long *blockOffsetList = (long long*)malloc(sizeof(long long) * listSize);
+	unsigned int *postingList = (unsigned int*)malloc(sizeof(unsigned int) * listSize);
+	if((blockOffsetList == NULL) || (postingList == NULL))
+	{
+		if(blockOffsetList != NULL) free(blockOffsetList);
+		if(postingList != NULL) free(postingList);
+		return False;
+	}
+	memcpy(blockOffsetList, mapped.blockOffsetList, sizeof(long long) * (size_t)mapped.blockNum);
+
+	entry->isMapped = False;
+	entry->blockOffsetList = blockOffsetList;
+	entry->blockCapacity = (long long)listSize;
+
+	Bool result = True;
+	long long trigramIndex = 0;
+	for( ; (result == True) && (trigramIndex < mapped.mappedTrigramNum); trigramIndex++)
+	{
+		unsigned int trigram = mapped.mappedTrigramList[trigramIndex].trigram;
+		long long postingNum = _IndexGetPostings(&mapped, trigram, postingList);
+		if(postingNum < 0) result = False;
+
+		long long postingIndex = 0;
+		for( ; (result == True) && (postingIndex < postingNum); postingIndex++)
+		{
+			if(_IndexAddPosting(entry, trigram, postingList[postingIndex]) == False) result = False;
+		}
+	}
+
+	free(postingList);
+	entry->mappedTrigramList = NULL;
+	entry->mappedTrigramNum = 0;
+	entry->mappedPosting = NULL;
+	entry->mappedPostingSize = 0;
+
+	// 옮기지 못하면 처음부터 다시 색인한다.
+	if(result == False)
+	{
+		_IndexFileFree(entry);
+		entry->dirtyOffset = 0;
+	}
+	return result;
+}
+
+/*
+ * @fn static void _IndexFileTruncate(IndexFilePtr entry, long long blockIndex)
+ * @brief 지정한 블록과 그 뒤의 블록을 색인에서 지우는 함수(메모리 색인만 사용)
+ * 블록 번호 목록은 오름차순이므로 목록마다 끝에서부터 지운다.
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @param blockIndex 지울 첫 블록 번호(입력)
+ * @return 반환값 없음
+ */
+static void _IndexFileTruncate(IndexFilePtr entry, long long blockIndex)
+{
+	if(blockIndex >= entry->blockNum) return;
+
+	long long slotIndex = 0;
+	for( ; slotIndex < entry->tableSize; slotIndex++)
+	{
+		IndexPostingPtr slot = &(entry->table[slotIndex]);
+		while((slot->count > 0) && ((long long)slot->blockList[slot->count - 1] >= blockIndex)) slot->count--;
+	}
+	entry->blockNum = blockIndex;
+}
+
+/*
+ * @fn static long long _IndexFindBlock(const IndexFilePtr entry, long long offset)
+ * @brief 지정한 위치를 포함하는 블록 번호를 찾는 함수
+ * @param entry 파일 색인 정보의 주소(입력, 읽기 전용)
+ * @param offset 찾을 위치(입력)
+ * @return 지정한 위치 앞에서 시작하는 마지막 블록 번호(블록이 없으면 0) 반환
+ */
+static long long _IndexFindBlock(const IndexFilePtr entry, long long offset)
+{
+	long long low = 0;
+	long long high = entry->blockNum - 1;
+	long long blockIndex = 0;
+	while(low <= high)
+	{
+		long long mid = low + (high - low) / 2;
+		if(entry->blockOffsetList[mid] <= offset)
+		{
+			blockIndex = mid;
+			low = mid + 1;
+		}
+		else high = mid - 1;
+	}
+	return blockIndex;
+}
+
+/*
+ * @fn static IndexPostingPtr _IndexFindSlot(const IndexFilePtr entry, unsigned int trigram)
+ * @brief 트라이그램 해시 테이블에서 트라이그램의 슬롯이나 넣을 빈 슬롯을 찾는 함수(선형 탐사)
+ * @param entry 파일 색인 정보의 주소(입력, 읽기 전용, 테이블이 할당되어 있어야 함)
+ * @param trigram 찾을 트라이그램(입력)
+ * @return 트라이그램의 슬롯 주소(없으면 빈 슬롯 주소) 반환
+ */
+static IndexPostingPtr _IndexFindSlot(const IndexFilePtr entry, unsigned int trigram)
+{
+	unsigned int key = trigram + 1;
+	unsigned long long mask = (unsigned long long)entry->tableSize - 1;
+	unsigned long long slotIndex = (((unsigned long long)key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	while((entry->table[slotIndex].key != 0) && (entry->table[slotIndex].key != key))
+	{
+		slotIndex = (slotIndex + 1) & mask;
+	}
+	return &(entry->table[slotIndex]);
+}
+
+/*
+ * @fn static Bool _IndexAddPosting(IndexFilePtr entry, unsigned int trigram, unsigned int blockIndex)
+ * @brief 트라이그램의 블록 번호 목록 끝에 블록 번호를 추가하는 함수
+ * 블록은 순서대로 색인하므로 마지막 번호와 같으면 추가하지 않는다. 테이블이 반 이상 차면 두 배로 늘린다.
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @param trigram 트라이그램(입력)
+ * @param blockIndex 블록 번호(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _IndexAddPosting(IndexFilePtr entry, unsigned int trigram, unsigned int blockIndex)
+{
+	if(entry->trigramNum * 2 >= entry->tableSize)
+	{
+		long long tableSize = (entry->tableSize == 0) ? INDEX_TABLE_SIZE : entry->tableSize * 2;
+		IndexPostingPtr table = (IndexPostingPtr)calloc((size_t)tableSize, sizeof(IndexPosting));
+		if(table == NULL) return False;
+
+		IndexFile resized = *entry;
+		resized.table = table;
+		resized.tableSize = tableSize;
+		long long slotIndex = 0;
+		for( ; slotIndex < entry->tableSize; slotIndex++)
+		{
+			if(entry->table[slotIndex].key == 0) continue;
+			*_IndexFindSlot(&resized, entry->table[slotIndex].key - 1) = entry->table[slotIndex];
+		}
+		if(entry->table != NULL) free(entry->table);
+		entry->table = table;
+		entry->tableSize = tableSize;
+	}
+
+	IndexPostingPtr slot = _IndexFindSlot(entry, trigram);
+	if(slot->key == 0)
+	{
+		slot->key = trigram + 1;
+		entry->trigramNum++;
+	}
+	if((slot->count > 0) && (slot->blockList[slot->count - 1] == blockIndex)) return True;
+
+	if(slot->count == slot->capacity)
+	{
+		unsigned int capacity = (slot->capacity == 0) ? 4 : slot->capacity * 2;
+		unsigned int *newList = (unsigned int*)realloc(slot->blockList, sizeof(unsigned int) * capacity);
+		if(newList == NULL) return False;
+		slot->blockList = newList;
+		slot->capacity = capacity;
+	}
+	slot->blockList[slot->count++] = blockIndex;
+	return True;
 }
 
 /*
- * @fn void* JFMSetUserData(JFMPtr fm, void *userData)
- * @brief 파일 관리 구조체 객체에 사용자 데이터를 저장하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param userData 저장할 데이터의 주소(입력)
- * @return 성공 시 저장된 사용자 데이터의 주소, 실패 시 NULL 반환
+ * @fn static Bool _IndexAddBlock(IndexFilePtr entry, long long offset)
+ * @brief 새 블록의 시작 위치를 블록 시작 위치 목록에 추가하는 함수
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @param offset 블록 시작 위치(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
  */
-void* JFMSetUserData(JFMPtr fm, void *userData)
+static Bool _IndexAddBlock(IndexFilePtr entry, long long offset)
 {
-	if((fm == NULL) || (userData == NULL)) return NULL;
-	return fm->userData = userData;
+	if(entry->blockNum == entry->blockCapacity)
+	{
+		long long capacity = (entry->blockCapacity == 0) ? 16 : entry->blockCapacity * 2;
+		long long *newList = (long long*)realloc(entry->blockOffsetList, sizeof(long long) * (size_t)capacity);
+		if(newList == NULL) return False;
+		entry->blockOffsetList = newList;
+		entry->blockCapacity = capacity;
+	}
+	entry->blockOffsetList[entry->blockNum++] = offset;
+	return True;
 }
 
 /*
- * @fn void* JFMGetUserData(const JFMPtr fm)
- * @brief 파일 관리 구조체 객체에 저장된 사용자 데이터를 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @return 성공 시 저장된 사용자 데이터의 주소, 실패 시 NULL 반환
+ * @fn static Bool _IndexAddLine(IndexFilePtr entry, const char *s, size_t length)
+ * @brief 라인 하나의 트라이그램을 모두 마지막 블록에 추가하는 함수
+ * @param entry 파일 색인 정보의 주소(출력)
+ * @param s 라인 시작 주소(입력, 읽기 전용)
+ * @param length 라인 길이(입력, 개행 문자 제외)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
  */
-void* JFMGetUserData(const JFMPtr fm)
+static Bool _IndexAddLine(IndexFilePtr entry, const char *s, size_t length)
 {
-	if(fm == NULL) return NULL;
-	return fm->userData;
+	unsigned int blockIndex = (unsigned int)(entry->blockNum - 1);
+	size_t position = 0;
+	for( ; position + 3 <= length; position++)
+	{
+		if(_IndexAddPosting(entry, _GetTrigram(s + position), blockIndex) == False) return False;
+	}
+	return True;
 }
 
 /*
- * @fn JFMPtr JFMNewFile(JFMPtr fm, const char *path)
- * @brief 파일 관리 구조체 객체에 새로운 파일을 추가하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param path 추가할 파일의 경로(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static long long _IndexGetPostings(const IndexFilePtr entry, unsigned int trigram, unsigned int *postingList)
+ * @brief 트라이그램이 나오는 블록 번호 목록을 구하는 함수
+ * 매핑된 색인이면 트라이그램 표를 이진 탐색하고 가변 길이 정수로 저장된 목록을 푼다.
+ * @param entry 파일 색인 정보의 주소(입력, 읽기 전용)
+ * @param trigram 트라이그램(입력)
+ * @param postingList 블록 번호 목록을 저장할 배열(출력, 블록 개수 이상의 크기)
+ * @return 성공 시 블록 번호 개수(없으면 0), 색인 파일이 잘못되었으면 -1 반환
  */
-JFMPtr JFMNewFile(JFMPtr fm, const char *path)
+static long long _IndexGetPostings(const IndexFilePtr entry, unsigned int trigram, unsigned int *postingList)
 {
-	if((fm == NULL) || (path == NULL)) return NULL;
-
-	int targetIndex = 0;
-
-	//TODO NULL 인 파일 인덱스 위치를 다 없애고 NULL 이 아닌 파일 정보만 정리해야 한다.
-	
-	if((targetIndex = JFMFindEmptyFileIndex(fm)) == -1)
+	if(entry->isMapped == False)
 	{
-		targetIndex = fm->size;
+		if(entry->tableSize == 0) return 0;
+		IndexPostingPtr slot = _IndexFindSlot(entry, trigram);
+		if(slot->key == 0) return 0;
+		memcpy(postingList, slot->blockList, sizeof(unsigned int) * slot->count);
+		return (long long)slot->count;
 	}
 
-	if(fm->fileContainer[targetIndex] == NULL)
+	long long low = 0;
+	long long high = entry->mappedTrigramNum - 1;
+	while(low <= high)
 	{
-		// 중복 불허, 같은 파일을 동시에 사용할 수 없음
-		if(fm->size > 1)
+		long long mid = low + (high - low) / 2;
+		IndexTrigramPtr row = &(entry->mappedTrigramList[mid]);
+		if(row->trigram < trigram) low = mid + 1;
+		else if(row->trigram > trigram) high = mid - 1;
+		else
 		{
-			if(JFMFindFileByPath(fm, path) != NULL) return NULL;
+			if((row->postingOffset < 0) || (row->postingOffset > entry->mappedPostingSize) || ((long long)row->blockCount > entry->blockNum)) return -1;
+			return _IndexDecodePostings(entry->mappedPosting + row->postingOffset, entry->mappedPostingSize - row->postingOffset, row->blockCount, entry->blockNum, postingList);
 		}
+	}
+	return 0;
+}
 
-		JFilePtr newFile = JFileNew(path);
-		if(newFile == NULL) return NULL;
+/*
+ * @fn static size_t _IndexEncodePostings(const unsigned int *postingList, long long postingNum, unsigned char *out)
+ * @brief 오름차순 블록 번호 목록을 앞 번호와의 차이로 바꿔서 가변 길이 정수(7 비트 단위)로 저장하는 함수
+ * @param postingList 블록 번호 목록(입력, 읽기 전용)
+ * @param postingNum 블록 번호 개수(입력)
+ * @param out 저장할 버퍼(출력, postingNum * 5 바이트 이상)
+ * @return 저장한 길이 반환
+ */
+static size_t _IndexEncodePostings(const unsigned int *postingList, long long postingNum, unsigned char *out)
+{
+	size_t length = 0;
+	unsigned int previous = 0;
+	long long postingIndex = 0;
+	for( ; postingIndex < postingNum; postingIndex++)
+	{
+		unsigned int delta = postingList[postingIndex] - previous;
+		previous = postingList[postingIndex];
+		while(delta >= 0x80)
+		{
+			out[length++] = (unsigned char)((delta & 0x7F) | 0x80);
+			delta >>= 7;
+		}
+		out[length++] = (unsigned char)delta;
+	}
+	return length;
+}
 
-		if(targetIndex == (fm->size - 1))
+/*
+ * @fn static long long _IndexDecodePostings(const unsigned char *data, long long size, unsigned int postingNum, long long blockNum, unsigned int *postingList)
+ * @brief 가변 길이 정수로 저장된 블록 번호 목록을 푸는 함수
+ * 잘못된 색인 파일로 영역 밖을 읽거나 잘못된 블록 번호를 돌려주지 않도록 길이와 순서를 검사한다.
+ * @param data 저장된 목록 시작 주소(입력, 읽기 전용)
+ * @param size 읽을 수 있는 길이(입력)
+ * @param postingNum 블록 번호 개수(입력)
+ * @param blockNum 파일의 블록 개수(입력)
+ * @param postingList 푼 블록 번호를 저장할 배열(출력)
+ * @return 성공 시 블록 번호 개수, 실패 시 -1 반환
+ */
+static long long _IndexDecodePostings(const unsigned char *data, long long size, unsigned int postingNum, long long blockNum, unsigned int *postingList)
+{
+	long long position = 0;
+	long long previous = -1;
+	unsigned int postingIndex = 0;
+	for( ; postingIndex < postingNum; postingIndex++)
+	{
+		unsigned long long delta = 0;
+		int shift = 0;
+		while(True)
 		{
-			JFilePtrContainer newContainer = (JFilePtrContainer)realloc(fm->fileContainer, (fm->size + 1));
-			if(newContainer == NULL)
-			{
-				JFileDelete(&newFile);
-				return NULL;
-			}
-			(fm->size)++;
-			newContainer[targetIndex] = newFile;
-			newContainer[targetIndex + 1] = NULL;
-			fm->fileContainer = newContainer;
+			if((position >= size) || (shift > 28)) return -1;
+			unsigned char byte = data[position++];
+			delta |= (unsigned long long)(byte & 0x7F) << shift;
+			shift += 7;
+			if((byte & 0x80) == 0) break;
 		}
-		else fm->fileContainer[targetIndex] = newFile;
 
-		return fm;
+		long long blockIndex = (previous < 0) ? (long long)delta : previous + (long long)delta;
+		if((blockIndex <= previous) || (blockIndex >= blockNum)) return -1;
+		postingList[postingIndex] = (unsigned int)blockIndex;
+		previous = blockIndex;
 	}
+	return (long long)postingNum;
+}
 
-	return NULL;
+/*
+ * @fn static int _CompareUnsignedInt(const void *a, const void *b)
+ * @brief qsort 에서 unsigned int 배열을 오름차순으로 정렬할 때 사용하는 비교 함수
+ * @param a 비교할 값의 주소(입력, 읽기 전용)
+ * @param b 비교할 값의 주소(입력, 읽기 전용)
+ * @return a 가 작으면 -1, 같으면 0, 크면 1 반환
+ */
+static int _CompareUnsignedInt(const void *a, const void *b)
+{
+	unsigned int x = *(const unsigned int*)a;
+	unsigned int y = *(const unsigned int*)b;
+	return (x < y) ? -1 : ((x > y) ? 1 : 0);
 }
 
 /*
- * @fn JFMPtr JFMDeleteFile(JFMPtr fm, int index)
- * @brief 파일 관리 구조체 객체에 저장된 파일을 삭제하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 삭제할 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static int _CompareString(const void *a, const void *b)
+ * @brief qsort 에서 문자열 주소 배열을 바이트 순서로 정렬할 때 사용하는 비교 함수
+ * @param a 비교할 문자열 주소의 주소(입력, 읽기 전용)
+ * @param b 비교할 문자열 주소의 주소(입력, 읽기 전용)
+ * @return a 가 앞이면 음수, 같으면 0, a 가 뒤면 양수 반환
  */
-JFMPtr JFMDeleteFile(JFMPtr fm, int index)
+static int _CompareString(const void *a, const void *b)
 {
-	if((fm == NULL) || (fm->fileContainer == NULL) || (fm->size <= 1) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
 
-	if((fm->fileContainer)[index] != NULL)
+/*
+ * @fn static Bool _CheckUniqueStrings(const char **stringList, long long n)
+ * @brief 문자열 배열에 같은 문자열이 두 번 이상 나오지 않는지 검사하는 함수
+ * 배열을 정렬한 후 이웃한 문자열끼리 비교한다.
+ * @param stringList 검사할 문자열 주소 배열(입력, 출력, 정렬된 순서로 바뀜)
+ * @param n 문자열 개수(입력)
+ * @return 모두 다르면 True, 같은 문자열이 있으면 False 반환(Bool 열거형 참고)
+ */
+static Bool _CheckUniqueStrings(const char **stringList, long long n)
+{
+	if(n < 2) return True;
+	qsort(stringList, (size_t)n, sizeof(const char*), _CompareString);
+
+	long long stringIndex = 1;
+	for( ; stringIndex < n; stringIndex++)
 	{
-		JFileRemove(JFMGetFile(fm, index));
-		JFileDelete(&(fm->fileContainer[index]));
-		fm->fileContainer[index] = NULL;
+		if(strcmp(stringList[stringIndex - 1], stringList[stringIndex]) == 0) return False;
 	}
-	else return NULL;
-
-	(fm->size)--;
-	return fm;
+	return True;
 }
 
 /*
- * @fn JFMPtr JFMDeleteFile(JFMPtr fm, int index)
- * @brief 파일 관리 구조체 객체에 저장된 파일을 모두 삭제하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @return 반환값 없음
+ * @fn static PathNodePtr _PathNodeNew(const char *label, size_t length)
+ * @brief 경로 색인 노드를 새로 만드는 함수
+ * @param label 간선 문자열(입력, 읽기 전용)
+ * @param length 간선 문자열 길이(입력)
+ * @return 성공 시 새 노드의 주소, 실패 시 NULL 반환
  */
-void JFMDeleteAllFiles(JFMPtr fm)
+static PathNodePtr _PathNodeNew(const char *label, size_t length)
 {
-	if(fm == NULL) return;
+	PathNodePtr node = (PathNodePtr)malloc(sizeof(PathNode));
+	if(node == NULL) return NULL;
 
-	if(fm->fileContainer != NULL)
+	node->label = (char*)malloc(length + 1);
+	if(node->label == NULL)
 	{
-		int fileIndex = 0;
-		for( ; fileIndex <= fm->size; fileIndex++)
-		{
-			JFMDeleteFile(fm, fileIndex);
-		}
+		free(node);
+		return NULL;
+	}
+	memcpy(node->label, label, length);
+	node->label[length] = '\0';
+	node->labelLength = length;
+	node->childList = NULL;
+	node->childNum = 0;
+	node->childCapacity = 0;
+	node->file = NULL;
+	node->fileIndex = -1;
+	return node;
+}
 
-		free(fm->fileContainer);
+/*
+ * @fn static void _PathNodeFree(PathNodePtr node)
+ * @brief 경로 색인 노드와 그 아래 노드를 모두 해제하는 함수(파일 정보는 해제하지 않음)
+ * @param node 해제할 노드의 주소(출력)
+ * @return 반환값 없음
+ */
+static void _PathNodeFree(PathNodePtr node)
+{
+	int childIndex = 0;
+	for( ; childIndex < node->childNum; childIndex++)
+	{
+		_PathNodeFree(node->childList[childIndex]);
 	}
+	if(node->childList != NULL) free(node->childList);
+	free(node->label);
+	free(node);
 }
 
 /*
- * @fn char* JFMGetFileName(const JFMPtr fm, int index)
- * @brief 지정한 파일의 이름을 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 이름, 실패 시 NULL 반환
+ * @fn static int _PathNodeFindChild(const PathNodePtr node, char c, int *position)
+ * @brief 간선이 지정한 문자로 시작하는 자식 노드를 이진 탐색으로 찾는 함수
+ * @param node 부모 노드의 주소(입력, 읽기 전용)
+ * @param c 간선 첫 문자(입력)
+ * @param position 없을 때 새 자식을 넣을 위치를 저장할 주소(출력)
+ * @return 찾으면 자식 목록에서의 위치, 없으면 -1 반환
  */
-char* JFMGetFileName(const JFMPtr fm, int index)
+static int _PathNodeFindChild(const PathNodePtr node, char c, int *position)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
-	return JFileGetName(JFMGetFile(fm, index));
+	int low = 0;
+	int high = node->childNum - 1;
+	while(low <= high)
+	{
+		int mid = low + (high - low) / 2;
+		unsigned char first = (unsigned char)node->childList[mid]->label[0];
+		if(first < (unsigned char)c) low = mid + 1;
+		else if(first > (unsigned char)c) high = mid - 1;
+		else return mid;
+	}
+	*position = low;
+	return -1;
 }
 
 /*
- * @fn char* JFMGetFilePath(const JFMPtr fm, int index)
- * @brief 지정한 파일의 경로를 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 경로, 실패 시 NULL 반환
+ * @fn static Bool _PathNodeAddChild(PathNodePtr node, int position, PathNodePtr child)
+ * @brief 자식 목록의 지정한 위치에 자식 노드를 추가하는 함수
+ * @param node 부모 노드의 주소(출력)
+ * @param position 추가할 위치(입력)
+ * @param child 추가할 자식 노드의 주소(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
  */
-char* JFMGetFilePath(const JFMPtr fm, int index)
+static Bool _PathNodeAddChild(PathNodePtr node, int position, PathNodePtr child)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
-	return JFileGetPath(JFMGetFile(fm, index));
+	if(node->childNum == node->childCapacity)
+	{
+		int capacity = (node->childCapacity == 0) ? 4 : node->childCapacity * 2;
+		PathNodePtr *newList = (PathNodePtr*)realloc(node->childList, sizeof(PathNodePtr) * (size_t)capacity);
+		if(newList == NULL) return False;
+		node->childList = newList;
+		node->childCapacity = capacity;
+	}
+
+	memmove(&(node->childList[position + 1]), &(node->childList[position]), sizeof(PathNodePtr) * (size_t)(node->childNum - position));
+	node->childList[position] = child;
+	node->childNum++;
+	return True;
 }
 
 /*
- * @fn long long JFMGetFileSize(const JFMPtr fm, int index)
- * @brief 지정한 파일의 크기를 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 크기, 실패 시 -1 반환
+ * @fn static Bool _PathNodeInsert(PathNodePtr root, const char *path, JFilePtr file, int fileIndex)
+ * @brief 경로 색인에 파일 경로를 추가하는 함수
+ * 간선 중간에서 경로가 갈라지면 공통 부분을 새 노드로 나눈다. 같은 경로가 이미 있으면 새 파일로 바꾼다.
+ * @param root 루트 노드의 주소(출력)
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @param file 파일 정보 관리 구조체의 주소(입력)
+ * @param fileIndex 파일의 인덱스 번호(입력)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
  */
-long long JFMGetFileSize(const JFMPtr fm, int index)
+static Bool _PathNodeInsert(PathNodePtr root, const char *path, JFilePtr file, int fileIndex)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return -1;
-	return JFileGetSize(JFMGetFile(fm, index));
+	PathNodePtr node = root;
+	const char *s = path;
+	size_t length = strlen(path);
+
+	while(length > 0)
+	{
+		int position = 0;
+		int childIndex = _PathNodeFindChild(node, s[0], &position);
+		if(childIndex < 0)
+		{
+			PathNodePtr leaf = _PathNodeNew(s, length);
+			if(leaf == NULL) return False;
+			if(_PathNodeAddChild(node, position, leaf) == False)
+			{
+				_PathNodeFree(leaf);
+				return False;
+			}
+			node = leaf;
+			break;
+		}
+
+		PathNodePtr child = node->childList[childIndex];
+		size_t common = 1;
+		while((common < child->labelLength) && (common < length) && (child->label[common] == s[common])) common++;
+
+		if(common < child->labelLength)
+		{
+			PathNodePtr middle = _PathNodeNew(child->label, common);
+			if(middle == NULL) return False;
+			if(_PathNodeAddChild(middle, 0, child) == False)
+			{
+				_PathNodeFree(middle);
+				return False;
+			}
+			memmove(child->label, child->label + common, child->labelLength - common + 1);
+			child->labelLength -= common;
+			node->childList[childIndex] = middle;
+			child = middle;
+		}
+
+		node = child;
+		s += common;
+		length -= common;
+	}
+
+	node->file = file;
+	node->fileIndex = fileIndex;
+	return True;
 }
 
 /*
- * @fn long long JFMGetFileSize(const JFMPtr fm, int index)
- * @brief 지정한 파일을 열어서 전달받은 문자열을 저장하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param s 저장할 문자열(입력, 읽기 전용)
- * @param mode 파일 접근 방식(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static void _PathNodeRemove(PathNodePtr node, const char *s, size_t length, const JFilePtr file)
+ * @brief 경로 색인에서 파일 경로를 지우는 함수
+ * 파일이 없어진 노드는 자식이 없으면 지우고, 자식이 하나뿐이면 자식과 합쳐서 압축 상태를 유지한다.
+ * @param node 방문할 노드의 주소(출력)
+ * @param s 이 노드 아래에 남은 경로(입력, 읽기 전용)
+ * @param length 남은 경로 길이(입력)
+ * @param file 지울 파일 정보 관리 구조체의 주소(입력, 읽기 전용, 다른 파일이 있으면 지우지 않음)
+ * @return 반환값 없음
  */
-JFMPtr JFMWriteFile(JFMPtr fm, int index, const char *s, const char *mode)
+static void _PathNodeRemove(PathNodePtr node, const char *s, size_t length, const JFilePtr file)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (s == NULL)) return NULL;
-	if(JFileWrite(JFMGetFile(fm, index), s, mode) == NULL) return NULL;
-	return fm;
+	if(length == 0)
+	{
+		if(node->file == file)
+		{
+			node->file = NULL;
+			node->fileIndex = -1;
+		}
+		return;
+	}
+
+	int position = 0;
+	int childIndex = _PathNodeFindChild(node, s[0], &position);
+	if(childIndex < 0) return;
+
+	PathNodePtr child = node->childList[childIndex];
+	if((child->labelLength > length) || (memcmp(child->label, s, child->labelLength) != 0)) return;
+
+	_PathNodeRemove(child, s + child->labelLength, length - child->labelLength, file);
+	if(child->file != NULL) return;
+
+	if(child->childNum == 0)
+	{
+		_PathNodeFree(child);
+		memmove(&(node->childList[childIndex]), &(node->childList[childIndex + 1]), sizeof(PathNodePtr) * (size_t)(node->childNum - childIndex - 1));
+		node->childNum--;
+	}
+	else if(child->childNum == 1)
+	{
+		PathNodePtr grandChild = child->childList[0];
+		char *label = (char*)malloc(child->labelLength + grandChild->labelLength + 1);
+		// 합치지 못해도 노드가 하나 더 있을 뿐 검색 결과는 같다.
+		if(label == NULL) return;
+
+		memcpy(label, child->label, child->labelLength);
+		memcpy(label + child->labelLength, grandChild->label, grandChild->labelLength + 1);
+		free(grandChild->label);
+		grandChild->label = label;
+		grandChild->labelLength += child->labelLength;
+
+		node->childList[childIndex] = grandChild;
+		child->childNum = 0;
+		_PathNodeFree(child);
+	}
 }
 
 /*
- * @fn char** JFMReadFile(JFMPtr fm, int index)
- * @brief 지정한 파일 내용을 읽어서 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 내용, 실패 시 NULL 반환
+ * @fn static PathNodePtr _PathNodeFind(const PathNodePtr root, const char *s, size_t length, Bool isPrefix)
+ * @brief 경로 색인에서 지정한 경로(또는 접두사)가 끝나는 노드를 찾는 함수
+ * @param root 루트 노드의 주소(입력, 읽기 전용)
+ * @param s 찾을 경로(입력, 읽기 전용)
+ * @param length 경로 길이(입력)
+ * @param isPrefix 접두사 검색이면 True(간선 중간에서 끝나도 그 간선의 노드를 반환)
+ * @return 성공 시 노드의 주소, 없으면 NULL 반환
  */
-char** JFMReadFile(JFMPtr fm, int index)
+static PathNodePtr _PathNodeFind(const PathNodePtr root, const char *s, size_t length, Bool isPrefix)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
-	return JFileRead(JFMGetFile(fm, index), LINE_LENGTH);
+	PathNodePtr node = root;
+	while(length > 0)
+	{
+		int position = 0;
+		int childIndex = _PathNodeFindChild(node, s[0], &position);
+		if(childIndex < 0) return NULL;
+
+		PathNodePtr child = node->childList[childIndex];
+		size_t compareLength = (child->labelLength < length) ? child->labelLength : length;
+		if(memcmp(child->label, s, compareLength) != 0) return NULL;
+		if(compareLength < child->labelLength) return (isPrefix == True) ? child : NULL;
+
+		node = child;
+		s += compareLength;
+		length -= compareLength;
+	}
+	return node;
 }
 
 /*
- * @fn JFilePtr JFMFindFileByPath(const JFMPtr fm, const char *path)
- * @brief 파일 이름을 통해 파일 관리 구조체에서 파일을 검색해서 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param path 검색할 파일 경로(입력, 읽기 전용)
- * @return 성공 시 파일 정보 구조체의 주소, 실패 시 NULL 반환
+ * @fn static Bool _MatchGlob(const char *pattern, const char *s)
+ * @brief 경로가 글롭 패턴과 맞는지 검사하는 함수
+ * '*' 는 '/' 를 제외한 0 개 이상의 문자, '?' 는 '/' 를 제외한 문자 하나, '**' 는 '/' 를 포함한 0 개 이상의 문자와 맞는다.
+ * '**' 바로 뒤의 '/' 는 없어도 맞으므로 '**' 다음에 "/b" 가 오는 패턴은 "b" 와 "x/y/b" 에 모두 맞는다.
+ * @param pattern 글롭 패턴(입력, 읽기 전용)
+ * @param s 검사할 경로(입력, 읽기 전용)
+ * @return 맞으면 True, 아니면 False 반환(Bool 열거형 참고)
  */
-JFilePtr JFMFindFileByPath(const JFMPtr fm, const char *path)
+static Bool _MatchGlob(const char *pattern, const char *s)
 {
-	if((fm == NULL) || (path == NULL)) return NULL;
-	if(_CheckIfPath(path) == False) return NULL;
+	while(*pattern != '\0')
+	{
+		if((pattern[0] == '*') && (pattern[1] == '*'))
+		{
+			pattern += 2;
+			if((*pattern == '/') && (_MatchGlob(pattern + 1, s) == True)) return True;
+			for( ; ; s++)
+			{
+				if(_MatchGlob(pattern, s) == True) return True;
+				if(*s == '\0') return False;
+			}
+		}
+		if(*pattern == '*')
+		{
+			pattern++;
+			for( ; ; s++)
+			{
+				if(_MatchGlob(pattern, s) == True) return True;
+				if((*s == '\0') || (*s == '/')) return False;
+			}
+		}
 
-	int pathLength = strlen(path);
-	int fileIndex = 0;
-	JFilePtr file = NULL;
+		if(*s == '\0') return False;
+		if(*pattern == '?')
+		{
+			if(*s == '/') return False;
+		}
+		else if(*pattern != *s) return False;
+		pattern++;
+		s++;
+	}
+	return (*s == '\0') ? True : False;
+}
 
-	for( ; fileIndex < fm->size; fileIndex++)
+/*
+ * @fn static Bool _MakeParentDirs(const char *path)
+ * @brief 지정한 경로의 상위 디렉터리를 없으면 모두 만드는 함수
+ * @param path 파일 경로(입력, 읽기 전용)
+ * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ */
+static Bool _MakeParentDirs(const char *path)
+{
+	char dirPath[PATH_MAX];
+	size_t length = strlen(path);
+	if(length >= sizeof(dirPath)) return False;
+	memcpy(dirPath, path, length + 1);
+
+	char *s = dirPath + 1;
+	for( ; *s != '\0'; s++)
 	{
-		file = JFMGetFile(fm, fileIndex);
-		if(file == NULL) continue;
-		if(strncmp(path, file->path, pathLength) == 0) return file;
+		if(*s != '/') continue;
+		*s = '\0';
+		if((mkdir(dirPath, 0777) == -1) && (errno != EEXIST)) return False;
+		*s = '/';
 	}
+	return True;
+}
 
-	return NULL;
+/*
+ * @fn static int _CompareCopyTaskSize(const void *a, const void *b)
+ * @brief 복사 작업을 파일 크기가 큰 순서로 정렬하기 위한 qsort 비교 함수
+ * 크기가 같으면 전달받은 순서를 유지한다.
+ * @param a 비교할 복사 작업의 주소(입력, 읽기 전용)
+ * @param b 비교할 복사 작업의 주소(입력, 읽기 전용)
+ * @return a 가 앞이면 음수, 뒤면 양수 반환
+ */
+static int _CompareCopyTaskSize(const void *a, const void *b)
+{
+	const CopyTask *taskA = (const CopyTask*)a;
+	const CopyTask *taskB = (const CopyTask*)b;
+
+	if(taskA->size != taskB->size) return (taskA->size > taskB->size) ? -1 : 1;
+	return taskA->position - taskB->position;
 }
 
 /*
- * @fn JFilePtr JFMGetFile(const JFMPtr fm, int index)
- * @brief 지정한 파일 정보 구조체의 주소를 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 정보 구조체의 주소, 실패 시 NULL 반환
+ * @fn static ssize_t _CopyFileRange(int srcFd, loff_t *srcOffset, int destFd, loff_t *destOffset, size_t length)
+ * @brief copy_file_range 시스템 호출로 커널 안에서 파일 구간을 복사하는 함수
+ * C 라이브러리에 래퍼 함수가 없어도 사용할 수 있도록 시스템 호출을 직접 부른다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param srcOffset 원본 파일에서 읽을 위치(입력, 출력)
+ * @param destFd 대상 파일 디스크립터(입력)
+ * @param destOffset 대상 파일에 쓸 위치(입력, 출력)
+ * @param length 복사할 길이(입력)
+ * @return 성공 시 복사한 길이, 실패 시 -1 반환
  */
-JFilePtr JFMGetFile(const JFMPtr fm, int index)
+static ssize_t _CopyFileRange(int srcFd, loff_t *srcOffset, int destFd, loff_t *destOffset, size_t length)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
-	return fm->fileContainer[index];
+#ifdef __NR_copy_file_range
+	return (ssize_t)syscall(__NR_copy_file_range, srcFd, srcOffset, destFd, destOffset, length, 0);
+#else
+	errno = ENOSYS;
+	return -1;
+#endif
 }
 
 /*
- * @fn JFMPtr JFMMoveFile(JFMPtr fm, int index, const char *newFilePath)
- * @brief 파일을 지정한 경로로 이동시키는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @param newFilePath 파일을 이동시킬 경로(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static int _CopyRange(int srcFd, int destFd, off_t offset, off_t length)
+ * @brief 원본 파일의 지정한 구간을 대상 파일의 같은 위치에 복사하는 함수
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destFd 대상 파일 디스크립터(입력)
+ * @param offset 복사할 구간의 시작 위치(입력)
+ * @param length 복사할 구간의 길이(입력)
+ * @return 성공 시 0, 실패 시 -1 반환
  */
-JFMPtr JFMMoveFile(JFMPtr fm, int index, const char *newFilePath)
+static int _CopyRange(int srcFd, int destFd, off_t offset, off_t length)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (newFilePath == NULL)) return NULL;
-
-	// 목적지 경로에 복사 후 삭제
-	if(JFMCopyFile(fm, index, newFilePath) == NULL) return NULL;
-	JFileRemove(JFMGetFile(fm, index));
-	if(JFileSetPath(JFMGetFile(fm, index), newFilePath) == NULL) return NULL;
-
-	return fm;
+	return _CopyRangeTo(srcFd, offset, destFd, offset, length);
 }
 
 /*
- * @fn JFMPtr JFMCopyFile(JFMPtr fm, int index, const char *newFilePath)
- * @brief 파일을 지정한 경로로 복사하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @param newFilePath 파일을 복사할 경로(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static int _CopyRangeTo(int srcFd, off_t srcOffset, int destFd, off_t destOffset, off_t length)
+ * @brief 원본 파일의 지정한 구간을 대상 파일의 지정한 위치에 복사하는 함수
+ * copy_file_range 를 먼저 사용하고, 지원하지 않는 환경이면 pread/pwrite 로 복사한다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param srcOffset 복사할 구간의 원본 시작 위치(입력)
+ * @param destFd 대상 파일 디스크립터(입력)
+ * @param destOffset 복사할 구간의 대상 시작 위치(입력)
+ * @param length 복사할 구간의 길이(입력)
+ * @return 성공 시 0, 실패 시 -1 반환
  */
-JFMPtr JFMCopyFile(JFMPtr fm, int index, const char *newFilePath)
+static int _CopyRangeTo(int srcFd, off_t srcOffset, int destFd, off_t destOffset, off_t length)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
-	if(_CheckIfPath(newFilePath) == False) return NULL;
+	loff_t srcPos = srcOffset;
+	loff_t destPos = destOffset;
+	off_t endOffset = srcOffset + length;
 
-	FILE *newFilePointer = NULL;
-	if(newFilePath == NULL)
+	while(srcPos < endOffset)
 	{
-		char *oldFilePath = strdup(JFMGetFile(fm, index)->path);
-		char dupleBuf[BUF_SIZE];
-
-		sprintf(dupleBuf, "_%d", JFMGetFile(fm, index)->dupleNum + 1);
-		strcat(oldFilePath, dupleBuf);
-
-		newFilePointer = fopen(oldFilePath, "w");
-
-		free(oldFilePath);
-		JFileIncDupleNum(JFMGetFile(fm, index));
+		ssize_t n = _CopyFileRange(srcFd, &srcPos, destFd, &destPos, (size_t)(endOffset - srcPos));
+		if(n > 0) continue;
+		// 원본이 예상보다 짧아졌으면 복사할 내용이 없다.
+		if(n == 0) return 0;
+		if(errno == EINTR) continue;
+		if((errno == ENOSYS) || (errno == EXDEV) || (errno == EINVAL) || (errno == EOPNOTSUPP) || (errno == EBADF)) break;
+		return -1;
 	}
-	else newFilePointer = fopen(newFilePath, "w");
-	if(newFilePointer == NULL) return NULL;
+	if(srcPos >= endOffset) return 0;
 
-	if(JFileOpen(JFMGetFile(fm, index), "r") == NULL) return NULL;
+	char *buf = (char*)malloc(COPY_BUF_SIZE);
+	if(buf == NULL) return -1;
 
-	char c = '\0';
-	FILE *oldFilePointer = JFMGetFile(fm, index)->filePointer;
-
-	while(1)
+	// 원본과 대상의 위치 차이는 복사하는 동안 유지된다.
+	off_t offset = srcPos;
+	off_t destDelta = (off_t)destPos - (off_t)srcPos;
+	while(offset < endOffset)
 	{
-		c = fgetc(oldFilePointer);
-		if(!feof(oldFilePointer)) fputc(c, newFilePointer);
-		else break;
+		size_t chunkSize = COPY_BUF_SIZE;
+		if(offset + (off_t)chunkSize > endOffset) chunkSize = (size_t)(endOffset - offset);
+
+		ssize_t readSize = _ReadFull(srcFd, buf, chunkSize, offset);
+		if(readSize <= 0)
+		{
+			free(buf);
+			return (readSize == 0) ? 0 : -1;
+		}
+		if(_WriteFull(destFd, buf, (size_t)readSize, offset + destDelta) != readSize)
+		{
+			free(buf);
+			return -1;
+		}
+		offset += readSize;
 	}
 
-	fclose(newFilePointer);
-	JFileClose(JFMGetFile(fm, index));
-	return fm;
+	free(buf);
+	return 0;
 }
 
 /*
- * @fn JFMPtr JFMRenameFilePath(JFMPtr fm, int index, const char *newFilePath)
- * @brief 지정한 파일의 이름을 새로 설정하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @param newFilePath 새로 설정할 파일 경로(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static void _CopyDeltaBlock(void *arg, long long taskIndex)
+ * @brief 차등 복사에서 블록 하나를 비교해서 달라진 구간만 대상 파일에 쓰는 작업 함수
+ * 블록 안에서 DELTA_PAGE_SIZE 단위로 비교하고, 연속으로 달라진 구간은 한 번에 쓴다.
+ * @param arg 차등 복사 구조체의 주소(입력)
+ * @param taskIndex 처리할 블록 번호(입력)
+ * @return 반환값 없음
  */
-JFMPtr JFMRenameFilePath(JFMPtr fm, int index, const char *newFilePath)
+static void _CopyDeltaBlock(void *arg, long long taskIndex)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (newFilePath == NULL)) return NULL;
+	DeltaCopyPtr delta = (DeltaCopyPtr)arg;
+	if(delta->isFailed == True) return;
 
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return NULL;
+	off_t offset = (off_t)taskIndex * (off_t)delta->blockSize;
+	size_t length = delta->blockSize;
+	if(offset + (off_t)length > delta->srcSize) length = (size_t)(delta->srcSize - offset);
 
-	if(rename(file->path, newFilePath) == -1) fm = NULL;
-	if(JFileSetName(file, newFilePath) == NULL) fm = NULL;
+	char *srcBuf = (char*)malloc(length);
+	char *destBuf = (char*)malloc(length);
+	if((srcBuf == NULL) || (destBuf == NULL))
+	{
+		delta->isFailed = True;
+		if(srcBuf != NULL) free(srcBuf);
+		if(destBuf != NULL) free(destBuf);
+		return;
+	}
 
-	return fm;
-}
+	ssize_t srcReadSize = _ReadFull(delta->srcFd, srcBuf, length, offset);
+	ssize_t destReadSize = 0;
+	if(offset < delta->destSize) destReadSize = _ReadFull(delta->destFd, destBuf, length, offset);
 
-/*
- * @fn void JFMPrintFile(const JFMPtr fm, int index)
- * @brief 지정한 파일의 상태 및 정보를 출력하는 함수
- * @param fm 파일 관리 구조체의 주소(입력, 읽기 전용)
- * @param index 파일의 인덱스 번호(입력)
- * @return 반환값 없음
- */
-void JFMPrintFile(const JFMPtr fm, int index)
-{
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return;
+	if((srcReadSize != (ssize_t)length) || (destReadSize < 0))
+	{
+		delta->isFailed = True;
+		free(srcBuf);
+		free(destBuf);
+		return;
+	}
 
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return;
+	// 대상 파일이 짧아서 읽지 못한 부분은 무조건 다시 쓴다.
+	size_t pageOffset = 0;
+	size_t dirtyStart = 0;
+	Bool isDirty = False;
+	while(pageOffset < length)
+	{
+		size_t pageLength = DELTA_PAGE_SIZE;
+		if(pageOffset + pageLength > length) pageLength = length - pageOffset;
 
-	printf("\n----------------------------------\n");
-	printf("File Name : %s\n", file->name);
-	printf("File Path : %s\n", file->path);
-	printf("File Line Count : %d\n", file->line);
-	printf("File Char Count : %d\n", file->totalCharCount);
-	printf("I-Node Number : %ld\n", (long)(file->stat.st_ino));
-	printf("Mode : %lo (octal)\n", (unsigned long)(file->stat.st_mode));
-	printf("Link Count : %ld\n", (long)(file->stat.st_nlink));
-	printf("Ownership : UID=%ld / GID=%ld\n", (long)(file->stat.st_uid), (long)(file->stat.st_gid));
-	printf("Preferred I/O Block Size : %ld bytes\n", (long)(file->stat.st_blksize));
-	printf("File Size : %lld bytes\n", (long long)(file->stat.st_size));
-	printf("Blocks allocated %lld\n", (long long)(file->stat.st_blocks));
-	printf("Last Status Change : %s", ctime(&(file->stat.st_ctime)));
-	printf("Last File Access : %s", ctime(&(file->stat.st_atime)));
-	printf("Last File Modification : %s", ctime(&(file->stat.st_mtime)));
-	printf("----------------------------------\n");
-}
+		Bool isSame = False;
+		if((ssize_t)(pageOffset + pageLength) <= destReadSize)
+		{
+			if(memcmp(srcBuf + pageOffset, destBuf + pageOffset, pageLength) == 0) isSame = True;
+		}
 
-/*
- * @fn JFMPtr JFMTruncateFile(JFMPtr fm, int index, off_t length)
- * @brief 지정한 파일의 크기를 새로 설정하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @param length 새로 설정할 파일의 크기(입력)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
- */
-JFMPtr JFMTruncateFile(JFMPtr fm, int index, off_t length)
-{
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (length < 0)) return NULL;
+		if((isSame == False) && (isDirty == False))
+		{
+			dirtyStart = pageOffset;
+			isDirty = True;
+		}
+		else if((isSame == True) && (isDirty == True))
+		{
+			if(_WriteFull(delta->destFd, srcBuf + dirtyStart, pageOffset - dirtyStart, offset + (off_t)dirtyStart) < 0) delta->isFailed = True;
+			isDirty = False;
+		}
 
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return NULL;
+		pageOffset += pageLength;
+	}
 
-	if(truncate(file->path, length) == -1)
+	if(isDirty == True)
 	{
-//		perror("truncate");
-		return NULL;
+		if(_WriteFull(delta->destFd, srcBuf + dirtyStart, length - dirtyStart, offset + (off_t)dirtyStart) < 0) delta->isFailed = True;
 	}
 
-	if(JFileLoad(file) == NULL) return NULL;
-
-	return fm;
+	free(srcBuf);
+	free(destBuf);
 }
 
 /*
- * @fn JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode)
- * @brief 지정한 파일의 접근 방식을 새로 설정하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @param mode 새로 설정할 파일 접근 방식(입력, 읽기 전용)
- * @return 성공 시 파일 관리 구조체의 주소, 실패 시 NULL 반환
+ * @fn static int _CopyDelta(int srcFd, int destFd, const JFMCopyOptionPtr option)
+ * @brief 이미 있는 대상 파일을 원본과 블록 단위로 병렬 비교해서 달라진 구간만 다시 쓰는 함수
+ * 두 파일 모두 로컬에 있으므로 체크섬 대신 내용을 직접 비교하고, 마지막에 대상 파일 크기를 원본에 맞춘다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destFd 대상 파일 디스크립터(입력, 읽기 쓰기 가능)
+ * @param option 복사 옵션(입력, 읽기 전용)
+ * @return 성공 시 0, 실패 시 -1 반환
  */
-JFMPtr JFMChangeMode(JFMPtr fm, int index, const char *mode)
+static int _CopyDelta(int srcFd, int destFd, const JFMCopyOptionPtr option)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False) || (strlen(mode) != 4)) return NULL;
-	if(_CheckIfStringIsDigits(mode) == False) return NULL;
-
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return NULL;
-
-	long _mode = strtol(mode, 0, 8);
-	if((_mode == 0) || (_mode == LONG_MIN) || (_mode == LONG_MAX))
+	FileStatus srcStat;
+	FileStatus destStat;
+	if((fstat(srcFd, &srcStat) == -1) || (fstat(destFd, &destStat) == -1)) return -1;
+
+	DeltaCopy delta;
+	delta.srcFd = srcFd;
+	delta.destFd = destFd;
+	delta.srcSize = srcStat.st_size;
+	delta.destSize = destStat.st_size;
+	delta.blockSize = (option->blockSize > 0) ? option->blockSize : DELTA_BLOCK_SIZE;
+	delta.isFailed = False;
+
+	long long blockNum = (long long)((delta.srcSize + (off_t)delta.blockSize - 1) / (off_t)delta.blockSize);
+	if(_RunTasks(_CopyDeltaBlock, &delta, blockNum, option->threadNum) == -1) return -1;
+	if(delta.isFailed == True) return -1;
+
+	if(delta.destSize != delta.srcSize)
 	{
-//		perror("strtol");
-		return NULL;
+		if(ftruncate(destFd, delta.srcSize) == -1) return -1;
 	}
 
-	if(chmod(file->path, _mode) == -1) return NULL;
-	if(JFileLoad(file) == NULL) return NULL;
-
-	return fm;
+	return 0;
 }
 
 /*
- * @fn char* JFMGetFileMode(JFMPtr fm, int index)
- * @brief 지정한 파일의 접근 방식을 문자열로 변환해서 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 모드 문자열, 실패 시 NULL 반환
+ * @fn static int _CopyParallel(int srcFd, int destFd, int threadNum)
+ * @brief 큰 파일을 COPY_CHUNK_SIZE 구간으로 나눠서 구간별로 병렬 복사하는 함수
+ * COPY_PARALLEL_MIN_SIZE 보다 작거나 스레드가 하나뿐이면 _CopyFull 로 복사한다.
+ * 원본에 구멍(hole)이 없으면 대상 파일을 fallocate 로 미리 할당해서 구간별 쓰기가 블록 할당을 두고 다투지 않게 한다.
+ * 구멍이 있으면 구멍을 유지하기 위해 미리 할당하지 않는다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destFd 대상 파일 디스크립터(입력, 비어 있는 파일)
+ * @param threadNum 사용할 스레드 개수(입력, 0 이하이면 CPU 개수 사용)
+ * @return 성공 시 0, 실패 시 -1 반환
  */
-char* JFMGetFileMode(JFMPtr fm, int index)
+static int _CopyParallel(int srcFd, int destFd, int threadNum)
 {
-	if((fm == NULL) || (JFMCheckIndex(fm, index) == False)) return NULL;
+	FileStatus srcStat;
+	if(fstat(srcFd, &srcStat) == -1) return -1;
+	if(((long long)srcStat.st_size < COPY_PARALLEL_MIN_SIZE) || (_GetThreadNum(threadNum) <= 1)) return _CopyFull(srcFd, destFd);
 
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return NULL;
+	if((long long)srcStat.st_blocks * 512 >= (long long)srcStat.st_size) fallocate(destFd, 0, 0, srcStat.st_size);
 
-	return JFileGetMode(file);
-}
+	RangeCopy range;
+	range.srcFd = srcFd;
+	range.destFd = destFd;
+	range.srcSize = srcStat.st_size;
+	range.isFailed = False;
 
-///////////////////////////////////////////////////////////////////////////////
-/// Static Functions for JFileManager
-///////////////////////////////////////////////////////////////////////////////
+	long long chunkNum = (long long)((range.srcSize + COPY_CHUNK_SIZE - 1) / COPY_CHUNK_SIZE);
+	if(_RunTasks(_CopyParallelChunk, &range, chunkNum, threadNum) == -1) return -1;
+	if(range.isFailed == True) return -1;
+
+	if(ftruncate(destFd, range.srcSize) == -1) return -1;
+	return 0;
+}
 
 /*
- * @fn static Bool JFMCheckIndex(const JFMPtr fm, int index)
- * @brief 지정한 인덱스의 경계를 검사하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ * @fn static void _CopyParallelChunk(void *arg, long long taskIndex)
+ * @brief 병렬 복사에서 구간 하나를 복사하는 병렬 작업 함수
+ * @param arg 구간별 병렬 복사 정보의 주소(입력)
+ * @param taskIndex 작업 번호(입력, 구간 번호)
+ * @return 반환값 없음
  */
-static Bool JFMCheckIndex(const JFMPtr fm, int index)
+static void _CopyParallelChunk(void *arg, long long taskIndex)
 {
-	if((index < 0) || (index >= fm->size)) return False;
-	return True;
+	RangeCopyPtr range = (RangeCopyPtr)arg;
+
+	off_t offset = (off_t)(taskIndex * COPY_CHUNK_SIZE);
+	off_t endOffset = offset + (off_t)COPY_CHUNK_SIZE;
+	if(endOffset > range->srcSize) endOffset = range->srcSize;
+
+	if(_CopyDataRange(range->srcFd, range->destFd, offset, endOffset) == -1) range->isFailed = True;
 }
 
 /*
- * @fn static FileType JFMCheckFileType(const JFMPtr fm, int index)
- * @brief 지정한 파일 유형을 검사하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @param index 파일의 인덱스 번호(입력)
- * @return 성공 시 파일 유형, 실패 시 Unknown 반환(FileType 열거형 참고)
+ * @fn static int _CopyDataRange(int srcFd, int destFd, off_t offset, off_t endOffset)
+ * @brief 원본 파일의 지정한 구간에서 데이터가 있는 부분만 대상 파일의 같은 위치에 복사하는 함수
+ * SEEK_DATA/SEEK_HOLE 로 데이터가 있는 부분을 찾으므로 원본의 구멍(hole)은 복사하지 않는다.
+ * 파일 시스템이 SEEK_DATA 를 지원하지 않으면 구간 전체를 복사한다.
+ * @param srcFd 원본 파일 디스크립터(입력)
+ * @param destFd 대상 파일 디스크립터(입력)
+ * @param offset 복사할 구간의 시작 위치(입력)
+ * @param endOffset 복사할 구간의 끝 위치(입력)
+ * @return 성공 시 0, 실패 시 -1 반환
  */
-static FileType JFMCheckFileType(const JFMPtr fm, int index)
+static int _CopyDataRange(int srcFd, int destFd, off_t offset, off_t endOffset)
 {
-	JFilePtr file = JFMGetFile(fm, index);
-	if(file == NULL) return;
-
-	switch(file->stat.st_mode & S_IFMT)
+	while(offset < endOffset)
 	{
-		case S_IFREG: return Regular;
-		case S_IFDIR: return Directory;
-		case S_IFCHR: return CharDevice;
-		case S_IFBLK: return BlockDevice;
-		case S_IFIFO: return Pipe;
-		case S_IFLNK: return SymbolicLink;
-		case S_IFSOCK: return Socket;
+		off_t dataStart = lseek(srcFd, offset, SEEK_DATA);
+		if(dataStart == -1)
+		{
+			// 남은 구간이 모두 구멍
+			if(errno == ENXIO) break;
+			// SEEK_DATA 를 지원하지 않으면 나머지를 모두 복사
+			return _CopyRange(srcFd, destFd, offset, endOffset - offset);
+		}
+		if(dataStart >= endOffset) break;
+
+		off_t dataEnd = lseek(srcFd, dataStart, SEEK_HOLE);
+		if((dataEnd == -1) || (dataEnd > endOffset)) dataEnd = endOffset;
+
+		if(_CopyRange(srcFd, destFd, dataStart, dataEnd - dataStart) == -1) return -1;
+		offset = dataEnd;
 	}
-	return Unknown;
+
+	return 0;
 }
 
 /*
- * @fn static int JFMFindEmptyFileIndex(const JFMPtr fm)
- * @brief 비어있는 파일 인덱스를 반환하는 함수
- * @param fm 파일 관리 구조체의 주소(출력)
- * @return 성공 시 파일 인덱스, 실패 시 -1 반환
+ * @fn static size_t _LZCompressBound(size_t length)
+ * @brief 지정한 길이의 데이터를 압축했을 때 필요한 최대 버퍼 크기를 구하는 함수
+ * @param length 압축할 데이터 길이(입력)
+ * @return 항상 최대 압축 결과 크기 반환
  */
-static int JFMFindEmptyFileIndex(const JFMPtr fm)
+static size_t _LZCompressBound(size_t length)
 {
-	int fileIndex = 0;
-	for( ; fileIndex < fm->size; fileIndex++)
-	{
-		if(fm->fileContainer[fileIndex] == NULL) return fileIndex;
-	}
-	return -1;
+	return length + (length / 255) + 16;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-/// Static Util Function
-///////////////////////////////////////////////////////////////////////////////
-
 /*
- * @fn static Bool _CheckIfPath(const char *s)
- * @brief 지정한 문자열이 경로인지 검사하는 함수
- * @param s 검사할 문자열(입력, 읽기 전용)
- * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ * @fn static size_t _LZWriteSequence(unsigned char *out, size_t outPos, size_t outCapacity, const unsigned char *literals, size_t literalLength, size_t offset, size_t matchLength)
+ * @brief LZ 압축 결과에 [토큰][리터럴 길이][리터럴][오프셋][매치 길이] 순서로 시퀀스 하나를 기록하는 함수
+ * 매치 길이가 0 이면 마지막 시퀀스로 보고 리터럴만 기록한다.
+ * @return 성공 시 기록한 후의 출력 위치, 버퍼가 부족하면 0 반환
  */
-static Bool _CheckIfPath(const char *s)
+static size_t _LZWriteSequence(unsigned char *out, size_t outPos, size_t outCapacity, const unsigned char *literals, size_t literalLength, size_t offset, size_t matchLength)
 {
-	if(s == NULL) return False;
+	size_t needSize = 1 + (literalLength / 255) + 1 + literalLength + 2 + (matchLength / 255) + 1;
+	if(outPos + needSize > outCapacity) return 0;
 
-	while(*s != '\0')
+	size_t extraMatchLength = (matchLength > 0) ? matchLength - LZ_MIN_MATCH : 0;
+	unsigned char token = (unsigned char)(((literalLength >= 15) ? 15 : literalLength) << 4);
+	if(matchLength > 0) token |= (unsigned char)((extraMatchLength >= 15) ? 15 : extraMatchLength);
+	out[outPos++] = token;
+
+	if(literalLength >= 15)
 	{
-		if(*s++ == '/') return True;
+		size_t remainLength = literalLength - 15;
+		for( ; remainLength >= 255; remainLength -= 255) out[outPos++] = 255;
+		out[outPos++] = (unsigned char)remainLength;
 	}
+	memcpy(out + outPos, literals, literalLength);
+	outPos += literalLength;
 
-	return False;
+	if(matchLength == 0) return outPos;
+
+	out[outPos++] = (unsigned char)(offset & 0xff);
+	out[outPos++] = (unsigned char)((offset >> 8) & 0xff);
+
+	if(extraMatchLength >= 15)
+	{
+		size_t remainLength = extraMatchLength - 15;
+		for( ; remainLength >= 255; remainLength -= 255) out[outPos++] = 255;
+		out[outPos++] = (unsigned char)remainLength;
+	}
+
+	return outPos;
 }
 
 /*
- * @fn static void _ConvertModeToString(char *s, mode_t mode)
- * @brief 지정한 파일 접근 방식을 문자열로 변환하는 함수
- * @param s 저장할 문자열(출력)
- * @param mode 변환할 파일 접근 방식(입력)
- * @return 반환값 없음
+ * @fn static size_t _LZCompress(const char *src, size_t srcLength, char *dest, size_t destCapacity)
+ * @brief 지정한 데이터를 LZ4 블록 형식과 같은 규칙으로 압축하는 함수
+ * 4 바이트 해시 테이블로 이전에 나온 같은 내용을 찾아서 (리터럴, 오프셋, 매치 길이) 시퀀스로 기록한다.
+ * @param src 압축할 데이터(입력, 읽기 전용)
+ * @param srcLength 압축할 데이터 길이(입력)
+ * @param dest 압축 결과를 저장할 버퍼(출력)
+ * @param destCapacity 압축 결과 버퍼 크기(입력)
+ * @return 성공 시 압축 결과 크기, 버퍼가 부족하면 0 반환
  */
-static void _ConvertModeToString(char *s, mode_t mode)
+static size_t _LZCompress(const char *src, size_t srcLength, char *dest, size_t destCapacity)
 {
-	const char basePermissions[MAX_MODE_NUM] = "rwxrwxrwx";
-	int modeIndex = 0;
+	const unsigned char *in = (const unsigned char*)src;
+	unsigned char *out = (unsigned char*)dest;
+	size_t inPos = 0;
+	size_t anchor = 0;
+	size_t outPos = 0;
 
-	for( ; modeIndex < MAX_MODE_NUM; modeIndex++)
+	unsigned int *hashTable = (unsigned int*)calloc((size_t)1 << LZ_HASH_LOG, sizeof(unsigned int));
+	if(hashTable == NULL) return 0;
+
+	if(srcLength > LZ_MATCH_FIND_LIMIT)
 	{
-		s[modeIndex] = (mode & (1 << (MAX_MODE_NUM - modeIndex - 1))) ? basePermissions[modeIndex] : '-';
+		// 마지막 LZ_LAST_LITERALS 바이트는 항상 리터럴로 남긴다.
+		size_t findEnd = srcLength - LZ_MATCH_FIND_LIMIT;
+		size_t matchEnd = srcLength - LZ_LAST_LITERALS;
+
+		while(inPos < findEnd)
+		{
+			unsigned int sequence = 0;
+			memcpy(&sequence, in + inPos, sizeof(sequence));
+			unsigned int hash = (sequence * 2654435761U) >> (32 - LZ_HASH_LOG);
+			size_t ref = hashTable[hash];
+			hashTable[hash] = (unsigned int)inPos;
+
+			unsigned int refSequence = 0;
+			if(ref < inPos) memcpy(&refSequence, in + ref, sizeof(refSequence));
+			if((ref >= inPos) || (inPos - ref > LZ_MAX_OFFSET) || (refSequence != sequence))
+			{
+				inPos++;
+				continue;
+			}
+
+			// 앞쪽으로도 같은 내용이 이어지면 매치를 넓힌다.
+			while((inPos > anchor) && (ref > 0) && (in[inPos - 1] == in[ref - 1]))
+			{
+				inPos--;
+				ref--;
+			}
+
+			size_t matchLength = LZ_MIN_MATCH;
+			while((inPos + matchLength < matchEnd) && (in[inPos + matchLength] == in[ref + matchLength])) matchLength++;
+
+			outPos = _LZWriteSequence(out, outPos, destCapacity, in + anchor, inPos - anchor, inPos - ref, matchLength);
+			if(outPos == 0)
+			{
+				free(hashTable);
+				return 0;
+			}
+
+			inPos += matchLength;
+			anchor = inPos;
+		}
 	}
 
-	s[MAX_MODE_NUM] = '\0';
+	outPos = _LZWriteSequence(out, outPos, destCapacity, in + anchor, srcLength - anchor, 0, 0);
+	free(hashTable);
+	return outPos;
 }
 
 /*
- * @fn static Bool _CheckIfStringIsDigits(const char *s)
- * @brief 지정한 문자열이 숫자 문자들로 구성되어 있는지 검사하는 함수
- * @param s 검사할 문자열(입력, 읽기 전용)
- * @return 성공 시 True, 실패 시 False 반환(Bool 열거형 참고)
+ * @fn static ssize_t _LZDecompress(const char *src, size_t srcLength, char *dest, size_t destCapacity)
+ * @brief _LZCompress 로 압축한 데이터를 압축 해제하는 함수
+ * 손상된 데이터로 버퍼 밖을 읽거나 쓰지 않도록 모든 길이와 오프셋을 검사한다.
+ * @param src 압축된 데이터(입력, 읽기 전용)
+ * @param srcLength 압축된 데이터 길이(입력)
+ * @param dest 압축 해제 결과를 저장할 버퍼(출력)
+ * @param destCapacity 압축 해제 결과 버퍼 크기(입력)
+ * @return 성공 시 압축 해제된 크기, 실패 시 -1 반환
  */
-static Bool _CheckIfStringIsDigits(const char *s)
+static ssize_t _LZDecompress(const char *src, size_t srcLength, char *dest, size_t destCapacity)
 {
-	int sLength = strlen(s);
-	int sIndex = 0;
+	const unsigned char *in = (const unsigned char*)src;
+	unsigned char *out = (unsigned char*)dest;
+	size_t inPos = 0;
+	size_t outPos = 0;
 
-	for( ; sIndex < sLength; sIndex++)
+	while(inPos < srcLength)
 	{
-		if(isdigit(s[sIndex]) == 0) return False;
+		unsigned char token = in[inPos++];
+
+		size_t literalLength = token >> 4;
+		if(literalLength == 15)
+		{
+			unsigned char extra = 255;
+			while(extra == 255)
+			{
+				if(inPos >= srcLength) return -1;
+				extra = in[inPos++];
+				literalLength += extra;
+			}
+		}
+		if((literalLength > srcLength - inPos) || (literalLength > destCapacity - outPos)) return -1;
+		memcpy(out + outPos, in + inPos, literalLength);
+		inPos += literalLength;
+		outPos += literalLength;
+
+		// 마지막 시퀀스는 리터럴만 있다.
+		if(inPos >= srcLength) break;
+
+		if(inPos + 2 > srcLength) return -1;
+		size_t offset = (size_t)in[inPos] | ((size_t)in[inPos + 1] << 8);
+		inPos += 2;
+		if((offset == 0) || (offset > outPos)) return -1;
+
+		size_t matchLength = token & 0x0f;
+		if(matchLength == 15)
+		{
+			unsigned char extra = 255;
+			while(extra == 255)
+			{
+				if(inPos >= srcLength) return -1;
+				extra = in[inPos++];
+				matchLength += extra;
+			}
+		}
+		matchLength += LZ_MIN_MATCH;
+		if(matchLength > destCapacity - outPos) return -1;
+
+		// 오프셋이 매치 길이보다 짧으면 겹쳐서 복사해야 하므로 한 바이트씩 복사한다.
+		size_t matchIndex = 0;
+		for( ; matchIndex < matchLength; matchIndex++)
+		{
+			out[outPos + matchIndex] = out[outPos - offset + matchIndex];
+		}
+		outPos += matchLength;
 	}
 
-	return True;
+	return (ssize_t)outPos;
 }
-
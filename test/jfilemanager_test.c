@@ -1,3 +1,9 @@
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <signal.h>
 #include "../include/ttlib.h"
 #include "../include/jfilemanager.h"
 
@@ -9,6 +15,80 @@ DECLARE_TEST();
 
 // ---------- Common Test ----------
 
+// 따라 읽기 테스트에서 콜백이 받은 라인과 대기 횟수
+typedef struct _follow_state_t
+{
+	int idleNum;
+	int lineNum;
+	char lineList[4][32];
+	long long lineNumberList[4];
+} FollowState;
+
+static int FollowCallback(JFMPtr fm, int index, const char *line, long long lineNumber)
+{
+	FollowState *state = (FollowState*)JFMGetUserData(fm);
+	FILE *fp = NULL;
+
+	if(line == NULL)
+	{
+		// 대기 중에 파일에 라인을 추가하고, 다음에는 잘라서 새로 쓴다.
+		state->idleNum++;
+		if(state->idleNum == 1) fp = fopen(JFMGetFilePath(fm, index), "a");
+		else if(state->idleNum == 2) fp = fopen(JFMGetFilePath(fm, index), "w");
+		else return 1;
+
+		fputs((state->idleNum == 1) ? "c\nd\ne" : "x\n", fp);
+		fclose(fp);
+		return 0;
+	}
+
+	if(state->lineNum < 4)
+	{
+		strncpy(state->lineList[state->lineNum], line, 31);
+		state->lineNumberList[state->lineNum] = lineNumber;
+	}
+	state->lineNum++;
+	return (strcmp(line, "x\n") == 0) ? 1 : 0;
+}
+
+// "line <라인 번호>\n" 형식의 라인을 지정한 개수만큼 이어 붙인 내용을 만든다(라인 위치 색인 테스트용).
+static char* MakeLineData(int lineNum, size_t *dataLength)
+{
+	char *data = (char*)malloc(32 * (size_t)lineNum);
+	int lineIndex = 0;
+
+	*dataLength = 0;
+	for( ; lineIndex < lineNum; lineIndex++)
+	{
+		*dataLength += (size_t)sprintf(data + *dataLength, "line %d\n", lineIndex);
+	}
+	return data;
+}
+
+// 내용 검색 테스트에서 콜백이 받은 라인의 파일 인덱스와 라인 번호
+typedef struct _query_state_t
+{
+	int matchNum;
+	int indexList[8];
+	long long lineNumberList[8];
+	char lineList[8][32];
+} QueryState;
+
+static int QueryCallback(JFMPtr fm, int index, const char *line, long long lineNumber)
+{
+	QueryState *state = (QueryState*)JFMGetUserData(fm);
+
+	if(state->matchNum < 8)
+	{
+		state->indexList[state->matchNum] = index;
+		state->lineNumberList[state->matchNum] = lineNumber;
+		strncpy(state->lineList[state->matchNum], line, 31);
+		state->lineList[state->matchNum][31] = '\0';
+	}
+	state->matchNum++;
+	return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// FileManager Test
 ////////////////////////////////////////////////////////////////////////////////
@@ -314,6 +394,1616 @@ TEST(FileManager, FindFileByPath, {
 	JFMDelete(&fm);
 })
 
+TEST(FileManager, Dedupe, {
+	char *expected1 = "Hello world!\n";
+	char *expected2 = "Bye world!\n";
+	char *fileName1 = "fm_test1.txt";
+	char *fileName2 = "fm_test2.txt";
+	char *fileName3 = "fm_test3.txt";
+	int indices[3];
+	indices[0] = 0;
+	indices[1] = 1;
+	indices[2] = 2;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName1);
+	JFMNewFile(fm, fileName2);
+	JFMNewFile(fm, fileName3);
+
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected2, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 2, expected1, "w"));
+
+	EXPECT_NOT_NULL(JFMDedupe(fm, indices, 3, JFMDedupeAuto));
+	if(JFMGetFile(fm, 0)->stat.st_ino != JFMGetFile(fm, 2)->stat.st_ino)
+	{
+		// 리플링크 성공 시 아이노드는 유지되고 내용만 공유한다.
+		EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 2), JFMGetFileSize(fm, 0), longlong);
+	}
+	EXPECT_NUM_NOT_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_ino, (long long)JFMGetFile(fm, 1)->stat.st_ino, longlong);
+
+	EXPECT_NOT_NULL(JFMDedupe(fm, indices, 3, JFMDedupeHardlink));
+	EXPECT_NUM_EQUAL((long long)JFMGetFile(fm, 2)->stat.st_ino, (long long)JFMGetFile(fm, 0)->stat.st_ino, longlong);
+	EXPECT_NUM_EQUAL((long)JFMGetFile(fm, 0)->stat.st_nlink, 2, long);
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 2)[0], expected1);
+
+	EXPECT_NULL(JFMDedupe(NULL, indices, 3, JFMDedupeAuto));
+	EXPECT_NULL(JFMDedupe(fm, NULL, 3, JFMDedupeAuto));
+	EXPECT_NULL(JFMDedupe(fm, indices, 0, JFMDedupeAuto));
+	EXPECT_NULL(JFMDedupe(fm, indices, 3, (JFMDedupePolicy)0));
+
+	JFMDeleteFile(fm, 2);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyFileDelta, {
+	char *expected1 = "Hello world!\n";
+	char *expected2 = "Hello jworld\n";
+	char *fileName = "fm_test.txt";
+	char *filePath = "./fm_test_copy.txt";
+	JFMCopyOption option;
+	option.flags = JFMCopyDelta;
+	option.blockSize = 16;
+	option.threadNum = 4;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "a"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "a"));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, filePath, &option));
+
+	// 대상 파일이 있으면 달라진 구간만 다시 쓴다.
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected2, "a"));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, filePath, &option));
+
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 1), JFMGetFileSize(fm, 0), longlong);
+	char **dataList = JFMReadFile(fm, 1);
+	EXPECT_STR_EQUAL(dataList[0], expected1);
+	EXPECT_STR_EQUAL(dataList[1], expected2);
+
+	EXPECT_NULL(JFMCopyFileEx(NULL, 0, filePath, &option));
+	EXPECT_NULL(JFMCopyFileEx(fm, -1, filePath, &option));
+	EXPECT_NULL(JFMCopyFileEx(fm, 0, "abc.txt", &option));
+
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, ResizeFile, {
+	char *expected1 = "Hello world!\n";
+	char *fileName = "fm_test.txt";
+	char *filePath = "./fm_test_copy.txt";
+	off_t fileSize = 1024 * 1024;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+
+	// 크기를 유지하면서 공간만 예약
+	EXPECT_NOT_NULL(JFMResizeFile(fm, 0, fileSize, JFMResizeKeepSize));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), 13, longlong);
+	EXPECT_NUM_GREATER_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_blocks * 512, (long long)fileSize, longlong);
+
+	// 예약된 공간 해제
+	EXPECT_NOT_NULL(JFMResizeFile(fm, 0, 4096, JFMResizeKeepSize));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), 13, longlong);
+	EXPECT_NUM_LESS_THAN((long long)JFMGetFile(fm, 0)->stat.st_blocks * 512, (long long)fileSize, longlong);
+
+	// 미리 할당하면서 크기 변경
+	EXPECT_NOT_NULL(JFMResizeFile(fm, 0, fileSize, JFMResizePreallocate));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), (long long)fileSize, longlong);
+
+	// 구멍을 뚫고 복사해도 크기와 내용이 유지되어야 한다.
+	EXPECT_NOT_NULL(JFMPunchHole(fm, 0, 4096, fileSize - 4096));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), (long long)fileSize, longlong);
+	EXPECT_NOT_NULL(JFMCopyFile(fm, 0, filePath));
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 1), (long long)fileSize, longlong);
+	EXPECT_NUM_LESS_THAN((long long)JFMGetFile(fm, 1)->stat.st_blocks * 512, (long long)fileSize, longlong);
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 1)[0], expected1);
+
+	EXPECT_NULL(JFMResizeFile(NULL, 0, fileSize, JFMResizePreallocate));
+	EXPECT_NULL(JFMResizeFile(fm, -1, fileSize, JFMResizePreallocate));
+	EXPECT_NULL(JFMResizeFile(fm, 0, -1, JFMResizePreallocate));
+	EXPECT_NULL(JFMPunchHole(fm, 0, 0, 0));
+	EXPECT_NULL(JFMPunchHole(NULL, 0, 0, 4096));
+
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CompressFile, {
+	char *fileName = "fm_test.txt";
+	char lineData[32];
+	int lineNum = 20000;
+	size_t dataLength = 0;
+	char *data = MakeLineData(lineNum, &dataLength);
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, data, "w"));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, lineNum, longlong);
+
+	// 라인 위치 색인으로 한 라인만 읽기
+	char *line = JFMReadLine(fm, 0, 12345);
+	EXPECT_STR_EQUAL(line, "line 12345\n");
+	free(line);
+
+	// 압축 후에도 같은 내용을 읽을 수 있어야 한다.
+	EXPECT_NOT_NULL(JFMCompressFile(fm, 0));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), (long long)dataLength, longlong);
+	EXPECT_NUM_LESS_THAN((long long)JFMGetFile(fm, 0)->stat.st_size, (long long)dataLength, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, lineNum, longlong);
+	EXPECT_NULL(JFMWriteFile(fm, 0, data, "a"));
+
+	line = JFMReadLine(fm, 0, 19999);
+	EXPECT_STR_EQUAL(line, "line 19999\n");
+	free(line);
+
+	char **dataList = JFMReadFile(fm, 0);
+	sprintf(lineData, "line %d\n", 7777);
+	EXPECT_STR_EQUAL(dataList[7777], lineData);
+	EXPECT_NULL(JFMReadLine(fm, 0, lineNum));
+
+	// 복원하면 원래 파일과 같아야 한다.
+	EXPECT_NOT_NULL(JFMDecompressFile(fm, 0));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), (long long)dataLength, longlong);
+	EXPECT_NUM_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_size, (long long)dataLength, longlong);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "last", "a"));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, lineNum + 1, longlong);
+
+	line = JFMReadLine(fm, 0, lineNum);
+	EXPECT_STR_EQUAL(line, "last");
+	free(line);
+
+	free(data);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, PackFile, {
+	char *expected1 = "Hello world!\n";
+	char *expected2 = "124 1234y* (*ll2215 asdjfi3\t123\n";
+	char *packPath = "./fm_test.pack";
+	char *unpackDir = "./fm_test_unpack";
+	char *unpackPath = "./fm_test_unpack/fm_test2.txt";
+	char *copyPath = "./fm_test_copy.txt";
+	int indices[3];
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, "fm_test1.txt");
+	JFMNewFile(fm, "fm_test2.txt");
+	JFMNewFile(fm, "fm_test3.txt");
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected2, "a"));
+	EXPECT_NOT_NULL(JFMChangeMode(fm, 1, "0640"));
+
+	indices[0] = 0;
+	indices[1] = 1;
+	indices[2] = 2;
+	EXPECT_NOT_NULL(JFMPack(fm, indices, 3, packPath));
+	EXPECT_NULL(JFMPack(fm, indices, 0, packPath));
+
+	JFMDeleteFile(fm, 2);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+
+	// 풀지 않고 묶음 파일에서 바로 읽기
+	fm = JFMNew();
+	EXPECT_NOT_NULL(JFMOpenPack(fm, packPath));
+	EXPECT_NUM_EQUAL(fm->size, 4, int);
+	EXPECT_STR_EQUAL(JFMGetFileName(fm, 1), "fm_test2.txt");
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 1), (long long)(strlen(expected1) + strlen(expected2)), longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 2), 0, longlong);
+	EXPECT_STR_EQUAL(JFMGetFileMode(fm, 1), "rw-r-----");
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->line, 2, longlong);
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 1)[1], expected2);
+
+	char *line = JFMReadLine(fm, 1, 0);
+	EXPECT_STR_EQUAL(line, expected1);
+	free(line);
+
+	// 읽기 전용
+	EXPECT_NULL(JFMWriteFile(fm, 0, expected1, "a"));
+	EXPECT_NULL(JFMTruncateFile(fm, 0, 0));
+	EXPECT_NULL(JFMOpenPack(fm, packPath));
+
+	// 묶음 파일에서 꺼내서 복사
+	EXPECT_NOT_NULL(JFMCopyFile(fm, 1, copyPath));
+	EXPECT_NOT_NULL(JFMNewFile(fm, copyPath));
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 3)[1], expected2);
+	JFMDeleteFile(fm, 3);
+
+	// 묶음 파일의 항목을 삭제해도 원래 경로의 파일은 건드리지 않는다.
+	JFMDeleteFile(fm, 2);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+
+	// 지정한 디렉터리에 풀기
+	EXPECT_NUM_EQUAL(mkdir(unpackDir, 0755), 0, int);
+	EXPECT_NOT_NULL(JFMUnpack(fm, packPath, unpackDir));
+	EXPECT_STR_EQUAL(JFMGetFilePath(fm, 1), unpackPath);
+	EXPECT_STR_EQUAL(JFMGetFileMode(fm, 1), "rw-r-----");
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 1)[0], expected1);
+	EXPECT_NULL(JFMUnpack(fm, packPath, unpackDir));
+	EXPECT_NULL(JFMOpenPack(fm, "./fm_test_none.pack"));
+
+	JFMDeleteFile(fm, 2);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+
+	// 다른 디렉터리의 같은 이름 파일은 한 디렉터리에 풀 수 없고, 아무 파일도 만들지 않는다.
+	char *dupDir = "./fm_test_dup";
+	char *dupPath1 = "./fm_test_dup.txt";
+	char *dupPath2 = "./fm_test_dup/fm_test_dup.txt";
+	EXPECT_NUM_EQUAL(mkdir(dupDir, 0755), 0, int);
+	fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, dupPath1));
+	EXPECT_NOT_NULL(JFMNewFile(fm, dupPath2));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, expected1, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected2, "w"));
+	EXPECT_NOT_NULL(JFMPack(fm, indices, 2, packPath));
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+
+	EXPECT_NULL(JFMUnpack(fm, packPath, unpackDir));
+	EXPECT_NUM_EQUAL(fm->size, 1, int);
+	EXPECT_NUM_EQUAL(access("./fm_test_unpack/fm_test_dup.txt", F_OK), -1, int);
+	JFMDelete(&fm);
+
+	EXPECT_NUM_EQUAL(rmdir(dupDir), 0, int);
+	EXPECT_NUM_EQUAL(rmdir(unpackDir), 0, int);
+	EXPECT_NUM_EQUAL(unlink(packPath), 0, int);
+})
+
+TEST(FileManager, SaveAndLoadManifest, {
+	char *expected1 = "Hello world!\n";
+	char *manifestPath = "./fm_test.manifest";
+	char lineData[32];
+	int lineNum = 3000;
+	size_t dataLength = 0;
+	char *data = MakeLineData(lineNum, &dataLength);
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, "fm_test1.txt");
+	JFMNewFile(fm, "fm_test2.txt");
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, data, "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected1, "w"));
+	long long lineIndexSize = JFMGetFile(fm, 0)->lineIndexSize;
+	EXPECT_NUM_GREATER_THAN(lineIndexSize, 0, longlong);
+
+	EXPECT_NOT_NULL(JFMSaveManifest(fm, manifestPath));
+	JFMDelete(&fm);
+
+	// 바뀌지 않은 파일은 저장된 정보를 그대로 사용한다.
+	fm = JFMNew();
+	EXPECT_NOT_NULL(JFMLoadManifest(fm, manifestPath));
+	EXPECT_NUM_EQUAL(fm->size, 3, int);
+	EXPECT_STR_EQUAL(JFMGetFileName(fm, 0), "fm_test1.txt");
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, lineNum, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->lineIndexSize, lineIndexSize, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), (long long)dataLength, longlong);
+
+	char *line = JFMReadLine(fm, 0, 2500);
+	sprintf(lineData, "line %d\n", 2500);
+	EXPECT_STR_EQUAL(line, lineData);
+	free(line);
+
+	// 이미 관리 중인 파일은 다시 추가하지 않는다.
+	EXPECT_NOT_NULL(JFMLoadManifest(fm, manifestPath));
+	EXPECT_NUM_EQUAL(fm->size, 3, int);
+
+	// 바뀐 파일은 다시 라인 수를 센다.
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, expected1, "a"));
+	JFMDelete(&fm);
+
+	fm = JFMNew();
+	EXPECT_NOT_NULL(JFMLoadManifest(fm, manifestPath));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->line, 2, longlong);
+	EXPECT_STR_EQUAL(JFMReadFile(fm, 1)[1], expected1);
+
+	EXPECT_NULL(JFMLoadManifest(fm, "./fm_test_none.manifest"));
+	EXPECT_NULL(JFMSaveManifest(NULL, manifestPath));
+
+	free(data);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+	EXPECT_NUM_EQUAL(unlink(manifestPath), 0, int);
+})
+
+TEST(FileManager, CountLargeFile, {
+	char *filePath = "./fm_test_large.txt";
+	char lineData[32];
+	long long lineNum = 6000000;
+	long long lineIndex = 0;
+
+	// 병렬로 라인 수를 세는 크기(64MB) 이상인 파일 생성(라인마다 13 바이트)
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	for( ; lineIndex < lineNum; lineIndex++)
+	{
+		fprintf(fp, "line %07lld\n", lineIndex);
+	}
+	fputs("last", fp);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, lineNum + 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, lineNum * 12 + 4, longlong);
+	EXPECT_NUM_GREATER_THAN(JFMGetFile(fm, 0)->lineIndexSize, 0, longlong);
+
+	// 구간 경계 뒤의 라인도 색인으로 찾을 수 있어야 한다.
+	char *line = JFMReadLine(fm, 0, 5123457);
+	sprintf(lineData, "line %07d\n", 5123457);
+	EXPECT_STR_EQUAL(line, lineData);
+	free(line);
+
+	line = JFMReadLine(fm, 0, lineNum);
+	EXPECT_STR_EQUAL(line, "last");
+	free(line);
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, FollowFile, {
+	char *fileName = "fm_test.txt";
+	FollowState state;
+	memset(&state, 0, sizeof(state));
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	JFMSetUserData(fm, &state);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "a\nb", "w"));
+
+	// 완성되지 않은 마지막 라인부터 따라 읽고, 잘리면 처음부터 다시 읽는다.
+	EXPECT_NOT_NULL(JFMFollow(fm, 0, FollowCallback));
+	EXPECT_NUM_EQUAL(state.lineNum, 3, int);
+	EXPECT_STR_EQUAL(state.lineList[0], "bc\n");
+	EXPECT_NUM_EQUAL(state.lineNumberList[0], 1, longlong);
+	EXPECT_STR_EQUAL(state.lineList[1], "d\n");
+	EXPECT_NUM_EQUAL(state.lineNumberList[1], 2, longlong);
+	EXPECT_STR_EQUAL(state.lineList[2], "x\n");
+	EXPECT_NUM_EQUAL(state.lineNumberList[2], 0, longlong);
+
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), 2, longlong);
+	EXPECT_NULL(JFMFollow(fm, 0, NULL));
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, ReadTail, {
+	char *fileName = "fm_test.txt";
+	char lineData[32];
+	int lineNum = 100000;
+	size_t dataLength = 0;
+	char *data = MakeLineData(lineNum, &dataLength);
+	JFMLines lines;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, data, "w"));
+
+	// 블록 경계에 걸친 라인을 포함해서 마지막 라인들만 읽기
+	EXPECT_NOT_NULL(JFMReadTail(fm, 0, 50000, &lines));
+	EXPECT_NUM_EQUAL(lines.lineNum, 50000, longlong);
+	EXPECT_NUM_EQUAL(lines.firstLine, 50000, longlong);
+	EXPECT_STR_EQUAL(lines.lineList[0], "line 50000\n");
+	EXPECT_STR_EQUAL(lines.lineList[49999], "line 99999\n");
+	JFMFreeLines(&lines);
+
+	// 라인 수보다 많이 요청하면 전체 라인
+	EXPECT_NOT_NULL(JFMReadTail(fm, 0, lineNum + 10, &lines));
+	EXPECT_NUM_EQUAL(lines.lineNum, lineNum, longlong);
+	EXPECT_NUM_EQUAL(lines.firstLine, 0, longlong);
+	JFMFreeLines(&lines);
+
+	EXPECT_NOT_NULL(JFMReadTail(fm, 0, 0, &lines));
+	EXPECT_NUM_EQUAL(lines.lineNum, 0, longlong);
+	JFMFreeLines(&lines);
+
+	// 개행 문자로 끝나지 않는 마지막 라인
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "last", "a"));
+	EXPECT_NOT_NULL(JFMReadTail(fm, 0, 2, &lines));
+	EXPECT_NUM_EQUAL(lines.lineNum, 2, longlong);
+	EXPECT_NUM_EQUAL(lines.firstLine, lineNum - 1, longlong);
+	EXPECT_STR_EQUAL(lines.lineList[0], "line 99999\n");
+	EXPECT_STR_EQUAL(lines.lineList[1], "last");
+	JFMFreeLines(&lines);
+
+	// 압축 파일도 같은 결과
+	EXPECT_NOT_NULL(JFMCompressFile(fm, 0));
+	EXPECT_NOT_NULL(JFMReadTail(fm, 0, 3, &lines));
+	sprintf(lineData, "line %d\n", lineNum - 2);
+	EXPECT_STR_EQUAL(lines.lineList[0], lineData);
+	EXPECT_NUM_EQUAL(lines.firstLine, lineNum - 2, longlong);
+	JFMFreeLines(&lines);
+
+	EXPECT_NULL(JFMReadTail(fm, 0, -1, &lines));
+	EXPECT_NULL(JFMReadTail(fm, 0, 1, NULL));
+
+	free(data);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, ReadRangeAndInto, {
+	char *fileName = "fm_test.txt";
+	char buf[64];
+	size_t lineOffsets[5];
+	off_t offset = 0;
+	long long lineNum = 0;
+	long long totalLineNum = 0;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "Hello world!\nabc\n0123456789\nend", "w"));
+
+	// 바이트 구간 읽기
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, 6, 5, buf), 5, longlong);
+	EXPECT_NUM_EQUAL(memcmp(buf, "world", 5), 0, int);
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, 30, 10, buf), 1, longlong);
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, 100, 10, buf), 0, longlong);
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, -1, 10, buf), -1, longlong);
+
+	// 버퍼에 들어가는 라인만 읽고 이어서 읽기
+	lineNum = JFMReadInto(fm, 0, offset, buf, 20, lineOffsets, 4);
+	EXPECT_NUM_EQUAL(lineNum, 2, longlong);
+	EXPECT_NUM_EQUAL((long long)lineOffsets[1], 13, longlong);
+	EXPECT_NUM_EQUAL((long long)lineOffsets[2], 17, longlong);
+	EXPECT_NUM_EQUAL(memcmp(buf + lineOffsets[1], "abc\n", 4), 0, int);
+
+	while(lineNum > 0)
+	{
+		totalLineNum += lineNum;
+		offset += (off_t)lineOffsets[lineNum];
+		lineNum = JFMReadInto(fm, 0, offset, buf, 20, lineOffsets, 4);
+	}
+	EXPECT_NUM_EQUAL(lineNum, 0, longlong);
+	EXPECT_NUM_EQUAL(totalLineNum, 4, longlong);
+	EXPECT_NUM_EQUAL((long long)offset, 31, longlong);
+
+	// 한 라인도 들어가지 않는 버퍼
+	EXPECT_NUM_EQUAL(JFMReadInto(fm, 0, 0, buf, 5, lineOffsets, 4), -1, longlong);
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, WriteFileVAndPWrite, {
+	char *fileName = "fm_test.txt";
+	char buf[64];
+	struct iovec iov[3];
+	JFMPtr checkFm = NULL;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+
+	// 머리, 바이너리 본문, 꼬리를 한 번에 쓰기
+	iov[0].iov_base = "head|";
+	iov[0].iov_len = 5;
+	iov[1].iov_base = "bo\0dy\n";
+	iov[1].iov_len = 6;
+	iov[2].iov_base = "trail\n";
+	iov[2].iov_len = 6;
+	EXPECT_NOT_NULL(JFMWriteFileV(fm, 0, iov, 3, "w"));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 2, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, 15, longlong);
+	EXPECT_NUM_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_size, 17, longlong);
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, 5, 6, buf), 6, longlong);
+	EXPECT_NUM_EQUAL(memcmp(buf, "bo\0dy\n", 6), 0, int);
+
+	// 끝에 추가하기
+	iov[0].iov_base = "x\ny";
+	iov[0].iov_len = 3;
+	EXPECT_NOT_NULL(JFMWriteFileV(fm, 0, iov, 1, "a"));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 4, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, 17, longlong);
+
+	// 중간 덮어쓰기 및 파일 끝보다 뒤에 쓰기
+	iov[0].iov_base = "\n";
+	iov[0].iov_len = 1;
+	EXPECT_NUM_EQUAL(JFMPWrite(fm, 0, iov, 1, 0), 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 5, longlong);
+	iov[0].iov_base = "zz\n";
+	iov[0].iov_len = 3;
+	EXPECT_NUM_EQUAL(JFMPWrite(fm, 0, iov, 1, 25), 3, longlong);
+	EXPECT_NUM_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_size, 28, longlong);
+
+	// 다시 센 결과와 같아야 한다.
+	checkFm = JFMNew();
+	JFMNewFile(checkFm, fileName);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, JFMGetFile(checkFm, 0)->line, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, JFMGetFile(checkFm, 0)->totalCharCount, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 5, longlong);
+	JFMDelete(&checkFm);
+
+	EXPECT_NULL(JFMWriteFileV(fm, 0, iov, 1, "r"));
+	EXPECT_NUM_EQUAL(JFMPWrite(fm, 0, iov, 0, 0), -1, longlong);
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, ReplaceFile, {
+	char *fileName = "fm_test.txt";
+	char buf[64];
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "old line\n", "w"));
+	EXPECT_NUM_EQUAL(chmod(fileName, 0640), 0, int);
+	long long oldInode = (long long)JFMGetFile(fm, 0)->stat.st_ino;
+
+	// 교체 전에 연 파일은 이전 내용을 그대로 읽는다.
+	int oldFd = open(fileName, O_RDONLY);
+	EXPECT_NUM_GREATER_EQUAL(oldFd, 0, int);
+
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, "new\ncontent\nend", 16, JFMReplaceSync));
+	EXPECT_NUM_NOT_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_ino, oldInode, longlong);
+	EXPECT_NUM_EQUAL((int)(JFMGetFile(fm, 0)->stat.st_mode & 07777), 0640, int);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 3, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, 14, longlong);
+	EXPECT_NUM_EQUAL((long long)JFMGetFile(fm, 0)->stat.st_size, 16, longlong);
+
+	EXPECT_NUM_EQUAL(JFMReadRange(fm, 0, 0, sizeof(buf), buf), 16, longlong);
+	EXPECT_NUM_EQUAL(memcmp(buf, "new\ncontent\nend", 16), 0, int);
+	EXPECT_NUM_EQUAL(pread(oldFd, buf, sizeof(buf), 0), 9, longlong);
+	EXPECT_NUM_EQUAL(memcmp(buf, "old line\n", 9), 0, int);
+	close(oldFd);
+
+	// 빈 내용으로 교체
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, NULL, 0, 0));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 0, longlong);
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, EditLines, {
+	char *fileName = "fm_test.txt";
+	char expected[32];
+	char *line = NULL;
+	int lineIndex = 0;
+	size_t length = 0;
+	JFMPtr checkFm = NULL;
+
+	// 라인 위치 색인이 만들어지도록 3000 라인 파일 생성
+	char *data = (char*)malloc(3000 * 16);
+	EXPECT_NOT_NULL(data);
+	for( ; lineIndex < 3000; lineIndex++)
+	{
+		length += (size_t)sprintf(data + length, "line%d\n", lineIndex);
+	}
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, data, length, 0));
+	free(data);
+
+	JFMEditPtr edit = JFMEditOpen(fm, 0);
+	EXPECT_NOT_NULL(edit);
+	EXPECT_NUM_EQUAL(JFMEditGetLineNum(edit), 3000, longlong);
+
+	// 0 번 라인 앞에 추가, 5 번(원래 4 번) 라인 변경, 2501 번(원래 2500 번) 라인 삭제, 끝에 추가
+	EXPECT_NOT_NULL(JFMEditInsertLine(edit, 0, "first"));
+	EXPECT_NOT_NULL(JFMEditReplaceLine(edit, 5, "changed\n"));
+	EXPECT_NOT_NULL(JFMEditDeleteLine(edit, 2501));
+	EXPECT_NOT_NULL(JFMEditInsertLine(edit, JFMEditGetLineNum(edit), "last"));
+	EXPECT_NULL(JFMEditDeleteLine(edit, 5000));
+	EXPECT_NUM_EQUAL(JFMEditGetLineNum(edit), 3001, longlong);
+
+	EXPECT_NOT_NULL(JFMEditCommit(edit));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 3001, longlong);
+
+	line = JFMReadLine(fm, 0, 0);
+	EXPECT_STR_EQUAL(line, "first\n");
+	free(line);
+	line = JFMReadLine(fm, 0, 5);
+	EXPECT_STR_EQUAL(line, "changed\n");
+	free(line);
+	line = JFMReadLine(fm, 0, 2501);
+	EXPECT_STR_EQUAL(line, "line2501\n");
+	free(line);
+	line = JFMReadLine(fm, 0, 2999);
+	EXPECT_STR_EQUAL(line, "line2999\n");
+	free(line);
+	line = JFMReadLine(fm, 0, 3000);
+	EXPECT_STR_EQUAL(line, "last\n");
+	free(line);
+
+	// 색인을 옮겨서 찾은 라인과 처음부터 다시 센 결과가 같아야 한다.
+	checkFm = JFMNew();
+	JFMNewFile(checkFm, fileName);
+	EXPECT_NUM_EQUAL(JFMGetFile(checkFm, 0)->line, JFMGetFile(fm, 0)->line, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(checkFm, 0)->totalCharCount, JFMGetFile(fm, 0)->totalCharCount, longlong);
+	for(lineIndex = 1024; lineIndex < 3001; lineIndex += 397)
+	{
+		sprintf(expected, "line%d\n", lineIndex - ((lineIndex >= 2501) ? 0 : 1));
+		line = JFMReadLine(fm, 0, lineIndex);
+		EXPECT_STR_EQUAL(line, expected);
+		free(line);
+	}
+	JFMDelete(&checkFm);
+	JFMEditClose(&edit);
+	EXPECT_NULL(edit);
+
+	// 개행 문자로 끝나지 않은 마지막 라인 뒤에 추가
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "a\nb", "w"));
+	edit = JFMEditOpen(fm, 0);
+	EXPECT_NOT_NULL(JFMEditInsertLine(edit, 2, "c"));
+	EXPECT_NOT_NULL(JFMEditCommit(edit));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 3, longlong);
+	line = JFMReadLine(fm, 0, 1);
+	EXPECT_STR_EQUAL(line, "b\n");
+	free(line);
+
+	// 반영한 후 이어서 편집
+	EXPECT_NOT_NULL(JFMEditDeleteLine(edit, 0));
+	EXPECT_NOT_NULL(JFMEditCommit(edit));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), 4, longlong);
+
+	// 편집하는 동안 다른 파일로 바뀌었으면 반영하지 않음
+	EXPECT_NOT_NULL(JFMEditReplaceLine(edit, 0, "BBBBBBBB"));
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, "x\ny\n", 4, 0));
+	EXPECT_NULL(JFMEditCommit(edit));
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 0), 4, longlong);
+	line = JFMReadLine(fm, 0, 0);
+	EXPECT_STR_EQUAL(line, "x\n");
+	free(line);
+	JFMEditClose(&edit);
+
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, WriteBack, {
+	char *fileName = "fm_test.txt";
+	struct stat fileStat;
+	JFMWriteBackOption option;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "", "w"));
+
+	option.maxFileDirtySize = 1024 * 1024;
+	option.maxDirtyAge = 60 * 1000;
+	option.maxTotalDirtySize = 0;
+	EXPECT_NOT_NULL(JFMEnableWriteBack(fm, &option));
+	EXPECT_NULL(JFMEnableWriteBack(fm, &option));
+
+	// 버퍼에만 저장하므로 실제 파일은 그대로다.
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "first\n", "a"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "second\n", "a"));
+	EXPECT_NUM_EQUAL(stat(fileName, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 0, longlong);
+
+	// 읽으면 대기 내용이 먼저 저장된다.
+	char **dataList = JFMReadFile(fm, 0);
+	EXPECT_NOT_NULL(dataList);
+	EXPECT_STR_EQUAL(dataList[0], "first\n");
+	EXPECT_STR_EQUAL(dataList[1], "second\n");
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 2, longlong);
+
+	// "w" 모드는 이전 대기 내용을 버리고 파일을 새로 쓴다.
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "dropped\n", "a"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "new\n", "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "tail\n", "a"));
+	EXPECT_NOT_NULL(JFMFlush(fm, 0));
+	EXPECT_NUM_EQUAL(stat(fileName, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 9, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 2, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->totalCharCount, 7, longlong);
+	EXPECT_NOT_NULL(JFMDisableWriteBack(fm));
+
+	// 대기 시간이 지나면 저장 스레드가 저장한다.
+	option.maxDirtyAge = 50;
+	EXPECT_NOT_NULL(JFMEnableWriteBack(fm, &option));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "aged\n", "a"));
+	usleep(300 * 1000);
+	EXPECT_NUM_EQUAL(stat(fileName, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 14, longlong);
+
+	// 파일별 대기 크기를 넘어도 저장 스레드가 저장한다.
+	option.maxDirtyAge = 60 * 1000;
+	option.maxFileDirtySize = 8;
+	EXPECT_NOT_NULL(JFMDisableWriteBack(fm));
+	EXPECT_NOT_NULL(JFMEnableWriteBack(fm, &option));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "over size\n", "a"));
+	usleep(300 * 1000);
+	EXPECT_NUM_EQUAL(stat(fileName, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 24, longlong);
+
+	// 삭제하면 남은 대기 내용을 저장한다.
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "last\n", "a"));
+	JFMDelete(&fm);
+	EXPECT_NUM_EQUAL(stat(fileName, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 29, longlong);
+	unlink(fileName);
+})
+
+TEST(FileManager, AccessPolicy, {
+	char *fileName = "fm_test.txt";
+	char *copyName = "./fm_test_copy.txt";
+	char line[128];
+	int index[1];
+	unsigned char pageList[64];
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMSetAccessPolicy(fm, JFMAccessOnce));
+	EXPECT_NULL(JFMSetAccessPolicy(fm, (JFMAccessPolicy)100));
+	JFMNewFile(fm, fileName);
+	EXPECT_NUM_EQUAL((int)JFMGetFile(fm, 0)->accessPolicy, (int)JFMAccessOnce, int);
+
+	memset(line, 'a', sizeof(line) - 1);
+	line[sizeof(line) - 2] = '\n';
+	line[sizeof(line) - 1] = '\0';
+	int lineIndex = 0;
+	for( ; lineIndex < 1024; lineIndex++) JFMWriteFile(fm, 0, line, "a");
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 0)->line, 1024, longlong);
+
+	// 한 번만 쓰는 복사는 원본과 대상 파일의 페이지 캐시를 비운다.
+	EXPECT_NOT_NULL(JFMCopyFile(fm, 0, copyName));
+	int fd = open(copyName, O_RDONLY);
+	EXPECT_NUM_GREATER_EQUAL(fd, 0, int);
+	size_t mapSize = 1024 * sizeof(line);
+	void *map = mmap(NULL, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+	EXPECT_NUM_EQUAL(mincore(map, mapSize, pageList), 0, int);
+	int residentNum = 0;
+	int pageIndex = 0;
+	for( ; pageIndex < (int)((mapSize + 4095) / 4096); pageIndex++) residentNum += pageList[pageIndex] & 1;
+	EXPECT_NUM_EQUAL(residentNum, 0, int);
+
+	// 미리 읽으면 다시 페이지 캐시에 올라온다(비동기로 읽으므로 잠시 기다림).
+	EXPECT_NOT_NULL(JFMNewFile(fm, copyName));
+	index[0] = 1;
+	EXPECT_NOT_NULL(JFMPrefetch(fm, index, 1));
+	usleep(300 * 1000);
+	EXPECT_NUM_EQUAL(mincore(map, mapSize, pageList), 0, int);
+	residentNum = 0;
+	for(pageIndex = 0; pageIndex < (int)((mapSize + 4095) / 4096); pageIndex++) residentNum += pageList[pageIndex] & 1;
+	EXPECT_NUM_GREATER_EQUAL(residentNum, 1, int);
+	munmap(map, mapSize);
+	close(fd);
+
+	// 접근 방식과 관계없이 내용은 같다.
+	EXPECT_NOT_NULL(JFMSetFileAccessPolicy(fm, 1, JFMAccessRandom));
+	char *readLine = JFMReadLine(fm, 1, 1000);
+	EXPECT_STR_EQUAL(readLine, line);
+	free(readLine);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->line, 1024, longlong);
+	index[0] = 5;
+	EXPECT_NULL(JFMPrefetch(fm, index, 1));
+
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyFileDirect, {
+	char *fileName = "fm_test.txt";
+	char *copyName = "./fm_test_copy.txt";
+	JFMCopyOption option;
+	option.flags = JFMCopyDirect | JFMCopyDropCache;
+	option.blockSize = 0;
+	option.threadNum = 0;
+
+	// 버퍼 여러 개를 돌려 쓰고 정렬되지 않은 끝부분이 남는 크기
+	size_t dataSize = 9 * 1024 * 1024 + 123;
+	char *data = (char*)malloc(dataSize);
+	char *copyData = (char*)malloc(dataSize + 1);
+	EXPECT_NOT_NULL(data);
+	EXPECT_NOT_NULL(copyData);
+	size_t dataIndex = 0;
+	for( ; dataIndex < dataSize; dataIndex++) data[dataIndex] = ((dataIndex % 64) == 63) ? '\n' : (char)('a' + (dataIndex % 26));
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, fileName);
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, data, dataSize, 0));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyName, &option));
+
+	int fd = open(copyName, O_RDONLY);
+	EXPECT_NUM_GREATER_EQUAL(fd, 0, int);
+	EXPECT_NUM_EQUAL(pread(fd, copyData, dataSize + 1, 0), (long long)dataSize, longlong);
+	EXPECT_NUM_EQUAL(memcmp(data, copyData, dataSize), 0, int);
+	close(fd);
+
+	// O_DIRECT 로 맞출 구간이 없는 작은 파일
+	EXPECT_NOT_NULL(JFMReplaceFile(fm, 0, "small\n", 6, 0));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyName, &option));
+	fd = open(copyName, O_RDONLY);
+	EXPECT_NUM_EQUAL(pread(fd, copyData, dataSize, 0), 6, longlong);
+	EXPECT_NUM_EQUAL(memcmp(copyData, "small\n", 6), 0, int);
+	close(fd);
+
+	unlink(copyName);
+	free(copyData);
+	free(data);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyFiles, {
+	int index[3];
+	const char *destPaths[3];
+	JFMCopyResult results[3];
+	JFMCopySummary summary;
+	JFMCopyOption option;
+	option.flags = 0;
+	option.blockSize = 0;
+	option.threadNum = 2;
+	struct stat fileStat;
+
+	JFMPtr fm = JFMNew();
+	JFMNewFile(fm, "fm_test.txt");
+	JFMNewFile(fm, "fm_test2.txt");
+	JFMNewFile(fm, "fm_test3.txt");
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "small\n", "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 1, "largest file\nsecond line\n", "w"));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 2, "middle size\n", "w"));
+
+	index[0] = 0;
+	index[1] = 1;
+	index[2] = 2;
+	destPaths[0] = "./fm_test_copy.txt";
+	destPaths[1] = "./fm_test_copy2.txt";
+	destPaths[2] = "./fm_test_copy3.txt";
+	EXPECT_NOT_NULL(JFMCopyFiles(fm, index, destPaths, 3, &option, results, &summary));
+	EXPECT_NUM_EQUAL(results[0].error, 0, int);
+	EXPECT_NUM_EQUAL(results[0].size, 6, longlong);
+	EXPECT_NUM_EQUAL(results[1].size, 25, longlong);
+	EXPECT_NUM_EQUAL(results[2].size, 12, longlong);
+	EXPECT_NUM_EQUAL(summary.copiedNum, 3, int);
+	EXPECT_NUM_EQUAL(summary.failedNum, 0, int);
+	EXPECT_NUM_EQUAL(summary.totalSize, 43, longlong);
+	EXPECT_NUM_EQUAL(stat(destPaths[1], &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 25, longlong);
+
+	// 실패한 파일이 있어도 나머지는 복사한다.
+	unlink(destPaths[0]);
+	destPaths[1] = "./fm_no_such_dir/fm_test_copy2.txt";
+	EXPECT_NULL(JFMCopyFiles(fm, index, destPaths, 3, NULL, results, &summary));
+	EXPECT_NUM_EQUAL(results[1].error, ENOENT, int);
+	EXPECT_NUM_EQUAL(results[0].error, 0, int);
+	EXPECT_NUM_EQUAL(summary.failedNum, 1, int);
+	EXPECT_NUM_EQUAL(stat(destPaths[0], &fileStat), 0, int);
+
+	destPaths[1] = NULL;
+	EXPECT_NULL(JFMCopyFiles(fm, index, destPaths, 3, NULL, NULL, NULL));
+
+	unlink("./fm_test_copy.txt");
+	unlink("./fm_test_copy2.txt");
+	unlink("./fm_test_copy3.txt");
+	JFMDeleteFile(fm, 2);
+	JFMDeleteFile(fm, 1);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyLargeFile, {
+	char *filePath = "./fm_test_large.txt";
+	char *copyPath = "./fm_test_copy.txt";
+	size_t bufSize = 1024 * 1024;
+	char *buf = (char*)malloc(bufSize);
+	char *copyBuf = (char*)malloc(bufSize);
+	JFMCopyOption option;
+	option.flags = 0;
+	option.blockSize = 0;
+	option.threadNum = 4;
+	struct stat fileStat;
+
+	// 구간별로 병렬 복사하는 크기(64MB) 이상이고 구간 크기의 배수가 아닌 파일
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	int chunkIndex = 0;
+	for( ; chunkIndex < 70; chunkIndex++)
+	{
+		memset(buf, 'a' + (chunkIndex % 26), bufSize);
+		buf[bufSize - 1] = '\n';
+		fwrite(buf, 1, bufSize, fp);
+	}
+	fputs("last", fp);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+
+	int srcFd = open(filePath, O_RDONLY);
+	int destFd = open(copyPath, O_RDONLY);
+	EXPECT_NUM_EQUAL(fstat(destFd, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 70LL * 1024 * 1024 + 4, longlong);
+	int differentNum = 0;
+	off_t offset = 0;
+	for( ; offset < fileStat.st_size; offset += (off_t)bufSize)
+	{
+		ssize_t readSize = pread(srcFd, buf, bufSize, offset);
+		if((pread(destFd, copyBuf, bufSize, offset) != readSize) || (memcmp(buf, copyBuf, (size_t)readSize) != 0)) differentNum++;
+	}
+	EXPECT_NUM_EQUAL(differentNum, 0, int);
+	close(destFd);
+	close(srcFd);
+
+	// 구멍이 있는 파일은 구멍을 유지한다.
+	JFMDeleteFile(fm, 0);
+	srcFd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	EXPECT_NUM_EQUAL(pwrite(srcFd, "head\n", 5, 0), 5, longlong);
+	EXPECT_NUM_EQUAL(pwrite(srcFd, "middle\n", 7, 40LL * 1024 * 1024), 7, longlong);
+	EXPECT_NUM_EQUAL(pwrite(srcFd, "tail\n", 5, 100LL * 1024 * 1024), 5, longlong);
+	close(srcFd);
+
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+	destFd = open(copyPath, O_RDONLY);
+	EXPECT_NUM_EQUAL(fstat(destFd, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 100LL * 1024 * 1024 + 5, longlong);
+	EXPECT_NUM_LESS_THAN((long long)fileStat.st_blocks * 512, 1024LL * 1024, longlong);
+	EXPECT_NUM_EQUAL(pread(destFd, copyBuf, 7, 40LL * 1024 * 1024), 7, longlong);
+	EXPECT_NUM_EQUAL(memcmp(copyBuf, "middle\n", 7), 0, int);
+	close(destFd);
+
+	unlink(copyPath);
+	free(copyBuf);
+	free(buf);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyFileResume, {
+	char *filePath = "./fm_test_resume.txt";
+	char *copyPath = "./fm_test_copy.txt";
+	char *checkpointPath = "./fm_test_copy.txt.jfmckpt";
+	size_t bufSize = 1024 * 1024;
+	char *buf = (char*)malloc(bufSize);
+	char *copyBuf = (char*)malloc(bufSize);
+	JFMCopyOption option;
+	option.flags = JFMCopyResume;
+	option.blockSize = bufSize;
+	option.threadNum = 0;
+	struct stat fileStat;
+	struct rlimit oldLimit;
+	struct rlimit limit;
+
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	int chunkIndex = 0;
+	for( ; chunkIndex < 8; chunkIndex++)
+	{
+		memset(buf, 'a' + chunkIndex, bufSize);
+		buf[bufSize - 1] = '\n';
+		fwrite(buf, 1, bufSize, fp);
+	}
+	fputs("last", fp);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+
+	// 파일 크기 제한으로 5.5MB 에서 복사를 중단시키면 마지막 체크포인트(5MB)가 남는다.
+	unlink(copyPath);
+	signal(SIGXFSZ, SIG_IGN);
+	getrlimit(RLIMIT_FSIZE, &oldLimit);
+	limit = oldLimit;
+	limit.rlim_cur = (rlim_t)(bufSize * 5 + bufSize / 2);
+	setrlimit(RLIMIT_FSIZE, &limit);
+	EXPECT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+	setrlimit(RLIMIT_FSIZE, &oldLimit);
+	signal(SIGXFSZ, SIG_DFL);
+	EXPECT_NUM_EQUAL(access(checkpointPath, F_OK), 0, int);
+
+	// 이어서 복사하면 체크포인트 앞부분은 다시 쓰지 않으므로 그 사이에 바꾼 첫 바이트가 그대로 남는다.
+	int destFd = open(copyPath, O_WRONLY);
+	EXPECT_NUM_EQUAL(pwrite(destFd, "X", 1, 0), 1, longlong);
+	close(destFd);
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+	EXPECT_NUM_EQUAL(access(checkpointPath, F_OK), -1, int);
+
+	int srcFd = open(filePath, O_RDONLY);
+	destFd = open(copyPath, O_RDONLY);
+	EXPECT_NUM_EQUAL(fstat(destFd, &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 8LL * 1024 * 1024 + 4, longlong);
+	EXPECT_NUM_EQUAL(pread(destFd, copyBuf, 1, 0), 1, longlong);
+	EXPECT_NUM_EQUAL(copyBuf[0], 'X', int);
+	int differentNum = 0;
+	off_t offset = 1;
+	for( ; offset < fileStat.st_size; offset += (off_t)bufSize)
+	{
+		ssize_t readSize = pread(srcFd, buf, bufSize, offset);
+		if((pread(destFd, copyBuf, bufSize, offset) != readSize) || (memcmp(buf, copyBuf, (size_t)readSize) != 0)) differentNum++;
+	}
+	EXPECT_NUM_EQUAL(differentNum, 0, int);
+	close(destFd);
+
+	// 마지막 체크포인트 구간이 바뀌었으면 체크포인트를 믿지 않고 처음부터 다시 복사한다.
+	setrlimit(RLIMIT_FSIZE, &limit);
+	signal(SIGXFSZ, SIG_IGN);
+	EXPECT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+	setrlimit(RLIMIT_FSIZE, &oldLimit);
+	signal(SIGXFSZ, SIG_DFL);
+	destFd = open(copyPath, O_WRONLY);
+	EXPECT_NUM_EQUAL(pwrite(destFd, "X", 1, 0), 1, longlong);
+	EXPECT_NUM_EQUAL(pwrite(destFd, "X", 1, 4LL * 1024 * 1024 + 10), 1, longlong);
+	close(destFd);
+	EXPECT_NOT_NULL(JFMCopyFileEx(fm, 0, copyPath, &option));
+	destFd = open(copyPath, O_RDONLY);
+	EXPECT_NUM_EQUAL(pread(destFd, copyBuf, 1, 0), 1, longlong);
+	EXPECT_NUM_EQUAL(copyBuf[0], 'a', int);
+	EXPECT_NUM_EQUAL(pread(destFd, copyBuf, 1, 4LL * 1024 * 1024 + 10), 1, longlong);
+	EXPECT_NUM_EQUAL(copyBuf[0], 'e', int);
+	close(destFd);
+	close(srcFd);
+
+	unlink(copyPath);
+	free(copyBuf);
+	free(buf);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, CopyFileMulti, {
+	char *filePath = "./fm_test_multi.txt";
+	const char *destPaths[3];
+	destPaths[0] = "./fm_test_multi_1.txt";
+	destPaths[1] = "./fm_test_multi_2.txt";
+	destPaths[2] = "./fm_test_multi_3.txt";
+	size_t bufSize = 1024 * 1024;
+	char *buf = (char*)malloc(bufSize);
+	char *copyBuf = (char*)malloc(bufSize);
+	struct stat fileStat;
+
+	// 블록 크기(4MB)의 배수가 아닌 파일
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	int chunkIndex = 0;
+	for( ; chunkIndex < 9; chunkIndex++)
+	{
+		memset(buf, 'a' + chunkIndex, bufSize);
+		buf[bufSize - 1] = '\n';
+		fwrite(buf, 1, bufSize, fp);
+	}
+	fputs("last", fp);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NOT_NULL(JFMCopyFileMulti(fm, 0, destPaths, 3));
+
+	int srcFd = open(filePath, O_RDONLY);
+	int differentNum = 0;
+	int destIndex = 0;
+	for( ; destIndex < 3; destIndex++)
+	{
+		int destFd = open(destPaths[destIndex], O_RDONLY);
+		EXPECT_NUM_EQUAL(fstat(destFd, &fileStat), 0, int);
+		EXPECT_NUM_EQUAL((long long)fileStat.st_size, 9LL * 1024 * 1024 + 4, longlong);
+		off_t offset = 0;
+		for( ; offset < fileStat.st_size; offset += (off_t)bufSize)
+		{
+			ssize_t readSize = pread(srcFd, buf, bufSize, offset);
+			if((pread(destFd, copyBuf, bufSize, offset) != readSize) || (memcmp(buf, copyBuf, (size_t)readSize) != 0)) differentNum++;
+		}
+		close(destFd);
+	}
+	EXPECT_NUM_EQUAL(differentNum, 0, int);
+	close(srcFd);
+
+	// 쓰기 지연 중인 내용도 복사하고, 빈 파일도 복사한다.
+	EXPECT_NOT_NULL(JFMEnableWriteBack(fm, NULL));
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "new\n", "w"));
+	EXPECT_NOT_NULL(JFMCopyFileMulti(fm, 0, destPaths, 2));
+	EXPECT_NUM_EQUAL(stat(destPaths[1], &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 4LL, longlong);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "", "w"));
+	EXPECT_NOT_NULL(JFMCopyFileMulti(fm, 0, destPaths, 1));
+	EXPECT_NUM_EQUAL(stat(destPaths[0], &fileStat), 0, int);
+	EXPECT_NUM_EQUAL((long long)fileStat.st_size, 0LL, longlong);
+
+	// 잘못된 대상 경로가 있으면 실패한다.
+	destPaths[2] = "./fm_no_dir/fm_test_multi_3.txt";
+	EXPECT_NULL(JFMCopyFileMulti(fm, 0, destPaths, 3));
+	EXPECT_NULL(JFMCopyFileMulti(fm, 1, destPaths, 2));
+
+	unlink(destPaths[0]);
+	unlink(destPaths[1]);
+	unlink("./fm_test_multi_3.txt");
+	free(copyBuf);
+	free(buf);
+	JFMDeleteFile(fm, 0);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, ConcatFiles, {
+	char *filePaths[3];
+	filePaths[0] = "./fm_test_concat_1.txt";
+	filePaths[1] = "./fm_test_concat_2.txt";
+	filePaths[2] = "./fm_test_concat_3.txt";
+	char *concatPath = "./fm_test_concat.txt";
+	char lineData[64];
+	int indices[4];
+	int lineNum = 3000;
+	int lineIndex = 0;
+
+	// 마지막 라인이 개행 문자로 끝나지 않는 파일을 중간에 넣는다.
+	FILE *fp = fopen(filePaths[0], "w");
+	EXPECT_NOT_NULL(fp);
+	for( ; lineIndex < lineNum; lineIndex++) fprintf(fp, "first %d\n", lineIndex);
+	fclose(fp);
+	fp = fopen(filePaths[1], "w");
+	EXPECT_NOT_NULL(fp);
+	fputs("open", fp);
+	fclose(fp);
+	fp = fopen(filePaths[2], "w");
+	EXPECT_NOT_NULL(fp);
+	for(lineIndex = 0; lineIndex < lineNum; lineIndex++) fprintf(fp, "third %d\n", lineIndex);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePaths[0]));
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePaths[1]));
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePaths[2]));
+	indices[0] = 0;
+	indices[1] = 1;
+	indices[2] = 2;
+	indices[3] = 1;
+	EXPECT_NOT_NULL(JFMConcatFiles(fm, indices, 4, concatPath));
+	EXPECT_NUM_EQUAL(fm->size, 5, int);
+
+	// 입력 파일 값으로 계산한 라인 수와 문자 개수가 새로 센 값과 같아야 한다.
+	JFMPtr checkFm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(checkFm, concatPath));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 3)->line, JFMGetFile(checkFm, 0)->line, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 3)->line, (long long)lineNum * 2 + 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 3)->totalCharCount, JFMGetFile(checkFm, 0)->totalCharCount, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 3), JFMGetFileSize(fm, 0) + JFMGetFileSize(fm, 1) * 2 + JFMGetFileSize(fm, 2), longlong);
+	JFMDelete(&checkFm);
+
+	// 옮긴 라인 위치 색인으로 라인을 읽는다.
+	char *line = JFMReadLine(fm, 3, 2500);
+	EXPECT_STR_EQUAL(line, "first 2500\n");
+	free(line);
+	line = JFMReadLine(fm, 3, lineNum);
+	EXPECT_STR_EQUAL(line, "openthird 0\n");
+	free(line);
+	line = JFMReadLine(fm, 3, lineNum + 2100);
+	sprintf(lineData, "third %d\n", 2100);
+	EXPECT_STR_EQUAL(line, lineData);
+	free(line);
+	line = JFMReadLine(fm, 3, lineNum * 2);
+	EXPECT_STR_EQUAL(line, "open");
+	free(line);
+
+	// 입력 파일이나 이미 관리 중인 파일에는 쓸 수 없다.
+	EXPECT_NULL(JFMConcatFiles(fm, indices, 2, filePaths[2]));
+	EXPECT_NULL(JFMConcatFiles(fm, indices, 2, concatPath));
+	indices[1] = 10;
+	EXPECT_NULL(JFMConcatFiles(fm, indices, 2, "./fm_test_concat_x.txt"));
+
+	int fileIndex = 0;
+	for( ; fileIndex < 3; fileIndex++) unlink(filePaths[fileIndex]);
+	unlink(concatPath);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, SplitFile, {
+	char *filePath = "./fm_test_split.txt";
+	char piecePath[64];
+	char lineData[128];
+	int lineNum = 5000;
+	int lineIndex = 0;
+
+	// 라인 길이가 서로 다르고 마지막 라인이 개행 문자로 끝나지 않는 파일
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	for( ; lineIndex < lineNum; lineIndex++) fprintf(fp, "line %d %.*s\n", lineIndex, lineIndex % 50, "--------------------------------------------------");
+	fputs("last", fp);
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NOT_NULL(JFMSplitFile(fm, 0, JFMSplitByLine, 3, "./fm_test_split_line_%d.txt"));
+	EXPECT_NUM_EQUAL(fm->size, 5, int);
+
+	// 라인 수 기준이면 조각의 라인 수가 같고, 원본 값으로 계산한 값이 새로 센 값과 같아야 한다.
+	long long totalLine = 0;
+	long long totalSize = 0;
+	int pieceIndex = 0;
+	for( ; pieceIndex < 3; pieceIndex++)
+	{
+		JFMPtr checkFm = JFMNew();
+		sprintf(piecePath, "./fm_test_split_line_%d.txt", pieceIndex);
+		EXPECT_NOT_NULL(JFMNewFile(checkFm, piecePath));
+		EXPECT_NUM_EQUAL(JFMGetFile(fm, pieceIndex + 1)->line, JFMGetFile(checkFm, 0)->line, longlong);
+		EXPECT_NUM_EQUAL(JFMGetFile(fm, pieceIndex + 1)->totalCharCount, JFMGetFile(checkFm, 0)->totalCharCount, longlong);
+		totalLine += JFMGetFile(fm, pieceIndex + 1)->line;
+		totalSize += JFMGetFileSize(fm, pieceIndex + 1);
+		JFMDelete(&checkFm);
+	}
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->line, (long long)(lineNum + 1) / 3, longlong);
+	EXPECT_NUM_EQUAL(totalLine, (long long)lineNum + 1, longlong);
+	EXPECT_NUM_EQUAL(totalSize, JFMGetFileSize(fm, 0), longlong);
+
+	// 옮긴 라인 위치 색인으로 조각의 라인을 읽는다.
+	long long firstLine = JFMGetFile(fm, 1)->line;
+	char *line = JFMReadLine(fm, 2, 1500);
+	snprintf(lineData, sizeof(lineData), "line %lld %.*s\n", firstLine + 1500, (int)((firstLine + 1500) % 50), "--------------------------------------------------");
+	EXPECT_STR_EQUAL(line, lineData);
+	free(line);
+	line = JFMReadLine(fm, 3, JFMGetFile(fm, 3)->line - 1);
+	EXPECT_STR_EQUAL(line, "last");
+	free(line);
+
+	// 크기 기준이면 조각은 라인 경계에서 잘리고 크기가 비슷하다.
+	EXPECT_NOT_NULL(JFMSplitFile(fm, 0, JFMSplitBySize, 4, "./fm_test_split_size_%02d.txt"));
+	EXPECT_NUM_EQUAL(fm->size, 9, int);
+	totalLine = 0;
+	for(pieceIndex = 0; pieceIndex < 4; pieceIndex++)
+	{
+		JFMPtr checkFm = JFMNew();
+		sprintf(piecePath, "./fm_test_split_size_%02d.txt", pieceIndex);
+		EXPECT_NOT_NULL(JFMNewFile(checkFm, piecePath));
+		EXPECT_NUM_EQUAL(JFMGetFile(fm, pieceIndex + 4)->line, JFMGetFile(checkFm, 0)->line, longlong);
+		EXPECT_NUM_EQUAL(JFMGetFile(fm, pieceIndex + 4)->totalCharCount, JFMGetFile(checkFm, 0)->totalCharCount, longlong);
+		EXPECT_NUM_LESS_THAN(llabs(JFMGetFileSize(fm, pieceIndex + 4) - JFMGetFileSize(fm, 0) / 4), 64LL, longlong);
+		totalLine += JFMGetFile(fm, pieceIndex + 4)->line;
+		JFMDelete(&checkFm);
+	}
+	EXPECT_NUM_EQUAL(totalLine, (long long)lineNum + 1, longlong);
+	line = JFMReadLine(fm, 5, 0);
+	EXPECT_NUM_EQUAL(strncmp(line, "line ", 5), 0, int);
+	free(line);
+
+	// 형식 문자열은 %d 변환 하나만 가져야 하고, 이미 관리 중인 경로에는 쓸 수 없다.
+	EXPECT_NULL(JFMSplitFile(fm, 0, JFMSplitByLine, 2, "./fm_test_split_%s.txt"));
+	EXPECT_NULL(JFMSplitFile(fm, 0, JFMSplitByLine, 2, "./fm_test_split.txt"));
+	EXPECT_NULL(JFMSplitFile(fm, 0, JFMSplitByLine, 3, "./fm_test_split_line_%d.txt"));
+
+	// 조각이 라인보다 많으면 빈 조각이 생기고, 개행 문자로 끝나지 않는 라인은 그 내용을 가진 조각의 라인이다.
+	JFMPtr shortFm = JFMNew();
+	fp = fopen("./fm_test_split_short.txt", "w");
+	EXPECT_NOT_NULL(fp);
+	fputs("ab\ncdefgh", fp);
+	fclose(fp);
+	EXPECT_NOT_NULL(JFMNewFile(shortFm, "./fm_test_split_short.txt"));
+	EXPECT_NOT_NULL(JFMSplitFile(shortFm, 0, JFMSplitBySize, 7, "./fm_test_split_short_%d.txt"));
+	totalLine = 0;
+	for(pieceIndex = 0; pieceIndex < 7; pieceIndex++)
+	{
+		long long pieceSize = JFMGetFileSize(shortFm, pieceIndex + 1);
+		EXPECT_NUM_EQUAL(JFMGetFile(shortFm, pieceIndex + 1)->line, (pieceSize > 0) ? 1LL : 0LL, longlong);
+		totalLine += JFMGetFile(shortFm, pieceIndex + 1)->line;
+	}
+	EXPECT_NUM_EQUAL(totalLine, 2, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(shortFm, 4), 6, longlong);
+	line = JFMReadLine(shortFm, 4, 0);
+	EXPECT_STR_EQUAL(line, "cdefgh");
+	free(line);
+	for(pieceIndex = 7; pieceIndex >= 0; pieceIndex--)
+	{
+		JFMDeleteFile(shortFm, pieceIndex);
+	}
+	JFMDelete(&shortFm);
+
+	unlink(filePath);
+	for(pieceIndex = 0; pieceIndex < 4; pieceIndex++)
+	{
+		sprintf(piecePath, "./fm_test_split_line_%d.txt", pieceIndex);
+		unlink(piecePath);
+		sprintf(piecePath, "./fm_test_split_size_%02d.txt", pieceIndex);
+		unlink(piecePath);
+	}
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, SortFile, {
+	char *filePath = "./fm_test_sort.txt";
+	char *sortPath = "./fm_test_sort_text.txt";
+	char *numericPath = "./fm_test_sort_numeric.txt";
+	char prevLine[64];
+	char lineData[64];
+	int lineNum = 30000;
+	int lineIndex = 0;
+
+	// 값마다 3 번씩 나오고 마지막 라인이 개행 문자로 끝나지 않는 파일
+	FILE *fp = fopen(filePath, "w");
+	EXPECT_NOT_NULL(fp);
+	for( ; lineIndex < lineNum - 1; lineIndex++) fprintf(fp, "%d value\n", (lineIndex * 7919) % 10000);
+	fprintf(fp, "%d value", ((lineNum - 1) * 7919) % 10000);
+	fclose(fp);
+
+	// 메모리를 아주 작게 주면 여러 런으로 나눠서 정렬한 후 병합한다.
+	JFMSortOption option;
+	option.flags = 0;
+	option.memoryLimit = 1;
+	option.threadNum = 0;
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath));
+	EXPECT_NOT_NULL(JFMSortFile(fm, 0, sortPath, &option));
+	EXPECT_NUM_EQUAL(fm->size, 3, int);
+
+	// 바이트 순서로 정렬되고, 마지막 라인에도 개행 문자가 붙는다.
+	fp = fopen(sortPath, "r");
+	EXPECT_NOT_NULL(fp);
+	int readNum = 0;
+	prevLine[0] = '\0';
+	while(fgets(lineData, sizeof(lineData), fp) != NULL)
+	{
+		EXPECT_NUM_EQUAL((strcmp(prevLine, lineData) <= 0) ? 1 : 0, 1, int);
+		strcpy(prevLine, lineData);
+		readNum++;
+	}
+	fclose(fp);
+	EXPECT_NUM_EQUAL(readNum, lineNum, int);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->line, (long long)lineNum, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFileSize(fm, 1), JFMGetFileSize(fm, 0) + 1, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 1)->totalCharCount, JFMGetFile(fm, 0)->totalCharCount, longlong);
+
+	// 숫자 기준으로 정렬하면서 중복을 지운다. 쓰면서 만든 라인 위치 색인으로 라인을 읽는다.
+	option.flags = JFMSortNumeric | JFMSortUnique;
+	EXPECT_NOT_NULL(JFMSortFile(fm, 0, numericPath, &option));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 2)->line, 10000LL, longlong);
+	char *line = JFMReadLine(fm, 2, 0);
+	EXPECT_STR_EQUAL(line, "0 value\n");
+	free(line);
+	line = JFMReadLine(fm, 2, 5000);
+	EXPECT_STR_EQUAL(line, "5000 value\n");
+	free(line);
+	line = JFMReadLine(fm, 2, 9999);
+	EXPECT_STR_EQUAL(line, "9999 value\n");
+	free(line);
+
+	// 새로 센 값과 같아야 한다.
+	JFMPtr checkFm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(checkFm, numericPath));
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 2)->line, JFMGetFile(checkFm, 0)->line, longlong);
+	EXPECT_NUM_EQUAL(JFMGetFile(fm, 2)->totalCharCount, JFMGetFile(checkFm, 0)->totalCharCount, longlong);
+	JFMDelete(&checkFm);
+
+	// 숫자로 시작하지 않는 라인(nan, inf, 16 진수 포함)은 0 으로 보고 라인 내용 순서로 정렬한다.
+	char *specialPath = "./fm_test_sort_special.txt";
+	char *specialSortPath = "./fm_test_sort_special_numeric.txt";
+	char specialData[128];
+	fp = fopen(specialPath, "w");
+	EXPECT_NOT_NULL(fp);
+	for(lineIndex = 0; lineIndex < 3000; lineIndex++)
+	{
+		fputs("nancy\nnan\ninf 1\n0x10\n3 z\n-2 a\n 1.5 b\n.5 c\nzebra\n", fp);
+	}
+	fclose(fp);
+	JFMPtr specialFm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(specialFm, specialPath));
+	EXPECT_NOT_NULL(JFMSortFile(specialFm, 0, specialSortPath, &option));
+	EXPECT_NUM_EQUAL(JFMGetFile(specialFm, 1)->line, 9LL, longlong);
+	fp = fopen(specialSortPath, "r");
+	EXPECT_NOT_NULL(fp);
+	size_t specialLength = fread(specialData, 1, sizeof(specialData) - 1, fp);
+	specialData[specialLength] = '\0';
+	fclose(fp);
+	EXPECT_STR_EQUAL(specialData, "-2 a\n0x10\ninf 1\nnan\nnancy\nzebra\n.5 c\n 1.5 b\n3 z\n");
+	unlink(specialPath);
+	unlink(specialSortPath);
+	JFMDelete(&specialFm);
+
+	// 기본값으로 정렬하면 한 번에 정렬한다. 이미 관리 중인 경로에는 쓸 수 없다.
+	EXPECT_NOT_NULL(JFMSortFile(fm, 2, "./fm_test_sort_default.txt", NULL));
+	line = JFMReadLine(fm, 3, 1);
+	EXPECT_STR_EQUAL(line, "1 value\n");
+	free(line);
+	line = JFMReadLine(fm, 3, 2);
+	EXPECT_STR_EQUAL(line, "10 value\n");
+	free(line);
+	EXPECT_NULL(JFMSortFile(fm, 0, sortPath, NULL));
+	EXPECT_NULL(JFMSortFile(fm, 0, filePath, NULL));
+
+	unlink(filePath);
+	unlink(sortPath);
+	unlink(numericPath);
+	unlink("./fm_test_sort_default.txt");
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, IndexQuery, {
+	char *filePath1 = "./fm_test_index1.txt";
+	char *filePath2 = "./fm_test_index2.txt";
+	char *indexPath = "./fm_test_index.jfmidx";
+	int lineIndex = 0;
+	QueryState state;
+
+	// 블록 여러 개에 걸친 파일에 찾을 문자열을 드문드문 넣는다.
+	FILE *fp = fopen(filePath1, "w");
+	EXPECT_NOT_NULL(fp);
+	for( ; lineIndex < 5000; lineIndex++)
+	{
+		if((lineIndex == 1234) || (lineIndex == 4321)) fprintf(fp, "line %d needle\n", lineIndex);
+		else fprintf(fp, "line %d data\n", lineIndex);
+	}
+	fclose(fp);
+	fp = fopen(filePath2, "w");
+	EXPECT_NOT_NULL(fp);
+	for(lineIndex = 0; lineIndex < 2999; lineIndex++) fprintf(fp, "row %d\n", lineIndex);
+	fprintf(fp, "last needle");
+	fclose(fp);
+
+	JFMPtr fm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath1));
+	EXPECT_NOT_NULL(JFMNewFile(fm, filePath2));
+	JFMSetUserData(fm, &state);
+
+	// 색인 없이 파일 전체를 읽어서 찾는다.
+	memset(&state, 0, sizeof(state));
+	EXPECT_NUM_EQUAL(JFMQuery(fm, -1, "needle", QueryCallback), 3LL, longlong);
+	EXPECT_NUM_EQUAL(state.matchNum, 3, int);
+	EXPECT_NUM_EQUAL(state.indexList[0], 0, int);
+	EXPECT_NUM_EQUAL(state.lineNumberList[0], 1234LL, longlong);
+	EXPECT_STR_EQUAL(state.lineList[0], "line 1234 needle\n");
+	EXPECT_NUM_EQUAL(state.lineNumberList[1], 4321LL, longlong);
+	EXPECT_NUM_EQUAL(state.indexList[2], 1, int);
+	EXPECT_NUM_EQUAL(state.lineNumberList[2], 2999LL, longlong);
+	EXPECT_STR_EQUAL(state.lineList[2], "last needle");
+
+	// 색인을 사용해도 결과가 같다. 3 바이트보다 짧은 문자열은 전체를 읽는다.
+	EXPECT_NOT_NULL(JFMEnableIndex(fm));
+	memset(&state, 0, sizeof(state));
+	EXPECT_NUM_EQUAL(JFMQuery(fm, -1, "needle", QueryCallback), 3LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[0], 1234LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[1], 4321LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[2], 2999LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "4321 ", NULL), 1LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 1, "row", NULL), 2999LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "e", NULL), 5000LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "absent", NULL), 0LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "", NULL), -1LL, longlong);
+
+	// 파일을 바꾸면 바뀐 위치부터 다시 색인한다.
+	long long size = JFMGetFileSize(fm, 0);
+	EXPECT_NOT_NULL(JFMWriteFile(fm, 0, "tail token zqxj\n", "a"));
+	memset(&state, 0, sizeof(state));
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "zqxj", QueryCallback), 1LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[0], 5000LL, longlong);
+	EXPECT_NOT_NULL(JFMTruncateFile(fm, 0, (off_t)size));
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "zqxj", NULL), 0LL, longlong);
+	EXPECT_NUM_EQUAL(JFMQuery(fm, 0, "needle", NULL), 2LL, longlong);
+
+	// 저장한 색인을 다른 파일 관리 구조체에서 불러와서 사용한다.
+	EXPECT_NOT_NULL(JFMSaveIndex(fm, indexPath));
+	JFMPtr loadFm = JFMNew();
+	EXPECT_NOT_NULL(JFMNewFile(loadFm, filePath1));
+	EXPECT_NOT_NULL(JFMNewFile(loadFm, filePath2));
+	JFMSetUserData(loadFm, &state);
+	EXPECT_NOT_NULL(JFMLoadIndex(loadFm, indexPath));
+	memset(&state, 0, sizeof(state));
+	EXPECT_NUM_EQUAL(JFMQuery(loadFm, -1, "needle", QueryCallback), 3LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[1], 4321LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[2], 2999LL, longlong);
+
+	// 다른 곳에서 바꾼 파일은 다시 색인한다.
+	fp = fopen(filePath2, "a");
+	EXPECT_NOT_NULL(fp);
+	fprintf(fp, "\nanother needle\n");
+	fclose(fp);
+	memset(&state, 0, sizeof(state));
+	EXPECT_NUM_EQUAL(JFMQuery(loadFm, 1, "needle", QueryCallback), 2LL, longlong);
+	EXPECT_NUM_EQUAL(state.lineNumberList[1], 3000LL, longlong);
+	EXPECT_NOT_NULL(JFMDisableIndex(loadFm));
+	EXPECT_NUM_EQUAL(JFMQuery(loadFm, -1, "needle", NULL), 4LL, longlong);
+
+	unlink(filePath1);
+	unlink(filePath2);
+	unlink(indexPath);
+	JFMDelete(&loadFm);
+	JFMDelete(&fm);
+})
+
+TEST(FileManager, FindByPrefixAndGlob, {
+	char *pathList[5];
+	int fileIndex = 0;
+
+	mkdir("./fm_test_tree", 0777);
+	mkdir("./fm_test_tree/a", 0777);
+	mkdir("./fm_test_tree/a/x", 0777);
+	mkdir("./fm_test_tree/b", 0777);
+	pathList[0] = "./fm_test_tree/a/1.log";
+	pathList[1] = "./fm_test_tree/a/2.txt";
+	pathList[2] = "./fm_test_tree/a/x/3.log";
+	pathList[3] = "./fm_test_tree/b/4.log";
+	pathList[4] = "./fm_test_tree/ab.log";
+
+	JFMPtr fm = JFMNew();
+	for( ; fileIndex < 5; fileIndex++)
+	{
+		FILE *fp = fopen(pathList[fileIndex], "w");
+		EXPECT_NOT_NULL(fp);
+		fprintf(fp, "%d\n", fileIndex);
+		fclose(fp);
+		EXPECT_NOT_NULL(JFMNewFile(fm, pathList[fileIndex]));
+	}
+
+	// 디렉터리 아래 파일을 경로 순서로 찾는다. '/' 로 끝내지 않으면 문자열 접두사로 찾는다.
+	JFMPathIterPtr iter = JFMFindByPrefix(fm, "./fm_test_tree/a/");
+	EXPECT_NOT_NULL(iter);
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 3LL, longlong);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), 0, int);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), 1, int);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), 2, int);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), -1, int);
+	JFMPathIterClose(&iter);
+	EXPECT_NULL(iter);
+	iter = JFMFindByPrefix(fm, "./fm_test_tree/a");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 4LL, longlong);
+	JFMPathIterClose(&iter);
+	iter = JFMFindByPrefix(fm, "./fm_test_tree/c/");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 0LL, longlong);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), -1, int);
+	JFMPathIterClose(&iter);
+
+	// '*', '?' 는 디렉터리를 넘지 않고, '**' 는 하위 디렉터리까지 찾는다.
+	iter = JFMFindByGlob(fm, "./fm_test_tree/*/*.log");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 2LL, longlong);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), 0, int);
+	EXPECT_NUM_EQUAL(JFMPathIterNext(iter), 3, int);
+	JFMPathIterClose(&iter);
+	iter = JFMFindByGlob(fm, "./fm_test_tree/**.log");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 4LL, longlong);
+	JFMPathIterClose(&iter);
+	iter = JFMFindByGlob(fm, "./fm_test_tree/**/?.log");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 3LL, longlong);
+	JFMPathIterClose(&iter);
+	iter = JFMFindByGlob(fm, "./fm_test_tree/a/2.txt");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 1LL, longlong);
+	JFMPathIterClose(&iter);
+
+	// 이동하면 경로 색인도 바뀐다.
+	EXPECT_NOT_NULL(JFMMoveFile(fm, 1, "./fm_test_tree/b/2.txt"));
+	EXPECT_NULL(JFMFindFileByPath(fm, "./fm_test_tree/a/2.txt"));
+	EXPECT_PTR_EQUAL(JFMFindFileByPath(fm, "./fm_test_tree/b/2.txt"), JFMGetFile(fm, 1));
+	iter = JFMFindByPrefix(fm, "./fm_test_tree/b/");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 2LL, longlong);
+	JFMPathIterClose(&iter);
+
+	// 디렉터리 아래 파일을 모두 옮기고(없는 디렉터리는 만듦), 모두 삭제한다.
+	EXPECT_NUM_EQUAL(JFMMoveByPrefix(fm, "./fm_test_tree/b/", "./fm_test_tree/c/d/"), 2LL, longlong);
+	EXPECT_NUM_EQUAL(access("./fm_test_tree/c/d/4.log", F_OK), 0, int);
+	EXPECT_NUM_EQUAL(access("./fm_test_tree/b/4.log", F_OK), -1, int);
+	EXPECT_STR_EQUAL(JFMGetFilePath(fm, 3), "./fm_test_tree/c/d/4.log");
+	iter = JFMFindByPrefix(fm, "./fm_test_tree/b/");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 0LL, longlong);
+	JFMPathIterClose(&iter);
+
+	EXPECT_NUM_EQUAL(JFMDeleteByPrefix(fm, "./fm_test_tree/a/"), 2LL, longlong);
+	EXPECT_NUM_EQUAL(access("./fm_test_tree/a/x/3.log", F_OK), -1, int);
+	EXPECT_PTR_EQUAL(JFMFindFileByPath(fm, "./fm_test_tree/ab.log"), JFMGetFile(fm, 4));
+	iter = JFMFindByPrefix(fm, "./fm_test_tree/");
+	EXPECT_NUM_EQUAL(JFMPathIterGetCount(iter), 3LL, longlong);
+	JFMPathIterClose(&iter);
+	EXPECT_NUM_EQUAL(JFMDeleteByPrefix(fm, ""), -1LL, longlong);
+	EXPECT_NUM_EQUAL(JFMDeleteByPrefix(fm, "./fm_test_tree/"), 3LL, longlong);
+	EXPECT_NUM_EQUAL(fm->size, 1, int);
+
+	rmdir("./fm_test_tree/c/d");
+	rmdir("./fm_test_tree/c");
+	rmdir("./fm_test_tree/b");
+	rmdir("./fm_test_tree/a/x");
+	rmdir("./fm_test_tree/a");
+	rmdir("./fm_test_tree");
+	JFMDelete(&fm);
+})
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Main Function
 ////////////////////////////////////////////////////////////////////////////////
@@ -337,7 +2027,32 @@ int main()
 		Test_FileManager_TruncateFile,
 		Test_FileManager_RenameFilePath,
 		Test_FileManager_ChangeMode,
-		Test_FileManager_FindFileByPath
+		Test_FileManager_FindFileByPath,
+		Test_FileManager_Dedupe,
+		Test_FileManager_CopyFileDelta,
+		Test_FileManager_ResizeFile,
+		Test_FileManager_CompressFile,
+		Test_FileManager_PackFile,
+		Test_FileManager_SaveAndLoadManifest,
+		Test_FileManager_CountLargeFile,
+		Test_FileManager_FollowFile,
+		Test_FileManager_ReadTail,
+		Test_FileManager_ReadRangeAndInto,
+		Test_FileManager_WriteFileVAndPWrite,
+		Test_FileManager_ReplaceFile,
+		Test_FileManager_EditLines,
+		Test_FileManager_WriteBack,
+		Test_FileManager_AccessPolicy,
+		Test_FileManager_CopyFileDirect,
+		Test_FileManager_CopyFiles,
+		Test_FileManager_CopyLargeFile,
+		Test_FileManager_CopyFileResume,
+		Test_FileManager_CopyFileMulti,
+		Test_FileManager_ConcatFiles,
+		Test_FileManager_SplitFile,
+		Test_FileManager_SortFile,
+		Test_FileManager_IndexQuery,
+		Test_FileManager_FindByPrefixAndGlob
     );
 
     RUN_ALL_TESTS();